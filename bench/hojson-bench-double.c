@@ -0,0 +1,89 @@
+#include <stdio.h> /* printf(), snprintf() */
+#include <stdlib.h> /* EXIT_FAILURE, EXIT_SUCCESS, atoi(), strtod() */
+#include <time.h> /* clock(), clock_t, CLOCKS_PER_SEC */
+
+#ifndef HOJSON_NO_IMPLEMENTATION /* Defined by the CMake build, which links the compiled implementation instead */
+    #define HOJSON_IMPLEMENTATION
+#endif /* HOJSON_NO_IMPLEMENTATION */
+#include "hojson.h"
+
+#define NUM_VALUES 1000000
+
+/* Small, deterministic generator so every run formats the same values */
+static uint64_t bench_random_state = 0x9E3779B97F4A7C15u;
+static uint64_t bench_random(void) {
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 7;
+    bench_random_state ^= bench_random_state << 17;
+    return bench_random_state;
+}
+
+/* Formats with the fewest of 15, 16, or 17 significant digits that read back as the same value */
+static size_t bench_snprintf_shortest(double value, char* str) {
+    int precision, length = 0;
+    for (precision = 15; precision <= 17; precision++) {
+        length = snprintf(str, HOJSON_FORMAT_DOUBLE_LENGTH, "%.*g", precision, value);
+        if (strtod(str, NULL) == value)
+            break;
+    }
+    return (size_t)length;
+}
+
+static size_t bench_snprintf_17(double value, char* str) {
+    return (size_t)snprintf(str, HOJSON_FORMAT_DOUBLE_LENGTH, "%.17g", value);
+}
+
+static void bench_run(const char* label, size_t (*format)(double, char*), const double* values, int num_values,
+        int iterations) {
+    char str[HOJSON_FORMAT_DOUBLE_LENGTH];
+    size_t bytes = 0;
+    int iteration, i;
+    clock_t start = clock();
+    for (iteration = 0; iteration < iterations; iteration++)
+        for (i = 0; i < num_values; i++)
+            bytes += format(values[i], str);
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double count = (double)num_values * iterations;
+    printf(" %-24s %8.1f ns/value %8.1f MB/s %6.2f bytes/value\n", label, seconds * 1e9 / count,
+        bytes / seconds / 1e6, bytes / count);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 3;
+    static double random_bits[NUM_VALUES], decimals[NUM_VALUES], integers[NUM_VALUES];
+    char str[HOJSON_FORMAT_DOUBLE_LENGTH];
+    int i;
+
+    for (i = 0; i < NUM_VALUES; i++) {
+        /* Any finite double, decimals like those found in typical JSON, and integral values */
+        uint64_t bits = bench_random();
+        if (((bits >> 52) & 0x7FF) == 0x7FF)
+            bits ^= ((uint64_t)1) << 62;
+        memcpy(&random_bits[i], &bits, sizeof(double));
+        decimals[i] = (double)(int64_t)(bench_random() % 2000000000) / 10000.0 - 100000.0;
+        integers[i] = (double)(bench_random() % 100000000);
+    }
+
+    /* Make sure every value reads back exactly before measuring anything */
+    for (i = 0; i < NUM_VALUES; i++) {
+        hojson_format_double(random_bits[i], str);
+        if (strtod(str, NULL) != random_bits[i]) {
+            fprintf(stderr, "Formatted %s does not read back as %.17g\n", str, random_bits[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("\n --------- Random bit patterns\n");
+    bench_run("hojson_format_double", hojson_format_double, random_bits, NUM_VALUES, iterations);
+    bench_run("snprintf shortest", bench_snprintf_shortest, random_bits, NUM_VALUES, iterations);
+    bench_run("snprintf %.17g", bench_snprintf_17, random_bits, NUM_VALUES, iterations);
+    printf("\n --------- Decimals with four places\n");
+    bench_run("hojson_format_double", hojson_format_double, decimals, NUM_VALUES, iterations);
+    bench_run("snprintf shortest", bench_snprintf_shortest, decimals, NUM_VALUES, iterations);
+    bench_run("snprintf %.17g", bench_snprintf_17, decimals, NUM_VALUES, iterations);
+    printf("\n --------- Integral values\n");
+    bench_run("hojson_format_double", hojson_format_double, integers, NUM_VALUES, iterations);
+    bench_run("snprintf shortest", bench_snprintf_shortest, integers, NUM_VALUES, iterations);
+    bench_run("snprintf %.17g", bench_snprintf_17, integers, NUM_VALUES, iterations);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#include <stdio.h> /* fprintf(), printf(), snprintf() */
+#include <stdlib.h> /* EXIT_FAILURE, EXIT_SUCCESS, atoi(), free(), malloc(), realloc() */
+#include <time.h> /* clock(), clock_t, CLOCKS_PER_SEC */
+
+#ifndef HOJSON_NO_IMPLEMENTATION /* Defined by the CMake build, which links the compiled implementation instead */
+    #define HOJSON_IMPLEMENTATION
+#endif /* HOJSON_NO_IMPLEMENTATION */
+#include "hojson.h"
+
+#include "hojson-corpora.h"
+
+/* Parses content in parts of the given length, or whole if zero, and returns the number of codes */
+static size_t bench_parse(const bench_text_t* content, size_t part_length, uint8_t is_multi_document, char** buffer,
+        size_t* buffer_length) {
+    hojson_context_t context[1] = { { NULL } }; /* Zeroed up front so the compiler needn't prove hojson_init() does */
+    hojson_init(context, *buffer, *buffer_length);
+    hojson_set_multi_document(context, is_multi_document);
+    size_t offset = 0, codes = 0;
+    size_t length = part_length == 0 || part_length > content->length ? content->length : part_length;
+    while (1) {
+        hojson_code_t code = hojson_parse(context, content->data + offset, length);
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF) {
+            offset += length;
+            if (offset >= content->length)
+                break;
+            length = content->length - offset < length ? content->length - offset : length;
+        } else if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) { /* Double the buffer, which is kept for later runs */
+            char* larger = (char*)malloc(*buffer_length * 2);
+            if (larger == NULL) {
+                fprintf(stderr, "Couldn't allocate %lu bytes for the parser\n", (unsigned long)*buffer_length * 2);
+                exit(EXIT_FAILURE);
+            }
+            hojson_realloc(context, larger, *buffer_length * 2);
+            free(*buffer);
+            *buffer = larger;
+            *buffer_length *= 2;
+        } else if (code < HOJSON_NO_OP) {
+            fprintf(stderr, "Parsing failed with %d on line %u, column %u\n", code, context->line, context->column);
+            exit(EXIT_FAILURE);
+        } else {
+            codes++;
+            if (code == HOJSON_END_OF_DOCUMENT && !is_multi_document)
+                break;
+        }
+    }
+    return codes;
+}
+
+static void bench_run(const char* label, const bench_text_t* content, uint8_t is_multi_document, int iterations) {
+    static const size_t part_lengths[] = { 0, 65536, 4096, 64 };
+    static char* buffer = NULL;
+    static size_t buffer_length = 0;
+    size_t i;
+    if (buffer == NULL && (buffer = (char*)malloc(buffer_length = 4096)) == NULL)
+        exit(EXIT_FAILURE);
+
+    for (i = 0; i < sizeof(part_lengths) / sizeof(part_lengths[0]); i++) {
+        /* The first run grows the buffer and warms the caches. The fastest of the rest is reported. */
+        size_t codes = bench_parse(content, part_lengths[i], is_multi_document, &buffer, &buffer_length);
+        double best = -1.0;
+        int iteration;
+        for (iteration = 0; iteration < iterations; iteration++) {
+            clock_t start = clock();
+            bench_parse(content, part_lengths[i], is_multi_document, &buffer, &buffer_length);
+            double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+            if (best < 0.0 || seconds < best)
+                best = seconds;
+        }
+        if (best <= 0.0)
+            best = 1.0 / CLOCKS_PER_SEC; /* Too quick to measure */
+
+        char part[32];
+        if (part_lengths[i] == 0)
+            snprintf(part, sizeof(part), "whole");
+        else
+            snprintf(part, sizeof(part), "%lu B parts", (unsigned long)part_lengths[i]);
+        printf(" %-17s %-13s %9.1f MB/s %9.2f Mcodes/s %7.1f ns/code\n", label, part,
+            content->length / best / 1e6, codes / best / 1e6, best * 1e9 / codes);
+    }
+}
+
+/* Parses content in parts of every power of four from 1 byte to 1 MiB. Each is compared to parsing the content whole, */
+/* with the two runs taking turns so that both see the same conditions. */
+static void bench_sweep(const char* label, const bench_text_t* content, int iterations) {
+    static char* buffer = NULL;
+    static size_t buffer_length = 0;
+    size_t part_length;
+    if (buffer == NULL && (buffer = (char*)malloc(buffer_length = 4096)) == NULL)
+        exit(EXIT_FAILURE);
+
+    bench_parse(content, 0, 0, &buffer, &buffer_length);
+    for (part_length = 1; part_length <= BENCH_MEBIBYTE; part_length *= 4) {
+        double best = -1.0, best_whole = -1.0;
+        int iteration;
+        for (iteration = 0; iteration < iterations; iteration++) {
+            clock_t start = clock();
+            bench_parse(content, part_length, 0, &buffer, &buffer_length);
+            double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+            if (best < 0.0 || seconds < best)
+                best = seconds;
+            start = clock();
+            bench_parse(content, 0, 0, &buffer, &buffer_length);
+            seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+            if (best_whole < 0.0 || seconds < best_whole)
+                best_whole = seconds;
+        }
+        if (best <= 0.0)
+            best = 1.0 / CLOCKS_PER_SEC;
+
+        char part[32];
+        snprintf(part, sizeof(part), "%lu B parts", (unsigned long)part_length);
+        printf(" %-17s %-15s %9.1f MB/s %6.1f%% of whole\n", label, part, content->length / best / 1e6,
+            best_whole / best * 100.0);
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 3;
+    size_t length = (size_t)(argc > 2 ? atoi(argv[2]) : 4) * BENCH_MEBIBYTE;
+    if (iterations < 1 || length == 0) {
+        fprintf(stderr, "Usage: %s [iterations] [corpus size in MiB]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench_text_t twitter = { NULL, 0, 0 }, canada = { NULL, 0, 0 }, citm = { NULL, 0, 0 }, deep = { NULL, 0, 0 },
+        long_strings = { NULL, 0, 0 }, ndjson = { NULL, 0, 0 }, utf16le = { NULL, 0, 0 }, utf16be = { NULL, 0, 0 };
+    bench_twitter(&twitter, length);
+    bench_canada(&canada, length);
+    bench_citm(&citm, length);
+    bench_deep(&deep, length);
+    bench_long_strings(&long_strings, length);
+    bench_ndjson(&ndjson, length);
+    bench_utf16(&utf16le, &twitter, 0);
+    bench_utf16(&utf16be, &twitter, 1);
+
+    printf("\n --------- Parsing %d times, each corpus about %lu MiB, the fastest run reported\n", iterations,
+        (unsigned long)(length / BENCH_MEBIBYTE));
+    bench_run("twitter", &twitter, 0, iterations);
+    bench_run("canada", &canada, 0, iterations);
+    bench_run("citm_catalog", &citm, 0, iterations);
+    bench_run("deep", &deep, 0, iterations);
+    bench_run("long strings", &long_strings, 0, iterations);
+    bench_run("ndjson", &ndjson, 1, iterations);
+#ifndef HOJSON_UTF8_ONLY /* A build for UTF-8 alone takes UTF-16 for a syntax error */
+    bench_run("twitter UTF-16LE", &utf16le, 0, iterations);
+    bench_run("twitter UTF-16BE", &utf16be, 0, iterations);
+#endif /* HOJSON_UTF8_ONLY */
+
+    printf("\n --------- Sweeping the length of the parts\n");
+    bench_sweep("twitter", &twitter, iterations);
+    bench_sweep("canada", &canada, iterations);
+
+    free(twitter.data);
+    free(canada.data);
+    free(citm.data);
+    free(deep.data);
+    free(long_strings.data);
+    free(ndjson.data);
+    free(utf16le.data);
+    free(utf16be.data);
+    return EXIT_SUCCESS;
+}
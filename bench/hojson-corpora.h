@@ -0,0 +1,240 @@
+#ifndef HOJSON_CORPORA_H
+#define HOJSON_CORPORA_H
+
+/*
+ * Generated corpora shared by the benchmark and the differential harness. Include after hojson.h, whose
+ * hojson_format_double() formats the doubles, along with stdio.h, stdlib.h, and string.h.
+ */
+
+#define BENCH_MEBIBYTE 1048576
+#define BENCH_DEPTH 256 /* Nesting of the deep corpus, within the reach of the default buffer's doublings */
+
+/* Small, deterministic generator so every run parses the same corpora */
+static uint64_t bench_random_state = 0x9E3779B97F4A7C15u;
+static uint64_t bench_random(void) {
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 7;
+    bench_random_state ^= bench_random_state << 17;
+    return bench_random_state;
+}
+
+/* A growing string the corpora are generated into */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} bench_text_t;
+
+static void bench_put(bench_text_t* text, const char* str, size_t length) {
+    if (text->length + length > text->capacity) {
+        while (text->length + length > text->capacity)
+            text->capacity = text->capacity > 0 ? text->capacity * 2 : 4096;
+        if ((text->data = (char*)realloc(text->data, text->capacity)) == NULL) {
+            fprintf(stderr, "Couldn't allocate %lu bytes for a corpus\n", (unsigned long)text->capacity);
+            exit(EXIT_FAILURE);
+        }
+    }
+    memcpy(text->data + text->length, str, length);
+    text->length += length;
+}
+
+static void bench_puts(bench_text_t* text, const char* str) {
+    bench_put(text, str, strlen(str));
+}
+
+static void bench_printf(bench_text_t* text, const char* format, long a, long b) {
+    char str[256];
+    bench_put(text, str, (size_t)snprintf(str, sizeof(str), format, a, b));
+}
+
+static void bench_put_double(bench_text_t* text, double value) {
+    char str[HOJSON_FORMAT_DOUBLE_LENGTH];
+    bench_put(text, str, hojson_format_double(value, str));
+}
+
+/* Words of a short text, some of them Japanese, accented, emoji, or escaped as they are in tweets */
+static const char* bench_words[] = { "the", "parser", "streams", "JSON", "@hojson", "#json", "http://t.co/x1Y2z3",
+    "\xE3\x81\x82\xE3\x82\x8A\xE3\x81\x8C\xE3\x81\xA8\xE3\x81\x86", "caf\xC3\xA9", "\xF0\x9F\x98\x80",
+    "\\u3042\\u3044", "\\\"quoted\\\"", "line\\nbreak", "RT", "\xE6\x97\xA5\xE6\x9C\xAC" };
+
+static void bench_put_words(bench_text_t* text, int count) {
+    int i;
+    for (i = 0; i < count; i++) {
+        if (i > 0)
+            bench_puts(text, " ");
+        bench_puts(text, bench_words[bench_random() % (sizeof(bench_words) / sizeof(bench_words[0]))]);
+    }
+}
+
+/* Shaped like twitter.json: objects of mixed types, nested a few levels, with plenty of non-ASCII text */
+static void bench_twitter(bench_text_t* text, size_t length) {
+    long id = 505874924;
+    bench_puts(text, "{\"statuses\": [");
+    while (text->length < length) {
+        if (id != 505874924)
+            bench_puts(text, ",");
+        bench_printf(text, "{\"created_at\": \"Sun Aug 31 00:%02ld:%02ld +0000 2014\", ", (long)(bench_random() % 60),
+            (long)(bench_random() % 60));
+        bench_printf(text, "\"id\": %ld, \"id_str\": \"%ld\", \"text\": \"", id, id);
+        bench_put_words(text, 4 + (int)(bench_random() % 16));
+        bench_puts(text, "\", \"source\": \"<a href=\\\"http://twitter.com\\\" rel=\\\"nofollow\\\">Twitter Web "
+            "Client</a>\", \"truncated\": false, \"in_reply_to_status_id\": null, \"user\": {");
+        bench_printf(text, "\"id\": %ld, \"name\": \"user%ld\", ", (long)(bench_random() % 2000000000),
+            (long)(bench_random() % 100000));
+        bench_printf(text, "\"followers_count\": %ld, \"friends_count\": %ld, ", (long)(bench_random() % 100000),
+            (long)(bench_random() % 1000));
+        bench_puts(text, "\"description\": \"");
+        bench_put_words(text, (int)(bench_random() % 10));
+        bench_puts(text, "\", \"verified\": false, \"profile_image_url\": \"http://pbs.twimg.com/profile_images/"
+            "1/normal.jpeg\"}, \"entities\": {\"hashtags\": [");
+        if (bench_random() % 2)
+            bench_printf(text, "{\"text\": \"json\", \"indices\": [%ld, %ld]}", 10, 15);
+        bench_printf(text, "], \"urls\": [], \"user_mentions\": []}, \"retweet_count\": %ld, \"favorite_count\": "
+            "%ld, \"favorited\": false, \"retweeted\": false, \"lang\": \"ja\"}", (long)(bench_random() % 1000),
+            (long)(bench_random() % 1000));
+        id += 1 + (long)(bench_random() % 1000);
+    }
+    bench_puts(text, "], \"search_metadata\": {\"completed_in\": 0.087, \"count\": 100, \"query\": \"%23json\"}}");
+}
+
+/* Shaped like canada.json: a polygon's coordinates, which is to say pairs of doubles with many digits */
+static void bench_canada(bench_text_t* text, size_t length) {
+    int point = 0;
+    bench_puts(text, "{\"type\": \"FeatureCollection\", \"features\": [{\"type\": \"Feature\", \"properties\": "
+        "{\"name\": \"Canada\"}, \"geometry\": {\"type\": \"Polygon\", \"coordinates\": [[");
+    while (text->length < length) {
+        if (point++ > 0)
+            bench_puts(text, point % 1000 == 1 ? "], [" : ",");
+        bench_puts(text, "[");
+        bench_put_double(text, -141.0 + (double)(bench_random() % 8600000000) / 1e8 + 1e-15);
+        bench_puts(text, ",");
+        bench_put_double(text, 41.6 + (double)(bench_random() % 4100000000) / 1e8 + 1e-14);
+        bench_puts(text, "]");
+    }
+    bench_puts(text, "]]}}]}");
+}
+
+/* Shaped like citm_catalog.json: objects with many members whose names are short or numeric */
+static void bench_citm(bench_text_t* text, size_t length) {
+    long id = 138586341;
+    bench_puts(text, "{\"areaNames\": {\"205705993\": \"Arri\xC3\xA8re-sc\xC3\xA8ne central\", \"205705994\": "
+        "\"1er balcon central\"}, \"events\": {");
+    while (text->length < length / 2) {
+        if (id != 138586341)
+            bench_puts(text, ", ");
+        bench_printf(text, "\"%ld\": {\"description\": null, \"id\": %ld, \"logo\": null, \"name\": \"", id, id);
+        bench_put_words(text, 2);
+        bench_printf(text, "\", \"subTopicIds\": [%ld, %ld], \"subjectCode\": null, \"subtitle\": null, ",
+            337184269, 337184283);
+        bench_printf(text, "\"topicIds\": [%ld, %ld]}", 324846099, 107888604 + (long)(bench_random() % 1000));
+        id += 1 + (long)(bench_random() % 100);
+    }
+    bench_puts(text, "}, \"performances\": [");
+    id = 339887544;
+    while (text->length < length) {
+        if (id != 339887544)
+            bench_puts(text, ", ");
+        bench_printf(text, "{\"eventId\": %ld, \"id\": %ld, \"logo\": null, \"name\": null, \"prices\": [",
+            138586341, id);
+        bench_printf(text, "{\"amount\": %ld, \"audienceSubCategoryId\": %ld, \"seatCategoryId\": 338937295}], ",
+            (long)(bench_random() % 100000), 337100890);
+        bench_printf(text, "\"seatCategories\": [{\"areas\": [{\"areaId\": %ld, \"blockIds\": []}], "
+            "\"seatCategoryId\": %ld}], ", 205705999, 338937295);
+        bench_printf(text, "\"seatMapImage\": null, \"start\": %ld, \"venueCode\": \"PLEYEL_PLEYEL\"}",
+            1372701600 + (long)(bench_random() % 100000), 0);
+        id += 1 + (long)(bench_random() % 100);
+    }
+    bench_puts(text, "]}");
+}
+
+/* Objects and arrays nested deeply, over and over, so pushing and popping the stack dominates */
+static void bench_deep(bench_text_t* text, size_t length) {
+    int i;
+    bench_puts(text, "[");
+    while (text->length < length) {
+        if (text->length > 1)
+            bench_puts(text, ",");
+        for (i = 0; i < BENCH_DEPTH; i++)
+            bench_puts(text, i % 2 ? "[" : "{\"a\":");
+        bench_puts(text, "1");
+        for (i = BENCH_DEPTH - 1; i >= 0; i--)
+            bench_puts(text, i % 2 ? "]" : "}");
+    }
+    bench_puts(text, "]");
+}
+
+/* Strings of up to 64 KiB, mostly ASCII with the odd escape or multi-byte character */
+static void bench_long_strings(bench_text_t* text, size_t length) {
+    bench_puts(text, "[");
+    while (text->length < length) {
+        size_t string_length = 1024 + (size_t)(bench_random() % (63 * 1024)), end;
+        if (text->length > 1)
+            bench_puts(text, ",\n");
+        bench_puts(text, "\"");
+        end = text->length + string_length;
+        while (text->length < end) {
+            uint64_t r = bench_random();
+            if (r % 64 == 0)
+                bench_puts(text, r % 128 == 0 ? "\\n" : "\\u00e9");
+            else if (r % 64 == 1)
+                bench_puts(text, "\xC3\xA9t\xC3\xA9");
+            else
+                bench_puts(text, "lorem ipsum dolor sit amet ");
+        }
+        bench_puts(text, "\"");
+    }
+    bench_puts(text, "]");
+}
+
+/* Newline-delimited JSON: a stream of small documents, one per line */
+static void bench_ndjson(bench_text_t* text, size_t length) {
+    long id = 0;
+    while (text->length < length) {
+        bench_printf(text, "{\"id\": %ld, \"score\": %ld.25, \"name\": \"", id++, (long)(bench_random() % 1000));
+        bench_put_words(text, 3);
+        bench_puts(text, "\", \"tags\": [\"a\", \"b\"], \"active\": ");
+        bench_puts(text, bench_random() % 2 ? "true, \"parent\": null}\n" : "false, \"parent\": null}\n");
+    }
+}
+
+/* Transcodes UTF-8 to UTF-16, little or big-endian, with a byte order marker */
+static void bench_utf16(bench_text_t* text, const bench_text_t* utf8, uint8_t is_big_endian) {
+    size_t i = 0;
+    char unit[4];
+    bench_put(text, is_big_endian ? "\xFE\xFF" : "\xFF\xFE", 2);
+    while (i < utf8->length) {
+        const unsigned char* c = (const unsigned char*)utf8->data + i;
+        uint32_t value;
+        size_t units, j;
+        if (c[0] < 0x80) {
+            value = c[0];
+            i += 1;
+        } else if (c[0] < 0xE0) {
+            value = ((uint32_t)(c[0] & 0x1F) << 6) | (c[1] & 0x3F);
+            i += 2;
+        } else if (c[0] < 0xF0) {
+            value = ((uint32_t)(c[0] & 0x0F) << 12) | ((uint32_t)(c[1] & 0x3F) << 6) | (c[2] & 0x3F);
+            i += 3;
+        } else {
+            value = ((uint32_t)(c[0] & 0x07) << 18) | ((uint32_t)(c[1] & 0x3F) << 12) |
+                ((uint32_t)(c[2] & 0x3F) << 6) | (c[3] & 0x3F);
+            i += 4;
+        }
+        uint16_t code_units[2];
+        if (value >= 0x10000) { /* A surrogate pair */
+            code_units[0] = (uint16_t)(0xD800 + ((value - 0x10000) >> 10));
+            code_units[1] = (uint16_t)(0xDC00 + ((value - 0x10000) & 0x3FF));
+            units = 2;
+        } else {
+            code_units[0] = (uint16_t)value;
+            units = 1;
+        }
+        for (j = 0; j < units; j++) {
+            unit[is_big_endian ? 0 : 1] = (char)(code_units[j] >> 8);
+            unit[is_big_endian ? 1 : 0] = (char)(code_units[j] & 0xFF);
+            bench_put(text, unit, 2);
+        }
+    }
+}
+
+#endif /* HOJSON_CORPORA_H */
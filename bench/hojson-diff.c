@@ -0,0 +1,316 @@
+#include <stdio.h> /* fprintf(), printf(), snprintf() */
+#include <stdlib.h> /* EXIT_FAILURE, EXIT_SUCCESS, atoi(), free(), malloc(), realloc(), strtod(), strtol() */
+#include <time.h> /* clock(), clock_t, CLOCKS_PER_SEC */
+
+#ifndef HOJSON_NO_IMPLEMENTATION /* Defined by the CMake build, which links the compiled implementation instead */
+    #define HOJSON_IMPLEMENTATION
+#endif /* HOJSON_NO_IMPLEMENTATION */
+#include "hojson.h"
+
+#include "hojson-corpora.h"
+#include "hojson-reference.h"
+
+/*
+ * Parses the benchmark's corpora with hojson and with a minimal reference parser, comparing every code along with its
+ * depth, name, and value, numbers included, and then reports the throughput of both side by side. UTF-16 corpora
+ * are compared, once hojson's strings are transcoded, with the reference parsing the UTF-8 they were made from.
+ */
+
+/* Transcodes a null-terminated string from hojson, in the document's encoding, to UTF-8 */
+static size_t diff_utf8(const char* str, uint8_t encoding, char** utf8, size_t* capacity) {
+    size_t length = 0, i;
+    if (encoding < HOJSON_ENCODING_UTF_16_LE) {
+        length = strlen(str);
+        if (!reference_reserve(utf8, capacity, length + 1))
+            exit(EXIT_FAILURE);
+        memcpy(*utf8, str, length + 1);
+        return length;
+    }
+    uint8_t high = encoding == HOJSON_ENCODING_UTF_16_BE ? 0 : 1; /* Index of each unit's more significant byte */
+    for (i = 0; str[i] != 0 || str[i + 1] != 0; i += 2) {
+        uint32_t unit = ((uint32_t)(uint8_t)str[i + high] << 8) | (uint8_t)str[i + !high];
+        if (unit >= 0xD800 && unit <= 0xDBFF && (str[i + 2] != 0 || str[i + 3] != 0)) { /* A surrogate pair */
+            uint32_t low = ((uint32_t)(uint8_t)str[i + 2 + high] << 8) | (uint8_t)str[i + 2 + !high];
+            unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            i += 2;
+        }
+        if (!reference_put_utf8(utf8, &length, capacity, unit))
+            exit(EXIT_FAILURE);
+    }
+    if (!reference_reserve(utf8, capacity, length + 1))
+        exit(EXIT_FAILURE);
+    (*utf8)[length] = '\0';
+    return length;
+}
+
+/* Says where two strings first differ, showing a little of each from there */
+static void diff_strings(const char* str, const char* expected, size_t expected_length) {
+    size_t i = 0;
+    while (i < expected_length && str[i] == expected[i])
+        i++;
+    printf("   string differs at byte %lu: \"%.24s\" where the reference has \"%.24s\"\n", (unsigned long)i, str + i,
+        expected + i);
+}
+
+/* Compares one code from each parser and, if they differ, says how */
+static int diff_code(hojson_code_t code, const hojson_context_t* context, hojson_code_t expected,
+        const reference_t* reference) {
+    static char* utf8 = NULL;
+    static size_t capacity = 0;
+    if (code != expected) {
+        printf("   returned %d where the reference returned %d\n", code, expected);
+        return 0;
+    }
+    if (context->depth != reference->depth) {
+        printf("   depth %u where the reference has %u\n", context->depth, reference->depth);
+        return 0;
+    }
+    if ((context->name == NULL) != (reference->name == NULL) || (context->name != NULL &&
+            (diff_utf8(context->name, context->encoding, &utf8, &capacity) != reference->name_length ||
+            memcmp(utf8, reference->name, reference->name_length) != 0))) {
+        printf("   name \"%s\" where the reference has \"%s\"\n", context->name != NULL ? utf8 : "(none)",
+            reference->name != NULL ? reference->name : "(none)");
+        return 0;
+    }
+    if (code != HOJSON_VALUE)
+        return 1;
+    if (context->value_type != reference->value_type) {
+        printf("   value type %d where the reference has %d\n", context->value_type, reference->value_type);
+        return 0;
+    }
+    switch (context->value_type) {
+    case HOJSON_TYPE_STRING:
+        if (diff_utf8(context->string_value, context->encoding, &utf8, &capacity) != reference->string_length ||
+                memcmp(utf8, reference->string_value, reference->string_length) != 0) {
+            diff_strings(utf8, reference->string_value, reference->string_length);
+            return 0;
+        } break;
+    case HOJSON_TYPE_INTEGER:
+        if (context->integer_value != reference->integer_value) {
+            printf("   integer %ld where the reference has %ld\n", context->integer_value, reference->integer_value);
+            return 0;
+        } break;
+    case HOJSON_TYPE_FLOAT:
+        if (context->float_value != reference->float_value) { /* Exactly, not approximately */
+            printf("   float %.17g where the reference has %.17g\n", context->float_value, reference->float_value);
+            return 0;
+        } break;
+    case HOJSON_TYPE_BOOLEAN:
+        if (context->bool_value != reference->bool_value) {
+            printf("   boolean %u where the reference has %u\n", context->bool_value, reference->bool_value);
+            return 0;
+        } break;
+    default: break;
+    }
+    return 1;
+}
+
+/* Parses content with hojson, in parts of the given length or whole if zero, and the reference in lockstep */
+static size_t diff_compare(const char* label, const bench_text_t* content, const bench_text_t* utf8,
+        uint8_t is_multi_document, size_t part_length, int* failures) {
+    static char* buffer = NULL;
+    static size_t buffer_length = 0;
+    if (buffer == NULL && (buffer = (char*)malloc(buffer_length = 4096)) == NULL)
+        exit(EXIT_FAILURE);
+    hojson_context_t context[1] = { { NULL } };
+    hojson_init(context, buffer, buffer_length);
+    hojson_set_multi_document(context, is_multi_document);
+    reference_t reference;
+    reference_init(&reference, utf8->data, utf8->length);
+
+    size_t offset = 0, codes = 0;
+    size_t length = part_length == 0 || part_length > content->length ? content->length : part_length;
+    hojson_code_t code;
+    for (;;) {
+        code = hojson_parse(context, content->data + offset, length);
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF && offset + length < content->length) {
+            offset += length;
+            length = content->length - offset < length ? content->length - offset : length;
+            continue;
+        } else if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+            char* larger = (char*)malloc(buffer_length * 2);
+            if (larger == NULL)
+                exit(EXIT_FAILURE);
+            hojson_realloc(context, larger, buffer_length * 2);
+            free(buffer);
+            buffer = larger;
+            buffer_length *= 2;
+            continue;
+        }
+
+        hojson_code_t expected = reference_next(&reference);
+        if (!diff_code(code, context, expected, &reference)) {
+            printf(" %-17s differs at code %lu, line %u, column %u\n", label, (unsigned long)codes, context->line,
+                context->column);
+            (*failures)++;
+            break;
+        }
+        codes++;
+        if (code < HOJSON_NO_OP || (code == HOJSON_END_OF_DOCUMENT && !is_multi_document))
+            break;
+    }
+    reference_free(&reference);
+    return codes;
+}
+
+/* Times parsing content whole with hojson, or the reference if it's given UTF-8 to parse instead */
+static double diff_time(const bench_text_t* content, const bench_text_t* utf8, uint8_t is_multi_document,
+        int iterations) {
+    static char* buffer = NULL;
+    static size_t buffer_length = 0;
+    if (buffer == NULL && (buffer = (char*)malloc(buffer_length = 4096)) == NULL)
+        exit(EXIT_FAILURE);
+    double best = -1.0;
+    int iteration;
+    for (iteration = 0; iteration <= iterations; iteration++) { /* The first run warms up and isn't counted */
+        clock_t start = clock();
+        hojson_code_t code;
+        if (utf8 != NULL) {
+            reference_t reference;
+            reference_init(&reference, utf8->data, utf8->length);
+            while ((code = reference_next(&reference)) > HOJSON_NO_OP) ;
+            reference_free(&reference);
+        } else {
+            hojson_context_t context[1] = { { NULL } };
+            hojson_init(context, buffer, buffer_length);
+            hojson_set_multi_document(context, is_multi_document);
+            while ((code = hojson_parse(context, content->data, content->length)) > HOJSON_NO_OP ||
+                    code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+                if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+                    char* larger = (char*)malloc(buffer_length * 2);
+                    if (larger == NULL)
+                        exit(EXIT_FAILURE);
+                    hojson_realloc(context, larger, buffer_length * 2);
+                    free(buffer);
+                    buffer = larger;
+                    buffer_length *= 2;
+                } else if (code == HOJSON_END_OF_DOCUMENT && !is_multi_document)
+                    break;
+            }
+        }
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        if (iteration > 0 && (best < 0.0 || seconds < best))
+            best = seconds;
+    }
+    return best > 0.0 ? best : 1.0 / CLOCKS_PER_SEC;
+}
+
+static void diff_run(const char* label, const bench_text_t* content, const bench_text_t* utf8,
+        uint8_t is_multi_document, int iterations, int* failures) {
+    int failures_before = *failures;
+    size_t codes = diff_compare(label, content, utf8, is_multi_document, 0, failures);
+    diff_compare(label, content, utf8, is_multi_document, 64, failures);
+    if (*failures > failures_before)
+        return;
+    double hojson_seconds = diff_time(content, NULL, is_multi_document, iterations);
+    double reference_seconds = diff_time(content, utf8, is_multi_document, iterations);
+    printf(" %-17s %10lu codes agree %9.1f MB/s %9.1f MB/s %7.2fx\n", label, (unsigned long)codes,
+        content->length / hojson_seconds / 1e6, utf8->length / reference_seconds / 1e6,
+        reference_seconds / hojson_seconds);
+}
+
+/* Parses content whole with hojson, returning the code that ended its first document */
+static hojson_code_t diff_parse_last(const char* json, size_t json_length) {
+    size_t buffer_length = 4096;
+    char* buffer = (char*)malloc(buffer_length);
+    if (buffer == NULL)
+        exit(EXIT_FAILURE);
+    hojson_context_t context[1] = { { NULL } };
+    hojson_init(context, buffer, buffer_length);
+    hojson_code_t code;
+    while ((code = hojson_parse(context, json, json_length)) > HOJSON_END_OF_DOCUMENT ||
+            code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+        if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+            char* larger = (char*)malloc(buffer_length * 2);
+            if (larger == NULL)
+                exit(EXIT_FAILURE);
+            hojson_realloc(context, larger, buffer_length * 2);
+            free(buffer);
+            buffer = larger;
+            buffer_length *= 2;
+        }
+    }
+    free(buffer);
+    return code;
+}
+
+/* Validates content with hojson_validate() and checks it ends just as parsing the content does */
+static void diff_validate(const char* label, const char* json, size_t json_length, int* failures) {
+    hojson_code_t parsed = diff_parse_last(json, json_length), validated = hojson_validate(json, json_length, NULL);
+    if (validated != parsed) {
+        printf(" %-17s validates to %d where parsing ends with %d\n", label, validated, parsed);
+        (*failures)++;
+    }
+}
+
+/* Content that the validator, being separate from the parser, has to be kept in agreement with it on */
+static const struct {
+    const char* label;
+    const char* json;
+    size_t length;
+} diff_edge_cases[] = {
+    { "UTF-16LE BOM", "\xFF\xFE[\0]\0", 6 }, /* A syntax error when built for UTF-8 alone */
+    { "UTF-16BE BOM", "\xFE\xFF\0[\0]", 6 },
+    { "UTF-8 continuation", "\xEF\xBB\xBF[\"\x80\"]", 8 }, /* Only decoded when UTF-16 is also enabled */
+    { "UTF-8 truncated", "\xEF\xBB\xBF[\"\xE0\"]", 8 }
+};
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 3, failures = 0;
+    size_t length = (size_t)(argc > 2 ? atoi(argv[2]) : 4) * BENCH_MEBIBYTE;
+    if (iterations < 1 || length == 0) {
+        fprintf(stderr, "Usage: %s [iterations] [corpus size in MiB]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench_text_t twitter = { NULL, 0, 0 }, canada = { NULL, 0, 0 }, citm = { NULL, 0, 0 }, deep = { NULL, 0, 0 },
+        long_strings = { NULL, 0, 0 }, ndjson = { NULL, 0, 0 }, utf16le = { NULL, 0, 0 }, utf16be = { NULL, 0, 0 };
+    bench_twitter(&twitter, length);
+    bench_canada(&canada, length);
+    bench_citm(&citm, length);
+    bench_deep(&deep, length);
+    bench_long_strings(&long_strings, length);
+    bench_ndjson(&ndjson, length);
+    bench_utf16(&utf16le, &twitter, 0);
+    bench_utf16(&utf16be, &twitter, 1);
+
+    printf("\n --------- Comparing with the reference parser, whole and in 64 B parts, each corpus about %lu MiB\n",
+        (unsigned long)(length / BENCH_MEBIBYTE));
+    printf(" %-17s %22s %14s %14s %8s\n", "", "", "hojson", "reference", "speedup");
+    diff_run("twitter", &twitter, &twitter, 0, iterations, &failures);
+    diff_run("canada", &canada, &canada, 0, iterations, &failures);
+    diff_run("citm_catalog", &citm, &citm, 0, iterations, &failures);
+    diff_run("deep", &deep, &deep, 0, iterations, &failures);
+    diff_run("long strings", &long_strings, &long_strings, 0, iterations, &failures);
+    diff_run("ndjson", &ndjson, &ndjson, 1, iterations, &failures);
+#ifndef HOJSON_UTF8_ONLY /* A build for UTF-8 alone takes UTF-16 for a syntax error */
+    diff_run("twitter UTF-16LE", &utf16le, &twitter, 0, iterations, &failures);
+    diff_run("twitter UTF-16BE", &utf16be, &twitter, 0, iterations, &failures);
+#endif /* HOJSON_UTF8_ONLY */
+
+    int failures_before = failures;
+    size_t i;
+    diff_validate("twitter", twitter.data, twitter.length, &failures);
+    diff_validate("canada", canada.data, canada.length, &failures);
+    diff_validate("citm_catalog", citm.data, citm.length, &failures);
+    diff_validate("long strings", long_strings.data, long_strings.length, &failures);
+    diff_validate("twitter UTF-16LE", utf16le.data, utf16le.length, &failures);
+    diff_validate("twitter UTF-16BE", utf16be.data, utf16be.length, &failures);
+    for (i = 0; i < sizeof(diff_edge_cases) / sizeof(diff_edge_cases[0]); i++)
+        diff_validate(diff_edge_cases[i].label, diff_edge_cases[i].json, diff_edge_cases[i].length, &failures);
+    if (failures == failures_before)
+        printf(" %-17s %lu documents validate as they parse\n", "validator",
+            (unsigned long)(6 + sizeof(diff_edge_cases) / sizeof(diff_edge_cases[0])));
+
+    free(twitter.data);
+    free(canada.data);
+    free(citm.data);
+    free(deep.data);
+    free(long_strings.data);
+    free(ndjson.data);
+    free(utf16le.data);
+    free(utf16be.data);
+    if (failures > 0)
+        printf("\n %d corpora differ\n", failures);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,358 @@
+#ifndef HOJSON_REFERENCE_H
+#define HOJSON_REFERENCE_H
+
+/*
+ * A minimal JSON parser, following RFC 8259 to the letter, for the differential harness only. It favors being plainly
+ * correct over being fast and returns the same codes as hojson_parse() so the two can be compared code by code:
+ * names, values, and the beginnings and ends of objects and arrays, with the depth, name, and value reported the way
+ * hojson reports them. Content is UTF-8, given whole, and may hold several documents separated by whitespace.
+ * Include after hojson.h, along with stdlib.h (strtod(), strtol()) and string.h.
+ */
+
+#define REFERENCE_MAXIMUM_DEPTH 1024
+
+typedef enum {
+    REFERENCE_EXPECT_VALUE = 0, /* A value, at the root or after a name's colon */
+    REFERENCE_EXPECT_FIRST_NAME, /* A name or '}', just after '{' */
+    REFERENCE_EXPECT_FIRST_VALUE, /* A value or ']', just after '[' */
+    REFERENCE_EXPECT_COMMA /* A ',' or the container's closing token */
+} reference_expect_t;
+
+typedef struct {
+    /* Public, as in hojson_context_t */
+    const char* name; /* Name of the member or, for containers, of the container, if it has one */
+    uint32_t depth; /* Containers open, not yet counting one that begins but still counting one that ends */
+    hojson_type_t value_type;
+    const char* string_value;
+    size_t string_length; /* Unlike hojson, the length is kept so strings with escaped nulls compare too */
+    size_t name_length;
+    long integer_value;
+    double float_value;
+    uint8_t bool_value;
+
+    /* Private */
+    const char* json;
+    size_t json_length;
+    size_t offset;
+    uint32_t open; /* Containers open */
+    uint8_t is_array[REFERENCE_MAXIMUM_DEPTH];
+    size_t name_starts[REFERENCE_MAXIMUM_DEPTH + 1]; /* Where each open container's name starts in the names */
+    uint8_t has_name[REFERENCE_MAXIMUM_DEPTH + 1];
+    reference_expect_t expect;
+    char* names; /* Names of the open containers and the current member, one after another */
+    size_t names_length;
+    size_t names_capacity;
+    char* string; /* The last string value, decoded */
+    size_t string_capacity;
+    size_t pop_names_to; /* Length to cut the names back to before the next code, or (size_t)-1 */
+    uint8_t is_document_done; /* The root closed, so HOJSON_END_OF_DOCUMENT is next */
+} reference_t;
+
+static void reference_init(reference_t* reference, const char* json, size_t json_length) {
+    memset(reference, 0, sizeof(reference_t));
+    reference->json = json;
+    reference->json_length = json_length;
+    reference->pop_names_to = (size_t)-1;
+}
+
+static void reference_free(reference_t* reference) {
+    free(reference->names);
+    free(reference->string);
+}
+
+static int reference_reserve(char** data, size_t* capacity, size_t length) {
+    if (length <= *capacity)
+        return 1;
+    size_t new_capacity = *capacity > 0 ? *capacity : 256;
+    while (new_capacity < length)
+        new_capacity *= 2;
+    char* new_data = (char*)realloc(*data, new_capacity);
+    if (new_data == NULL)
+        return 0;
+    *data = new_data;
+    *capacity = new_capacity;
+    return 1;
+}
+
+static void reference_skip_whitespace(reference_t* reference) {
+    while (reference->offset < reference->json_length) {
+        char c = reference->json[reference->offset];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            break;
+        reference->offset++;
+    }
+}
+
+static int reference_hex(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/* Appends a code point, as UTF-8, to a growing string */
+static int reference_put_utf8(char** data, size_t* length, size_t* capacity, uint32_t value) {
+    if (!reference_reserve(data, capacity, *length + 4))
+        return 0;
+    char* out = *data + *length;
+    if (value < 0x80) {
+        out[0] = (char)value;
+        *length += 1;
+    } else if (value < 0x800) {
+        out[0] = (char)(0xC0 | (value >> 6));
+        out[1] = (char)(0x80 | (value & 0x3F));
+        *length += 2;
+    } else if (value < 0x10000) {
+        out[0] = (char)(0xE0 | (value >> 12));
+        out[1] = (char)(0x80 | ((value >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (value & 0x3F));
+        *length += 3;
+    } else {
+        out[0] = (char)(0xF0 | (value >> 18));
+        out[1] = (char)(0x80 | ((value >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((value >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (value & 0x3F));
+        *length += 4;
+    }
+    return 1;
+}
+
+/* Decodes a string, whose opening quote is at the offset, onto the end of a growing string */
+static int reference_string(reference_t* reference, char** data, size_t* length, size_t* capacity) {
+    const char* json = reference->json;
+    size_t i = reference->offset + 1;
+    while (i < reference->json_length && json[i] != '"') {
+        unsigned char c = (unsigned char)json[i];
+        if (c < 0x20) /* Control characters must be escaped */
+            return 0;
+        if (c != '\\') {
+            if (!reference_reserve(data, capacity, *length + 1))
+                return 0;
+            (*data)[(*length)++] = (char)c;
+            i++;
+            continue;
+        }
+        if (++i >= reference->json_length)
+            return 0;
+        uint32_t value;
+        switch (json[i]) {
+        case '"': value = '"'; break;
+        case '\\': value = '\\'; break;
+        case '/': value = '/'; break;
+        case 'b': value = '\b'; break;
+        case 'f': value = '\f'; break;
+        case 'n': value = '\n'; break;
+        case 'r': value = '\r'; break;
+        case 't': value = '\t'; break;
+        case 'u': {
+            int j, digit;
+            if (i + 4 >= reference->json_length)
+                return 0;
+            for (value = 0, j = 1; j <= 4; j++) {
+                if ((digit = reference_hex(json[i + j])) < 0)
+                    return 0;
+                value = value * 16 + (uint32_t)digit;
+            }
+            i += 4;
+            /* A high surrogate followed by an escaped low surrogate is one character */
+            if (value >= 0xD800 && value <= 0xDBFF && i + 6 < reference->json_length && json[i + 1] == '\\' &&
+                    json[i + 2] == 'u') {
+                uint32_t low = 0;
+                for (j = 3; j <= 6 && (digit = reference_hex(json[i + j])) >= 0; j++)
+                    low = low * 16 + (uint32_t)digit;
+                if (j == 7 && low >= 0xDC00 && low <= 0xDFFF) {
+                    value = 0x10000 + ((value - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+            }
+        } break;
+        default: return 0;
+        }
+        if (!reference_put_utf8(data, length, capacity, value))
+            return 0;
+        i++;
+    }
+    if (i >= reference->json_length)
+        return 0;
+    reference->offset = i + 1;
+    return 1;
+}
+
+/* Scans a number by the grammar -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? and converts it */
+static int reference_number(reference_t* reference) {
+    const char* json = reference->json;
+    size_t i = reference->offset, end = reference->json_length;
+    uint8_t is_float = 0;
+    if (i < end && json[i] == '-')
+        i++;
+    if (i < end && json[i] == '0')
+        i++;
+    else if (i < end && json[i] >= '1' && json[i] <= '9')
+        while (i < end && json[i] >= '0' && json[i] <= '9')
+            i++;
+    else
+        return 0;
+    if (i < end && json[i] == '.') {
+        is_float = 1;
+        if (++i >= end || json[i] < '0' || json[i] > '9')
+            return 0;
+        while (i < end && json[i] >= '0' && json[i] <= '9')
+            i++;
+    }
+    if (i < end && (json[i] == 'e' || json[i] == 'E')) {
+        is_float = 1;
+        if (++i < end && (json[i] == '+' || json[i] == '-'))
+            i++;
+        if (i >= end || json[i] < '0' || json[i] > '9')
+            return 0;
+        while (i < end && json[i] >= '0' && json[i] <= '9')
+            i++;
+    }
+
+    char digits[512];
+    if (i - reference->offset >= sizeof(digits))
+        return 0;
+    memcpy(digits, json + reference->offset, i - reference->offset);
+    digits[i - reference->offset] = '\0';
+    if (is_float) {
+        reference->value_type = HOJSON_TYPE_FLOAT;
+        reference->float_value = strtod(digits, NULL);
+    } else {
+        reference->value_type = HOJSON_TYPE_INTEGER;
+        reference->integer_value = strtol(digits, NULL, 10);
+    }
+    reference->offset = i;
+    return 1;
+}
+
+static int reference_literal(reference_t* reference, const char* literal) {
+    size_t length = strlen(literal);
+    if (reference->json_length - reference->offset < length ||
+            memcmp(reference->json + reference->offset, literal, length) != 0)
+        return 0;
+    reference->offset += length;
+    return 1;
+}
+
+/* Points the name at the current member's or container's name, or at nothing */
+static void reference_name(reference_t* reference, uint32_t level) {
+    reference->name = reference->has_name[level] ? reference->names + reference->name_starts[level] : NULL;
+    reference->name_length = reference->has_name[level] ? strlen(reference->name) : 0;
+}
+
+/* Returns the next code, like hojson_parse(), or HOJSON_ERROR_UNEXPECTED_EOF once the content has been consumed */
+static hojson_code_t reference_next(reference_t* reference) {
+    if (reference->pop_names_to != (size_t)-1) { /* The last code's member is done with */
+        reference->names_length = reference->pop_names_to;
+        reference->has_name[reference->open] = 0;
+        reference->pop_names_to = (size_t)-1;
+    }
+    reference->value_type = HOJSON_TYPE_NONE;
+    reference->string_value = NULL;
+    reference->depth = reference->open;
+    if (reference->is_document_done) {
+        reference->is_document_done = 0;
+        reference->name = NULL;
+        return HOJSON_END_OF_DOCUMENT;
+    }
+    reference_skip_whitespace(reference);
+    if (reference->offset >= reference->json_length)
+        return HOJSON_ERROR_UNEXPECTED_EOF;
+    char c = reference->json[reference->offset];
+
+    if (reference->expect == REFERENCE_EXPECT_COMMA) {
+        uint8_t is_array = reference->is_array[reference->open - 1];
+        if (c == (is_array ? ']' : '}')) { /* The container ends, reporting its own name */
+            reference->offset++;
+            reference_name(reference, reference->open - 1);
+            reference->pop_names_to = reference->has_name[reference->open - 1] ?
+                reference->name_starts[reference->open - 1] : reference->names_length;
+            reference->open--;
+            reference->has_name[reference->open] = 0;
+            reference->expect = reference->open > 0 ? REFERENCE_EXPECT_COMMA : REFERENCE_EXPECT_VALUE;
+            reference->is_document_done = reference->open == 0;
+            return is_array ? HOJSON_ARRAY_END : HOJSON_OBJECT_END;
+        } else if (c != ',')
+            return HOJSON_ERROR_SYNTAX;
+        reference->offset++;
+        reference_skip_whitespace(reference);
+        if (reference->offset >= reference->json_length)
+            return HOJSON_ERROR_UNEXPECTED_EOF;
+        c = reference->json[reference->offset];
+        reference->expect = is_array ? REFERENCE_EXPECT_VALUE : REFERENCE_EXPECT_FIRST_NAME;
+        if (!is_array && c != '"') /* No trailing commas */
+            return HOJSON_ERROR_SYNTAX;
+    } else if (reference->expect == REFERENCE_EXPECT_FIRST_NAME || reference->expect == REFERENCE_EXPECT_FIRST_VALUE) {
+        uint8_t is_array = reference->expect == REFERENCE_EXPECT_FIRST_VALUE;
+        if (c == (is_array ? ']' : '}')) { /* An empty container */
+            reference->expect = REFERENCE_EXPECT_COMMA;
+            return reference_next(reference);
+        }
+        if (!is_array) {
+            if (c != '"')
+                return HOJSON_ERROR_SYNTAX;
+        } else
+            reference->expect = REFERENCE_EXPECT_VALUE;
+    }
+
+    if (reference->expect == REFERENCE_EXPECT_FIRST_NAME) { /* A member's name and its colon */
+        size_t start = reference->names_length;
+        if (!reference_string(reference, &reference->names, &reference->names_length, &reference->names_capacity) ||
+                !reference_reserve(&reference->names, &reference->names_capacity, reference->names_length + 1))
+            return HOJSON_ERROR_SYNTAX;
+        reference->names[reference->names_length++] = '\0';
+        reference->name_starts[reference->open] = start;
+        reference->has_name[reference->open] = 1;
+        reference_skip_whitespace(reference);
+        if (reference->offset >= reference->json_length || reference->json[reference->offset] != ':')
+            return HOJSON_ERROR_SYNTAX;
+        reference->offset++;
+        reference->expect = REFERENCE_EXPECT_VALUE;
+        reference_name(reference, reference->open);
+        return HOJSON_NAME;
+    }
+
+    /* A value, whose name is the member's if it's in an object */
+    reference_name(reference, reference->open);
+    if (c == '{' || c == '[') {
+        if (reference->open >= REFERENCE_MAXIMUM_DEPTH)
+            return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        reference->offset++;
+        reference->is_array[reference->open] = c == '[';
+        reference->open++;
+        reference->has_name[reference->open] = 0;
+        reference->expect = c == '[' ? REFERENCE_EXPECT_FIRST_VALUE : REFERENCE_EXPECT_FIRST_NAME;
+        return c == '[' ? HOJSON_ARRAY_BEGIN : HOJSON_OBJECT_BEGIN;
+    }
+    if (reference->open == 0) /* Like hojson, the root is an object or an array */
+        return HOJSON_ERROR_SYNTAX;
+    if (c == '"') {
+        size_t length = 0;
+        if (!reference_string(reference, &reference->string, &length, &reference->string_capacity) ||
+                !reference_reserve(&reference->string, &reference->string_capacity, length + 1))
+            return HOJSON_ERROR_SYNTAX;
+        reference->string[length] = '\0';
+        reference->value_type = HOJSON_TYPE_STRING;
+        reference->string_value = reference->string;
+        reference->string_length = length;
+    } else if (c == 't' || c == 'f') {
+        if (!reference_literal(reference, c == 't' ? "true" : "false"))
+            return HOJSON_ERROR_SYNTAX;
+        reference->value_type = HOJSON_TYPE_BOOLEAN;
+        reference->bool_value = c == 't';
+    } else if (c == 'n') {
+        if (!reference_literal(reference, "null"))
+            return HOJSON_ERROR_SYNTAX;
+        reference->value_type = HOJSON_TYPE_NULL;
+    } else if (!reference_number(reference))
+        return HOJSON_ERROR_SYNTAX;
+    reference->expect = REFERENCE_EXPECT_COMMA;
+    reference->pop_names_to = reference->has_name[reference->open] ? reference->name_starts[reference->open] :
+        reference->names_length;
+    return HOJSON_VALUE;
+}
+
+#endif /* HOJSON_REFERENCE_H */
@@ -2,7 +2,7 @@
 #include <stdlib.h> /* EXIT_FAILURE, EXIT_SUCCESS, free(), malloc(), NULL */
 
 #define HOJSON_IMPLEMENTATION
-/* #define HOJSON_DEBUG */
+/* #define HOJSON_TRACE */
 #include "hojson.h"
 
 int main(int argc, char** argv) {
@@ -50,12 +50,15 @@ int main(int argc, char** argv) {
                 else
                     printf(" Value: \"%s\" = %ld\n", hojson_context->name, hojson_context->integer_value);
                 break;
-            case HOJSON_TYPE_FLOAT:
+            case HOJSON_TYPE_FLOAT: {
+                /* Format the value with as many digits as it takes to read back exactly, but no more */
+                char float_string[HOJSON_FORMAT_DOUBLE_LENGTH];
+                hojson_format_double(hojson_context->float_value, float_string);
                 if (hojson_context->name == NULL)
-                    printf(" Value: %g\n", hojson_context->float_value);
+                    printf(" Value: %s\n", float_string);
                 else
-                    printf(" Value: \"%s\" = %g\n", hojson_context->name, hojson_context->float_value);
-                break;
+                    printf(" Value: \"%s\" = %s\n", hojson_context->name, float_string);
+            } break;
             case HOJSON_TYPE_STRING:
                 if (hojson_context->name == NULL)
                     printf(" Value: \"%s\"\n", hojson_context->string_value);
@@ -0,0 +1,388 @@
+#include <stdio.h> /* FILE, fclose(), fopen(), fprintf(), fread(), stderr, stdin */
+#include <stdlib.h> /* abort(), atof(), atol(), EXIT_FAILURE, EXIT_SUCCESS, free(), getenv(), malloc(), realloc() */
+#include <time.h> /* clock(), clock_t, CLOCKS_PER_SEC */
+
+#define HOJSON_IMPLEMENTATION
+#include "hojson.h"
+
+/*
+ * Fuzzes hojson_parse() with untrusted input. The first byte of an input picks how it's parsed and the rest is the
+ * content:
+ *   bits 0-1: 0 UTF-8, 1 UTF-8 widened to UTF-16LE with a BOM, 2 widened to UTF-16BE with a BOM, 3 raw bytes after a
+ *             UTF-16LE BOM (so surrogates and odd lengths are reachable)
+ *   bits 2-3: the buffer's initial length, 16, 48, 128, or 1024 bytes, doubled by hojson_realloc() when it's too short
+ *   bit 4:    parse multiple documents
+ *   bit 5:    checkpoint and restore, into a new buffer, now and then when the content runs out
+ *   bits 6-7: how parts are cut: whole, one byte at a time, all the same length, or each a different length, with
+ *             lengths seeded from the second byte
+ *
+ * Parsed in parts, the codes, depths, names, and values must be the same as those of parsing the content whole, with
+ * a buffer that's large enough from the start, unless a null character ended the whole content early. Any difference,
+ * a crash, or an input that takes longer per byte than the threshold in HOJSON_FUZZ_SLOW_NS_PER_BYTE (default 20000)
+ * aborts so the fuzzer keeps the input.
+ *
+ * Built with -DHOJSON_FUZZ_LIBFUZZER, only LLVMFuzzerTestOneInput() is defined for libFuzzer. Otherwise, main() runs
+ * each file named on the command line, or stdin for AFL, and with "-n <count>" also mutates them that many times.
+ */
+
+#define FUZZ_MAXIMUM_BUFFER 65536 /* Inputs needing more than this are only parsed, not compared */
+#define FUZZ_SLOW_MINIMUM 256 /* Shorter inputs are too quick to time */
+
+/* The input being run, saved by fuzz_fail() when there's no fuzzer to do it */
+static const uint8_t* fuzz_input = NULL;
+static size_t fuzz_input_length = 0;
+
+static void fuzz_fail(const char* reason) {
+    fprintf(stderr, "%s\n", reason);
+#ifndef HOJSON_FUZZ_LIBFUZZER
+    FILE* file = fopen("crash-hojson-fuzz.bin", "wb");
+    if (file != NULL) {
+        fwrite(fuzz_input, 1, fuzz_input_length, file);
+        fclose(file);
+        fprintf(stderr, "The input was saved to crash-hojson-fuzz.bin\n");
+    }
+#endif
+    abort();
+}
+
+/* Summary of a parse: a hash of every code and what came with it, and how parsing ended */
+typedef struct {
+    uint64_t hash;
+    uint32_t codes;
+    hojson_code_t last_code;
+    uint8_t is_out_of_memory;
+    uint8_t is_cut; /* A null character ended the content early, which parts after it would carry on from */
+} fuzz_result_t;
+
+static uint64_t fuzz_random_state = 0x9E3779B97F4A7C15u;
+static uint64_t fuzz_random(void) {
+    fuzz_random_state ^= fuzz_random_state << 13;
+    fuzz_random_state ^= fuzz_random_state >> 7;
+    fuzz_random_state ^= fuzz_random_state << 17;
+    return fuzz_random_state;
+}
+
+static uint64_t fuzz_hash(uint64_t hash, const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    size_t i;
+    for (i = 0; i < length; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3u; /* FNV-1a */
+    return hash;
+}
+
+/* Hashes a string appended by hojson, ending with a one or two byte terminator depending on the encoding */
+static uint64_t fuzz_hash_string(uint64_t hash, const char* str, uint8_t encoding) {
+    size_t length = 0;
+    if (encoding >= HOJSON_ENCODING_UTF_16_BE)
+        while (str[length] != 0 || str[length + 1] != 0)
+            length += 2;
+    else
+        length = strlen(str);
+    return fuzz_hash(hash, str, length + 1);
+}
+
+static void fuzz_record(fuzz_result_t* result, const hojson_context_t* context, hojson_code_t code) {
+    uint64_t hash = fuzz_hash(result->hash, &code, sizeof(code));
+    hash = fuzz_hash(hash, &(context->depth), sizeof(context->depth));
+    if (context->name != NULL)
+        hash = fuzz_hash_string(hash, context->name, context->encoding);
+    if (code == HOJSON_VALUE) {
+        hash = fuzz_hash(hash, &(context->value_type), sizeof(context->value_type));
+        switch (context->value_type) {
+        case HOJSON_TYPE_STRING: hash = fuzz_hash_string(hash, context->string_value, context->encoding); break;
+        case HOJSON_TYPE_INTEGER: hash = fuzz_hash(hash, &(context->integer_value), sizeof(int)); break;
+        case HOJSON_TYPE_FLOAT: hash = fuzz_hash(hash, &(context->float_value), sizeof(double)); break;
+        case HOJSON_TYPE_BOOLEAN: hash = fuzz_hash(hash, &(context->bool_value), sizeof(context->bool_value)); break;
+        default: break;
+        }
+    }
+    result->hash = hash;
+    result->codes++;
+}
+
+/* Doubles the buffer, as a user recovering from HOJSON_ERROR_INSUFFICIENT_MEMORY would, unless it's at the maximum */
+static uint8_t fuzz_grow(hojson_context_t* context, char** buffer, size_t* buffer_length) {
+    if (*buffer_length >= FUZZ_MAXIMUM_BUFFER)
+        return 0;
+    char* new_buffer = (char*)malloc(*buffer_length * 2);
+    if (new_buffer == NULL)
+        return 0;
+    hojson_realloc(context, new_buffer, *buffer_length * 2);
+    free(*buffer); /* Freed so any pointer hojson kept into it is caught by a sanitizer */
+    *buffer = new_buffer;
+    *buffer_length *= 2;
+    return 1;
+}
+
+/* Moves parsing into a new buffer through a checkpoint, checking the input offset it resumes from */
+static void fuzz_checkpoint(hojson_context_t* context, char** buffer, size_t buffer_length, size_t offset) {
+    size_t blob_length = 0, input_offset = 0;
+    if (hojson_checkpoint(context, NULL, 0, &blob_length, NULL) != HOJSON_ERROR_INSUFFICIENT_MEMORY)
+        fuzz_fail("Checkpointing didn't report the checkpoint's length");
+    char* blob = (char*)malloc(blob_length);
+    char* new_buffer = (char*)malloc(buffer_length);
+    if (blob == NULL || new_buffer == NULL)
+        abort();
+    if (hojson_checkpoint(context, blob, blob_length, &blob_length, &input_offset) != HOJSON_NO_OP ||
+            input_offset != offset) /* Everything up to the end of the content must have been consumed */
+        fuzz_fail("Checkpointing failed or didn't resume from the end of the content");
+    memset(context, 0xA5, sizeof(hojson_context_t)); /* Nothing of the old context may survive */
+    if (hojson_restore(context, new_buffer, buffer_length, blob, blob_length, &input_offset) != HOJSON_NO_OP ||
+            input_offset != offset)
+        fuzz_fail("Restoring a checkpoint failed or didn't resume from the end of the content");
+    free(blob);
+    free(*buffer);
+    *buffer = new_buffer;
+}
+
+/* Length of the next part, cut as the flags say, of what remains of the content */
+static size_t fuzz_part_length(uint8_t flags, size_t remaining) {
+    size_t part_length = remaining;
+    if ((flags & 0xC0) == 0x40)
+        part_length = 1;
+    else if (flags & 0xC0)
+        part_length = 1 + (size_t)(fuzz_random() % 17);
+    return part_length < remaining ? part_length : remaining;
+}
+
+/* Parses content, in parts cut as the flags say, and recovers from running out of memory or content */
+static fuzz_result_t fuzz_parse(const char* json, size_t json_length, uint8_t flags, uint8_t seed,
+        size_t buffer_length, uint8_t is_in_parts) {
+    fuzz_result_t result;
+    memset(&result, 0, sizeof(result));
+    result.hash = 0xCBF29CE484222325u;
+    char* buffer = (char*)malloc(buffer_length);
+    if (buffer == NULL)
+        abort();
+    hojson_context_t context[1];
+    hojson_init(context, buffer, buffer_length);
+    hojson_set_multi_document(context, (flags & 0x10) != 0);
+
+    uint64_t state = fuzz_random_state;
+    fuzz_random_state = seed + 1; /* The same cuts every time the input is run */
+    size_t offset = 0, part_length = is_in_parts ? fuzz_part_length(flags, json_length) : json_length;
+
+    /* Every call either returns a code, consumes content, or grows the buffer, so this bounds a stuck parser */
+    size_t calls = 0, maximum_calls = 4 * json_length + 64;
+    hojson_code_t code = HOJSON_ERROR_UNEXPECTED_EOF;
+    while (offset < json_length || part_length > 0) {
+        if (++calls > maximum_calls)
+            fuzz_fail("Parsing made no progress");
+        code = hojson_parse(context, json + offset, part_length);
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF) {
+            if (context->iterator != json + offset + part_length)
+                result.is_cut = 1;
+            offset += part_length;
+            if (offset >= json_length)
+                break;
+            /* A checkpoint costs as much as the buffer's used so, to keep the time per byte about parsing, one is */
+            /* taken after every sixteenth part on average. Cut content wasn't consumed to the end so it's skipped. */
+            if (is_in_parts && (flags & 0x20) && !result.is_cut && (fuzz_random() & 0x0F) == 0)
+                fuzz_checkpoint(context, &buffer, buffer_length, offset);
+            if (is_in_parts && (flags & 0xC0) == 0xC0)
+                part_length = fuzz_part_length(flags, json_length - offset); /* A new cut for every part */
+            else if (part_length > json_length - offset)
+                part_length = json_length - offset;
+        } else if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+            if (!fuzz_grow(context, &buffer, &buffer_length)) {
+                result.is_out_of_memory = 1;
+                break;
+            }
+        } else if (code < HOJSON_NO_OP || (code == HOJSON_END_OF_DOCUMENT && !(flags & 0x10)))
+            break;
+        else
+            fuzz_record(&result, context, code);
+    }
+    result.last_code = code;
+    fuzz_random_state = state;
+    free(buffer);
+    return result;
+}
+
+/* Puts an input's content into the encoding its flags ask for */
+static char* fuzz_encode(const uint8_t* data, size_t length, uint8_t flags, size_t* json_length) {
+    char* json = (char*)malloc(2 * length + 2 > 0 ? 2 * length + 2 : 1);
+    size_t i;
+    if (json == NULL)
+        abort();
+    switch (flags & 0x03) {
+    case 0:
+        memcpy(json, data, length);
+        *json_length = length;
+        break;
+    case 1:
+    case 2: {
+        uint8_t is_big_endian = (flags & 0x03) == 2;
+        json[0] = (char)(is_big_endian ? 0xFE : 0xFF);
+        json[1] = (char)(is_big_endian ? 0xFF : 0xFE);
+        for (i = 0; i < length; i++) {
+            json[2 + 2 * i + is_big_endian] = (char)data[i];
+            json[2 + 2 * i + !is_big_endian] = 0;
+        }
+        *json_length = 2 * length + 2;
+    } break;
+    default:
+        json[0] = (char)0xFF;
+        json[1] = (char)0xFE;
+        memcpy(json + 2, data, length);
+        *json_length = length + 2;
+    }
+    return json;
+}
+
+static double fuzz_slow_ns_per_byte(void) {
+    static double threshold = 0.0;
+    if (threshold == 0.0) {
+        const char* env = getenv("HOJSON_FUZZ_SLOW_NS_PER_BYTE");
+        threshold = env != NULL && atof(env) > 0.0 ? atof(env) : 20000.0;
+    }
+    return threshold;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 2)
+        return 0;
+    static const size_t buffer_lengths[] = { 16, 48, 128, 1024 };
+    uint8_t flags = data[0], seed = data[1];
+    fuzz_input = data;
+    fuzz_input_length = size;
+    size_t json_length;
+    char* json = fuzz_encode(data + 2, size - 2, flags, &json_length);
+    clock_t start = clock();
+
+    fuzz_result_t whole = fuzz_parse(json, json_length, flags, seed, FUZZ_MAXIMUM_BUFFER, 0);
+    fuzz_result_t parts = fuzz_parse(json, json_length, flags, seed, buffer_lengths[(flags >> 2) & 0x03], 1);
+    if (!whole.is_out_of_memory && !parts.is_out_of_memory && !whole.is_cut && (whole.hash != parts.hash ||
+            whole.codes != parts.codes || whole.last_code != parts.last_code)) {
+        fprintf(stderr, "Parsing in parts returned %lu codes, ending with %d, unlike parsing whole with %lu, ending "
+            "with %d\n", (unsigned long)parts.codes, parts.last_code, (unsigned long)whole.codes, whole.last_code);
+        fuzz_fail("Parsing in parts differed");
+    }
+
+    /* Flag an input that's slow for its length, like one that triggers quadratic behavior */
+    double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC;
+    if (size >= FUZZ_SLOW_MINIMUM && ns / (double)size > fuzz_slow_ns_per_byte()) {
+        fprintf(stderr, "%lu bytes took %.0f ns per byte\n", (unsigned long)size, ns / (double)size);
+        fuzz_fail("Slow unit");
+    }
+    free(json);
+    return 0;
+}
+
+#ifndef HOJSON_FUZZ_LIBFUZZER
+/* Reads a file, or stdin if the path is NULL, into memory */
+static uint8_t* fuzz_read(const char* path, size_t* length) {
+    FILE* file = path != NULL ? fopen(path, "rb") : stdin;
+    uint8_t* data = NULL;
+    size_t capacity = 0;
+    *length = 0;
+    if (file == NULL)
+        return NULL;
+    for (;;) {
+        if (*length == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 4096;
+            if ((data = (uint8_t*)realloc(data, capacity)) == NULL)
+                abort();
+        }
+        size_t bytes_read = fread(data + *length, 1, capacity - *length, file);
+        if (bytes_read == 0)
+            break;
+        *length += bytes_read;
+    }
+    if (path != NULL)
+        fclose(file);
+    return data;
+}
+
+/* Flips, inserts, removes, or repeats a few bytes, with flags and a seed for the cuts in front, for one run */
+static size_t fuzz_mutate(const uint8_t* data, size_t length, uint8_t* mutant, size_t capacity) {
+    size_t mutant_length = 0, i, mutations = 1 + (size_t)(fuzz_random() % 4);
+    mutant[mutant_length++] = (uint8_t)fuzz_random();
+    mutant[mutant_length++] = (uint8_t)fuzz_random();
+    memcpy(mutant + mutant_length, data, length);
+    mutant_length += length;
+    for (i = 0; i < mutations && mutant_length > 2; i++) {
+        size_t at = 2 + (size_t)(fuzz_random() % (mutant_length - 2));
+        switch (fuzz_random() % 4) {
+        case 0: mutant[at] = (uint8_t)fuzz_random(); break; /* Replace a byte */
+        case 1: /* Insert a byte, likely a structural one */
+            if (mutant_length < capacity) {
+                memmove(mutant + at + 1, mutant + at, mutant_length - at);
+                mutant[at] = (uint8_t)"{}[]\":,\\0e-.tu"[fuzz_random() % 14];
+                mutant_length++;
+            } break;
+        case 2: /* Remove a byte */
+            memmove(mutant + at, mutant + at + 1, mutant_length - at - 1);
+            mutant_length--;
+            break;
+        default: { /* Repeat a run of bytes, which nests deeper or lengthens strings */
+            size_t run = 1 + (size_t)(fuzz_random() % 8), times = 1 + (size_t)(fuzz_random() % 64);
+            while (times-- > 0 && at + run <= mutant_length && mutant_length + run <= capacity) {
+                memmove(mutant + at + run, mutant + at, mutant_length - at);
+                mutant_length += run;
+            }
+        }
+        }
+    }
+    return mutant_length;
+}
+
+int main(int argc, char** argv) {
+    long iterations = 0, i;
+    int first = 1, files = 0, file;
+    if (argc >= 3 && strcmp(argv[1], "-n") == 0) {
+        iterations = atol(argv[2]);
+        first = 3;
+    }
+
+    uint8_t** inputs = (uint8_t**)malloc(sizeof(uint8_t*) * (size_t)(argc > first ? argc - first : 1));
+    size_t* lengths = (size_t*)malloc(sizeof(size_t) * (size_t)(argc > first ? argc - first : 1));
+    if (inputs == NULL || lengths == NULL)
+        return EXIT_FAILURE;
+    if (argc == first) /* AFL's way, one input through stdin */
+        inputs[files++] = fuzz_read(NULL, &lengths[0]);
+    for (file = first; file < argc; file++) {
+        if ((inputs[files] = fuzz_read(argv[file], &lengths[files])) == NULL) {
+            fprintf(stderr, "Couldn't read %s\n", argv[file]);
+            return EXIT_FAILURE;
+        }
+        files++;
+    }
+
+    /* Run each input as it is, then mutants of them. Seed files are plain JSON so they're run with every flag too. */
+    for (file = 0; file < files; file++) {
+        if (iterations > 0) {
+            uint8_t* input = (uint8_t*)malloc(lengths[file] + 2);
+            int flags;
+            if (input == NULL)
+                return EXIT_FAILURE;
+            memcpy(input + 2, inputs[file], lengths[file]);
+            for (flags = 0; flags < 256; flags++) {
+                input[0] = (uint8_t)flags;
+                input[1] = (uint8_t)file;
+                LLVMFuzzerTestOneInput(input, lengths[file] + 2);
+            }
+            free(input);
+        } else
+            LLVMFuzzerTestOneInput(inputs[file], lengths[file]);
+    }
+    if (files > 0 && iterations > 0) {
+        size_t capacity = 65536;
+        uint8_t* mutant = (uint8_t*)malloc(capacity);
+        if (mutant == NULL)
+            return EXIT_FAILURE;
+        for (i = 0; i < iterations; i++) {
+            file = (int)(fuzz_random() % (uint64_t)files);
+            size_t length = lengths[file] + 2 < capacity / 2 ? lengths[file] : capacity / 2 - 2;
+            LLVMFuzzerTestOneInput(mutant, fuzz_mutate(inputs[file], length, mutant, capacity));
+        }
+        free(mutant);
+        printf("Ran %ld mutants of %d inputs\n", iterations, files);
+    }
+    for (file = 0; file < files; file++)
+        free(inputs[file]);
+    free(inputs);
+    free(lengths);
+    return EXIT_SUCCESS;
+}
+#endif /* HOJSON_FUZZ_LIBFUZZER */
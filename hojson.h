@@ -25,6 +25,16 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define HOJSON_DECL extern
   to specify HOJSON function declarations as static or extern, respectively.
   The default specifier is extern.
+
+  You can define HOJSON_WRITER_MAX_DEPTH with
+    #define HOJSON_WRITER_MAX_DEPTH 1024
+  to change the deepest nesting the writer accepts. The default is 256.
+
+  You can define HOJSON_NO_SIMD to keep the writer from using SSE2 when escaping strings.
+
+  You can define HOJSON_UTF8_ONLY, along with HOJSON_IMPLEMENTATION, to compile a parser for UTF-8 content alone.
+  Without UTF-16 to decode, it takes content a byte at a time with no per-character dispatch on the encoding, and a
+  UTF-16 byte order marker is a syntax error. Columns count bytes rather than characters.
 */
 
 #ifndef HOJSON_H
@@ -39,6 +49,10 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define HOJSON_DECL
 #endif /* HOJSON_DECL */
 
+#ifndef HOJSON_WRITER_MAX_DEPTH
+    #define HOJSON_WRITER_MAX_DEPTH 256 /* Deepest nesting of objects/arrays the writer will track */
+#endif /* HOJSON_WRITER_MAX_DEPTH */
+
 #ifdef __cplusplus
     extern "C" {
 #endif /* __cpluspus */
@@ -50,6 +64,7 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  * Error and other codes returned after parsing.
  */
 typedef enum {
+    HOJSON_ERROR_IO = -7, /**< A callback reading or writing content on hojson's behalf reported a failure. */
     HOJSON_ERROR_INVALID_INPUT = -6, /**< One or more parameter passed to hojson was unacceptable. */
     HOJSON_ERROR_INTERNAL = -5, /**< There's a bug in hojson and parsing must halt. */
     HOJSON_ERROR_INSUFFICIENT_MEMORY = -4, /**< Initialization or continued parsing requires more memory. */
@@ -57,7 +72,8 @@ typedef enum {
     HOJSON_ERROR_TOKEN_MISMATCH = -2, /**< A '{' or '[' that opened an object/array did not match its closing token. */
     HOJSON_ERROR_SYNTAX = -1, /**< Generic syntax error. */
     HOJSON_NO_OP = 0, /**< No operation. If configured correctly, this should never be returned. */
-    HOJSON_END_OF_DOCUMENT, /**< The root element has closed and parsing is done. */
+    HOJSON_END_OF_DOCUMENT, /**< The root element has closed and parsing is done, or, with multiple documents, the
+                                 next document may follow. */
     HOJSON_NAME, /**< The name of a name-value pair is available. A value, array, or object is expected to follow. */
     HOJSON_VALUE, /**< The value of a name-value pair or array is available. Its type and name are also available. */
     HOJSON_OBJECT_BEGIN, /**< A new object opened. If it has a name, its name is available. */
@@ -75,6 +91,78 @@ typedef enum _hojson_type_t {
     HOJSON_TYPE_NULL /**< An anti-value or the lack of a value. */
 } hojson_type_t;
 
+/**
+ * Character encodings understood by hojson. The parser detects these from a document's byte order marker and the
+ * writer produces them on request.
+ */
+typedef enum {
+    HOJSON_ENCODING_UNKNOWN = 0, /**< The character encoding is unknown. UTF-8 is assumed. */
+    HOJSON_ENCODING_UTF_8, /**< Variable-length encoding (8, 16, 24, or 32 bits) compatible with ASCII */
+    HOJSON_ENCODING_UTF_16_LE, /**< Variable-length encoding (16 or 32 bits), little-endian variant */
+    HOJSON_ENCODING_UTF_16_BE /**< Variable-lenght encoding (16 or 32 bits), big-endian variant */
+} hojson_encoding_t;
+
+/**
+ * Called by hojson_pull() when the parser has reached the end of the content it has and needs more.
+ *
+ * @param user_data The pointer given to hojson_set_reader().
+ * @param buffer Memory to fill with the next bytes of JSON content. The parser isn't using any of it.
+ * @param buffer_length Maximum number of bytes to read.
+ * @param bytes_read Assigned the number of bytes read. Zero means no more content is available, for now or for good.
+ * @return Zero on success or non-zero to fail with HOJSON_ERROR_IO.
+ */
+typedef int (*hojson_read_t)(void* user_data, char* buffer, size_t buffer_length, size_t* bytes_read);
+
+/**
+ * Number of parsing states, those in which characters are processed, counted by instrumentation.
+ */
+#define HOJSON_STATE_COUNT 28
+
+/**
+ * Counters of the parser's hot paths, kept by a context given to hojson_set_stats() when hojson is compiled with
+ * HOJSON_INSTRUMENT defined. States are numbered from zero to HOJSON_STATE_COUNT - 1 and named by hojson_state_name().
+ */
+typedef struct {
+    /* Public */
+    uint64_t characters[HOJSON_STATE_COUNT]; /**< Characters processed in each state. */
+    uint64_t transitions[HOJSON_STATE_COUNT][HOJSON_STATE_COUNT]; /**< Changes of state, from the first index to the
+                                                                       second, seen between one character and the
+                                                                       next. */
+    uint64_t parses; /**< Calls to hojson_parse(). */
+    uint64_t resumes; /**< Calls that resumed after HOJSON_ERROR_UNEXPECTED_EOF, one per JSON content string. */
+    uint64_t stays; /**< Rewinds by one character, with hojson_stay(), to process a character again. */
+    uint64_t appends; /**< Characters and terminators appended to the buffer. */
+    uint64_t bytes_appended; /**< Bytes appended to the buffer. */
+
+    /* Private (for internal use) */
+    int8_t last_state; /* State in which the last character was processed */
+} hojson_stats_t;
+
+/**
+ * Events reported to a trace callback given to hojson_set_trace() when hojson is compiled with HOJSON_TRACE defined.
+ */
+typedef enum {
+    HOJSON_TRACE_CHARACTER = 0, /**< A character is about to be processed in the state. */
+    HOJSON_TRACE_STAY, /**< Parsing rewound by one character so it's processed again. */
+    HOJSON_TRACE_SUSPEND, /**< The content ran out in the state and HOJSON_ERROR_UNEXPECTED_EOF is returned. */
+    HOJSON_TRACE_RESUME /**< New content was given after HOJSON_ERROR_UNEXPECTED_EOF and parsing resumes. */
+} hojson_trace_event_t;
+
+/**
+ * A trace callback, called as events happen during parsing. It's called for every character so it should be quick,
+ * like writing to a ring buffer or firing a probe, and must not call hojson functions with the same context.
+ *
+ * @param user_data The pointer given to hojson_set_trace().
+ * @param event What happened.
+ * @param state The parsing state, from zero to HOJSON_STATE_COUNT - 1 and named by hojson_state_name().
+ * @param value The character's value (decoded code point) or zero for events other than HOJSON_TRACE_CHARACTER.
+ * @param offset Byte offset, in all content given so far, of the character or, for other events, of the next byte.
+ * @param line The line being parsed.
+ * @param column The column, on the line, of the character last parsed.
+ */
+typedef void (*hojson_trace_t)(void* user_data, hojson_trace_event_t event, uint32_t state, uint32_t value,
+    size_t offset, uint32_t line, uint32_t column);
+
 /**
  * Holds context and state information needed by hojson. Some of this information is public and holds the data parsed
  * from JSON content but some is private and only makes sense to hojson.
@@ -82,7 +170,8 @@ typedef enum _hojson_type_t {
 typedef struct {
     /* Public */
     char* name; /**< The name of a name-value pair. Assigned to null for values without names. */
-    char* string_value; /**< The value of a name-value pair or array for values whose type is HOJSON_TYPE_STRING. */
+    char* string_value; /**< The value of a name-value pair or array for values whose type is HOJSON_TYPE_STRING.
+                             For HOJSON_TYPE_INTEGER and HOJSON_TYPE_FLOAT, the number's ASCII text as it appeared. */
     long integer_value; /**< The value of a name-value pair or array for values whose type is HOJSON_TYPE_INTEGER. */
     double float_value; /**< The value of a name-value pair or array for values whose type is HOJSON_TYPE_FLOAT. */
     uint8_t bool_value; /**< The value of a name-value pair or array for values whose type is HOJSON_TYPE_BOOLEAN. */
@@ -90,14 +179,19 @@ typedef struct {
     uint32_t line; /**< The line currently being parsed. Lines are determined by line feeds and carriage returns. */
     uint32_t column; /**< The column, on the current line, of the character last parsed. */
     uint32_t depth; /**< The nested level of objects/arrays. Assigned with the level in which the element was found. */
+    size_t document_offset; /**< With multiple documents, the byte offset just past the last document to end. It's
+                                 counted from the start of the first JSON content string. */
 
     /* Private (for internal use) */
     uint8_t is_initialized; /* Set to true by hojson_init() and indicates this context is safe to use */
+    uint8_t is_multi_document; /* Set by hojson_set_multi_document(), parsing resumes after the root closes */
     const char* json; /* JSON content to be parsed */
     size_t json_length; /* Length of the JSON content to parse */
+    size_t json_offset; /* Number of bytes parsed from previous JSON content strings */
     uint8_t encoding; /* Character encoding of the JSON content */
     const char* iterator; /* Pointer to the character in the JSON content being parsed */
     size_t bytes_iterated; /* Number of bytes iterated with the last iteration */
+    size_t bytes_carried; /* Number of bytes of the last character that were carried over from a previous string */
     char* buffer; /* Memory allocated for hojson to use */
     size_t buffer_length; /* Amount of memory allocated for hojson */
     int8_t state; /* Current parsing state, determines which characters are acceptable and when to return */
@@ -107,6 +201,17 @@ typedef struct {
     uint32_t stream; /* Holds the current character, whole or partial. May contain bytes from different strings. */
     size_t stream_length; /* Length of the 'stream' variable in bytes */
     uint32_t newline_character; /* The character used to increment the 'line' variable, \r or \n */
+    hojson_read_t read; /* Callback set by hojson_set_reader() which hojson_pull() uses to fill the read buffer */
+    void* read_user_data; /* Passed to the read callback */
+    char* read_buffer; /* Two halves, one being parsed while the other is free to be filled */
+    size_t read_size; /* Length of each half of the read buffer */
+    size_t read_length; /* Number of bytes in the half being parsed or, if zero, that half has been parsed */
+    uint8_t read_half; /* Index of the half being parsed */
+    const char* feed; /* Bytes handed to hojson_feed() and not yet consumed by hojson_next() */
+    size_t feed_length; /* Length of the feed or zero if it's been consumed */
+    hojson_stats_t* stats; /* Counters given to hojson_set_stats(), kept with HOJSON_INSTRUMENT defined */
+    hojson_trace_t trace; /* Callback given to hojson_set_trace(), called with HOJSON_TRACE defined */
+    void* trace_user_data; /* Pointer passed back to the trace callback */
 } hojson_context_t;
 
 /**
@@ -131,12 +236,144 @@ HOJSON_DECL void hojson_init(hojson_context_t* context, char* buffer, const size
  */
 HOJSON_DECL void hojson_realloc(hojson_context_t* context, char* buffer, const size_t buffer_length);
 
+/**
+ * Instruct hojson to parse a stream of documents, such as newline-delimited JSON (JSON Lines), rather than one.
+ * When enabled, each time a root object or array closes, HOJSON_END_OF_DOCUMENT is returned with the offset of the
+ * document's end in the context's 'document_offset' and the next call to hojson_parse() continues with the next
+ * document, in the same JSON content string or a later one. Whitespace, including line breaks, may separate
+ * documents. The end of the stream is reported as HOJSON_ERROR_UNEXPECTED_EOF, as always, and no document is
+ * incomplete if HOJSON_END_OF_DOCUMENT was the last code before it.
+ *
+ * @param context An initialized hojson context object, before parsing begins.
+ * @param is_multi_document Non-zero to parse multiple documents or zero to stop after the first, the default.
+ */
+HOJSON_DECL void hojson_set_multi_document(hojson_context_t* context, uint8_t is_multi_document);
+
+/**
+ * Count characters, changes of state, and other hot paths of parsing as it happens. The counters are only kept if
+ * hojson is compiled with HOJSON_INSTRUMENT defined. Otherwise, the parser does no counting at all.
+ *
+ * @param context An initialized hojson context object.
+ * @param stats Counters to add to, zeroed by this function, or NULL to stop counting.
+ * @return HOJSON_NO_OP, or HOJSON_ERROR_INVALID_INPUT if hojson was compiled without HOJSON_INSTRUMENT.
+ */
+HOJSON_DECL hojson_code_t hojson_set_stats(hojson_context_t* context, hojson_stats_t* stats);
+
+/**
+ * Have a callback traced, as characters are processed and parsing suspends, rewinds, or resumes, to route traces into
+ * a tracer of one's own. The callback is only called if hojson is compiled with HOJSON_TRACE defined. Otherwise, the
+ * parser has no tracing at all.
+ *
+ * @param context An initialized hojson context object.
+ * @param trace The callback or NULL to stop tracing.
+ * @param user_data A pointer passed back to the callback.
+ * @return HOJSON_NO_OP, or HOJSON_ERROR_INVALID_INPUT if hojson was compiled without HOJSON_TRACE.
+ */
+HOJSON_DECL hojson_code_t hojson_set_trace(hojson_context_t* context, hojson_trace_t trace, void* user_data);
+
+/**
+ * The name of a parsing state counted by instrumentation or traced, such as "NAME_EXPECTED".
+ *
+ * @param state A state, from zero to HOJSON_STATE_COUNT - 1.
+ * @return The state's name or "UNKNOWN".
+ */
+HOJSON_DECL const char* hojson_state_name(uint32_t state);
+
+/**
+ * Have hojson read JSON content for itself, with hojson_pull(), rather than be handed it with hojson_parse().
+ * The read buffer is split in two halves. Each read fills one half while the parser is done with it, or hasn't yet
+ * begun, so names and values in the context's buffer are never disturbed and content read ahead isn't overwritten.
+ * Each read asks for, at most, half the read buffer's length so that length is the read size.
+ *
+ * @param context An initialized hojson context object, before parsing begins.
+ * @param read Callback that reads content into a buffer.
+ * @param user_data Pointer passed along to the read callback.
+ * @param read_buffer A pointer to some contiguous block of memory to read content into. It must outlive parsing.
+ * @param read_buffer_length The length, in bytes, of the read buffer. At least 2.
+ */
+HOJSON_DECL void hojson_set_reader(hojson_context_t* context, hojson_read_t read, void* user_data, char* read_buffer,
+    const size_t read_buffer_length);
+
+/**
+ * Begin or continue parsing content from the reader set with hojson_set_reader(). When the parser reaches the end of
+ * what has been read, the reader is called to fill the other half of the read buffer and parsing continues with it.
+ * Characters split between reads are handled here, so there's no HOJSON_ERROR_UNEXPECTED_EOF to recover from unless
+ * the reader has no more content. In that case, calling this again asks the reader again, so a reader of a
+ * non-blocking socket can report zero bytes and parsing resumes on a later call.
+ *
+ * @param context An initialized hojson context object with a reader.
+ * @return The same codes as hojson_parse(), or HOJSON_ERROR_IO if the reader failed.
+ */
+HOJSON_DECL hojson_code_t hojson_pull(hojson_context_t* context);
+
+/**
+ * Hand the parser the next bytes of content, such as those just received from a socket, to be parsed by hojson_next().
+ * The bytes are parsed where they are and must not be changed until hojson_next() returns
+ * HOJSON_ERROR_UNEXPECTED_EOF. By then, every byte has been consumed: names and values were copied into the context's
+ * buffer and the first bytes of a character split between feeds, at most three, are kept in the context. The memory
+ * belongs to the caller again and may be reused for the next feed.
+ *
+ * @param context An initialized hojson context object.
+ * @param bytes The next bytes of JSON content, which needn't begin or end on a token or character boundary.
+ * @param length Number of bytes.
+ * @return HOJSON_NO_OP, or HOJSON_ERROR_INVALID_INPUT if the previous feed has yet to be consumed.
+ */
+HOJSON_DECL hojson_code_t hojson_feed(hojson_context_t* context, const char* bytes, const size_t length);
+
+/**
+ * Begin or continue parsing the bytes handed to hojson_feed().
+ *
+ * @param context An initialized hojson context object.
+ * @return The same codes as hojson_parse(). HOJSON_ERROR_UNEXPECTED_EOF means the feed has been consumed, or there
+ *         was none, and parsing continues once there's another.
+ */
+HOJSON_DECL hojson_code_t hojson_next(hojson_context_t* context);
+
+/**
+ * Save the state of parsing between calls to hojson_parse() so it may be restored later, by another context, thread,
+ * or process, with hojson_restore(). The checkpoint holds the parser's state, its position in the document, and the
+ * used portion of the buffer with pointers stored as offsets so it's only as large as the nodes on the stack. It's
+ * taken along with the input offset, the number of bytes of content consumed, from which parsing is to resume.
+ * The read callback and any unconsumed feed aren't saved. The checkpoint may only be restored by a build of hojson
+ * with the same pointer size and structure layout.
+ *
+ * @param context An initialized hojson context object.
+ * @param blob Memory to hold the checkpoint. May be null to learn its length.
+ * @param blob_length The length, in bytes, of the blob.
+ * @param checkpoint_length Assigned the length, in bytes, of the checkpoint. If the blob is too short, this is the
+ *                          length needed.
+ * @param input_offset Assigned the offset, counted from the first byte of the first JSON content string, of the first
+ *                     byte yet to be consumed. May be null.
+ * @return HOJSON_NO_OP, HOJSON_ERROR_INSUFFICIENT_MEMORY if the blob is null or too short, or
+ *         HOJSON_ERROR_INVALID_INPUT.
+ */
+HOJSON_DECL hojson_code_t hojson_checkpoint(const hojson_context_t* context, char* blob, const size_t blob_length,
+    size_t* checkpoint_length, size_t* input_offset);
+
+/**
+ * Set up the hojson context object to continue parsing from a checkpoint made by hojson_checkpoint(). Following this,
+ * call hojson_parse() with the content beginning at the input offset. The name and string value of the context, if
+ * any, are restored as well.
+ *
+ * @param context Pointer to an allocated hojson context object. This instance will be modified.
+ * @param buffer A pointer to some contiguous block of memory for hojson to use. It may be shorter than the original.
+ * @param buffer_length The length, in bytes, of the buffer.
+ * @param blob The checkpoint.
+ * @param blob_length The length, in bytes, of the checkpoint.
+ * @param input_offset Assigned the offset of the first byte of content to be parsed next. May be null.
+ * @return HOJSON_NO_OP, HOJSON_ERROR_INSUFFICIENT_MEMORY if the buffer can't hold the checkpoint's used portion, or
+ *         HOJSON_ERROR_INVALID_INPUT if the checkpoint is malformed or was made by an incompatible build.
+ */
+HOJSON_DECL hojson_code_t hojson_restore(hojson_context_t* context, char* buffer, const size_t buffer_length,
+    const char* blob, const size_t blob_length, size_t* input_offset);
+
 /**
  * Begin or continue parsing the given JSON content string.
  * The JSON content string does not need to contain the content in its entirety. If hojson finds a null terminator or
  * parses up to the indicated length of the content, HOJSON_ERROR_UNEXPECTED_EOF is returned and parsing will cease.
  * However, this error is recoverable and parsing will continue if the next call to hojson_parse() passes a new JSON
- * content string, using the same pointer or not.
+ * content string, using the same pointer or not. Either way, the string is taken to be new: the previous one was
+ * consumed in its entirety, with the first bytes of any character split between the two kept in the context.
  *
  * @param context An initialized hojson context object. This should be treated as read-only until parsing is done.
  * @param json JSON content as a string.
@@ -145,6 +382,244 @@ HOJSON_DECL void hojson_realloc(hojson_context_t* context, char* buffer, const s
  */
 HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* json, const size_t json_length);
 
+/**
+ * The length, in bytes, of a string large enough to hold any double formatted by hojson_format_double() including
+ * its null terminator.
+ */
+#define HOJSON_FORMAT_DOUBLE_LENGTH 32
+
+/**
+ * Format a double as the shortest string of decimal digits that reads back as exactly the same value. The string
+ * looks like JavaScript's number-to-string conversion: "0.1", "3", "1e+21", "1.5e-7". NaN and the infinities are
+ * formatted as "NaN", "Infinity", and "-Infinity" although JSON has no representation of them.
+ *
+ * @param value The value to format.
+ * @param str Memory for the formatted, null-terminated string, at least HOJSON_FORMAT_DOUBLE_LENGTH bytes long.
+ * @return Length of the formatted string in bytes, not including the null terminator.
+ */
+HOJSON_DECL size_t hojson_format_double(double value, char* str);
+
+/**
+ * Called by the writer when its buffer is full, or when hojson_write_flush() is called, to hand off written content.
+ *
+ * @param user_data The pointer given to hojson_writer_init().
+ * @param data Written JSON content. This is the writer's buffer and is reused once the callback returns.
+ * @param length Length of the written content in bytes.
+ * @return Zero if the content was consumed or non-zero to halt writing with HOJSON_ERROR_IO.
+ */
+typedef int (*hojson_flush_t)(void* user_data, const char* data, size_t length);
+
+/**
+ * Holds state information needed by hojson to write JSON content. All of it is private except for 'depth'.
+ */
+typedef struct {
+    /* Public */
+    uint32_t depth; /**< The nested level of objects/arrays currently open. */
+
+    /* Private (for internal use) */
+    uint8_t is_initialized; /* Set to true by hojson_writer_init() and indicates this writer is safe to use */
+    uint8_t encoding; /* Character encoding of the written content */
+    char* buffer; /* Memory in which written content is collected before being flushed */
+    size_t buffer_length; /* Amount of memory allocated for the writer */
+    size_t buffer_used; /* Number of bytes of written content currently in the buffer */
+    hojson_flush_t flush; /* Callback receiving the contents of the buffer, may be NULL */
+    void* user_data; /* Passed to the flush callback */
+    int8_t state; /* Whether the document is open, done, or the writer is in an error state */
+    uint8_t needs_comma; /* A value was written at the current depth and a comma must precede the next one */
+    uint8_t nesting[(HOJSON_WRITER_MAX_DEPTH + 7) / 8]; /* One bit per depth, set if the level is an array */
+} hojson_writer_t;
+
+/**
+ * Sets up the hojson writer object to begin writing. Content is collected in the buffer and handed to the flush
+ * callback whenever the buffer fills. Without a callback, the entire document must fit within the buffer.
+ *
+ * @param writer Pointer to an allocated hojson writer object. This instance will be modified.
+ * @param buffer A pointer to some contiguous block of memory for the writer to use.
+ * @param buffer_length The length, in bytes, of the buffer handed to the writer as the 'buffer' parameter.
+ * @param encoding Character encoding of the written content. UTF-16 content begins with a byte order marker.
+ * @param flush Callback receiving written content, or NULL.
+ * @param user_data Pointer passed along to the flush callback.
+ */
+HOJSON_DECL void hojson_writer_init(hojson_writer_t* writer, char* buffer, const size_t buffer_length,
+    hojson_encoding_t encoding, hojson_flush_t flush, void* user_data);
+
+/**
+ * Begin or end an object or array. Names are required within objects and must be NULL otherwise.
+ * Names and string values are expected to be UTF-8 and are converted to the writer's encoding. A name or value that
+ * isn't well-formed UTF-8 fails with HOJSON_ERROR_INVALID_INPUT. Part of it may have been written by then so every
+ * call after it fails the same way.
+ *
+ * @param writer An initialized hojson writer object.
+ * @param name The name of the object or array, or NULL.
+ * @return HOJSON_NO_OP on success, HOJSON_END_OF_DOCUMENT once the root closes, or an error.
+ */
+HOJSON_DECL hojson_code_t hojson_write_object_begin(hojson_writer_t* writer, const char* name);
+HOJSON_DECL hojson_code_t hojson_write_object_end(hojson_writer_t* writer);
+HOJSON_DECL hojson_code_t hojson_write_array_begin(hojson_writer_t* writer, const char* name);
+HOJSON_DECL hojson_code_t hojson_write_array_end(hojson_writer_t* writer);
+
+/**
+ * Write a name-value pair, or an array value if the name is NULL. Floating-point values must be finite.
+ *
+ * @param writer An initialized hojson writer object.
+ * @param name The name of the value, or NULL within arrays.
+ * @param value The value to write.
+ * @return HOJSON_NO_OP on success or an error.
+ */
+HOJSON_DECL hojson_code_t hojson_write_string(hojson_writer_t* writer, const char* name, const char* value);
+HOJSON_DECL hojson_code_t hojson_write_integer(hojson_writer_t* writer, const char* name, long value);
+HOJSON_DECL hojson_code_t hojson_write_float(hojson_writer_t* writer, const char* name, double value);
+HOJSON_DECL hojson_code_t hojson_write_boolean(hojson_writer_t* writer, const char* name, uint8_t value);
+HOJSON_DECL hojson_code_t hojson_write_null(hojson_writer_t* writer, const char* name);
+
+/**
+ * Hand any content remaining in the writer's buffer to the flush callback.
+ *
+ * @param writer An initialized hojson writer object.
+ * @return HOJSON_NO_OP on success or an error.
+ */
+HOJSON_DECL hojson_code_t hojson_write_flush(hojson_writer_t* writer);
+
+/**
+ * Holds state information needed by hojson to validate JSON content without parsing its values.
+ */
+typedef struct {
+    /* Public */
+    uint32_t depth; /**< The nested level of objects/arrays currently open. */
+    uint32_t max_depth; /**< The deepest nesting seen so far where a root object or array alone has a depth of one. */
+    size_t offset; /**< Bytes validated so far or, following an error, the offset of the offending character. */
+
+    /* Private (for internal use) */
+    uint8_t is_initialized; /* Set to true by hojson_validator_init() and indicates this validator is safe to use */
+    uint8_t encoding; /* Character encoding of the JSON content */
+    int8_t state; /* Current validation state, uses the same states as parsing */
+    int8_t escape_return_state; /* State to return to after processing an escape */
+    uint8_t flags; /* Bit flags of the current object/array, uses the same flags as parsing */
+    char carry[3]; /* The first bytes of a UTF-8 or UTF-16 character split between two content strings */
+    uint8_t carry_length; /* The number of bytes held in 'carry' */
+    char* stack; /* One bit per nested level, set if the level is an array */
+    size_t stack_length; /* Length of the stack memory in bytes */
+    hojson_writer_t* output; /* If reformatting, the writer validated content is copied to */
+    uint8_t indent; /* If reformatting, the number of spaces per level of nesting or zero to minify */
+    uint8_t pending_newline; /* An object/array began and, unless it's empty, a line break must follow */
+} hojson_validator_t;
+
+/**
+ * Validate an entire JSON document without materializing any of its names or values. Content is checked by the same
+ * rules as hojson_parse(), decoding included. Documents nested deeper than 1024 levels require hojson_validate_chunk().
+ *
+ * @param json JSON content as a string.
+ * @param json_length Length of the JSON content in bytes.
+ * @param max_depth If not NULL, assigned the deepest nesting of objects/arrays where the root alone is one.
+ * @return HOJSON_END_OF_DOCUMENT if the document is valid or an error. HOJSON_ERROR_UNEXPECTED_EOF means the
+ *         content ended before the root object or array closed.
+ */
+HOJSON_DECL hojson_code_t hojson_validate(const char* json, const size_t json_length, uint32_t* max_depth);
+
+/**
+ * Sets up the hojson validator object to begin validating content passed, in parts, to hojson_validate_chunk().
+ *
+ * @param validator Pointer to an allocated hojson validator object. This instance will be modified.
+ * @param buffer Memory to track nesting with, one bit per level. Eight levels fit in each byte.
+ * @param buffer_length The length, in bytes, of the buffer handed to hojson as the 'buffer' parameter.
+ */
+HOJSON_DECL void hojson_validator_init(hojson_validator_t* validator, char* buffer, const size_t buffer_length);
+
+/**
+ * Validate the given part of a JSON document. Parts must be passed contiguously, beginning with the start of the
+ * document. Every byte of a part is examined before returning so the part's memory may be reused afterward.
+ *
+ * @param validator An initialized hojson validator object.
+ * @param json JSON content as a string.
+ * @param json_length Length of the JSON content in bytes.
+ * @return HOJSON_END_OF_DOCUMENT once the root closes, HOJSON_ERROR_UNEXPECTED_EOF if more content is needed, or
+ *         another error. HOJSON_ERROR_INSUFFICIENT_MEMORY means the document is nested too deeply for the buffer
+ *         and, unlike with hojson_parse(), can't be recovered from.
+ */
+HOJSON_DECL hojson_code_t hojson_validate_chunk(hojson_validator_t* validator, const char* json,
+    const size_t json_length);
+
+/**
+ * Sets up the hojson validator object to reformat content passed, in parts, to hojson_reformat_chunk(). Content is
+ * validated as it is with hojson_validate_chunk() and copied to the writer without whitespace (minified) or with
+ * line breaks and indentation (pretty-printed). Names, strings, and numbers are copied byte for byte.
+ *
+ * @param validator Pointer to an allocated hojson validator object. This instance will be modified.
+ * @param buffer Memory to track nesting with, one bit per level. Eight levels fit in each byte.
+ * @param buffer_length The length, in bytes, of the buffer handed to hojson as the 'buffer' parameter.
+ * @param writer An initialized hojson writer object to write reformatted content to. Its encoding will be changed
+ *               to the encoding of the content. No other writing functions should be called with it.
+ * @param indent Number of spaces per level of nesting when pretty-printing, or zero to minify.
+ */
+HOJSON_DECL void hojson_reformatter_init(hojson_validator_t* validator, char* buffer, const size_t buffer_length,
+    hojson_writer_t* writer, uint8_t indent);
+
+/**
+ * Validate and reformat the given part of a JSON document. Parts must be passed contiguously, beginning with the
+ * start of the document. Call hojson_write_flush() on the writer once the document has ended.
+ *
+ * @param validator A hojson validator object initialized with hojson_reformatter_init().
+ * @param json JSON content as a string.
+ * @param json_length Length of the JSON content in bytes.
+ * @return The same codes as hojson_validate_chunk() or an error from the writer.
+ */
+HOJSON_DECL hojson_code_t hojson_reformat_chunk(hojson_validator_t* validator, const char* json,
+    const size_t json_length);
+
+/**
+ * Called by the splitter each time an element of the root array closes.
+ *
+ * @param user_data The pointer given to hojson_split_array().
+ * @param begin Offset of the element's first byte, counted from the first byte of the first part of the content.
+ * @param end Offset of the byte following the element's last byte. Whitespace around the element is excluded.
+ * @return Zero to continue or non-zero to halt splitting with HOJSON_ERROR_IO.
+ */
+typedef int (*hojson_element_t)(void* user_data, size_t begin, size_t end);
+
+/**
+ * Holds state information needed by hojson to find the elements of a root array. Only 'offset' and 'element_count'
+ * are public.
+ */
+typedef struct {
+    /* Public */
+    size_t offset; /**< Number of bytes examined. On error, the offset of the offending character. */
+    size_t element_count; /**< Number of elements found so far. */
+
+    /* Private (for internal use) */
+    uint8_t is_initialized; /* Set to true by hojson_splitter_init() and indicates this splitter is safe to use */
+    int8_t state; /* Current state, in or out of a string or the root array */
+    uint32_t depth; /* Number of objects and arrays open, including the root array */
+    uint8_t has_element; /* Set once the current element's first byte has been found */
+    size_t element_begin; /* Offset of the current element's first byte */
+    size_t element_end; /* Offset of the byte following the current element's last non-whitespace byte */
+} hojson_splitter_t;
+
+/**
+ * Sets up the hojson splitter object to find the elements of a root array passed, in parts, to hojson_split_array().
+ *
+ * @param splitter Pointer to an allocated hojson splitter object. This instance will be modified.
+ */
+HOJSON_DECL void hojson_splitter_init(hojson_splitter_t* splitter);
+
+/**
+ * Find the elements of the root array in the given part of a document, reporting each as soon as it closes. Only
+ * brackets, braces, and strings are followed so this is far faster than parsing but checks little more than the
+ * shape of the root array. Each element can then be given to hojson_parse(), hojson_validate(), or a thread that
+ * does so. Parts must be passed contiguously, beginning with the start of the document, and all of each part is
+ * examined before returning.
+ *
+ * @param splitter An initialized hojson splitter object.
+ * @param json JSON content as a string, UTF-8.
+ * @param json_length Length of the JSON content in bytes.
+ * @param callback Called with the offsets of each element as soon as it closes.
+ * @param user_data Passed to the callback.
+ * @return HOJSON_END_OF_DOCUMENT once the root array closes, HOJSON_ERROR_UNEXPECTED_EOF if more content is needed,
+ *         HOJSON_ERROR_SYNTAX if the root isn't an array or an element is missing, or HOJSON_ERROR_IO if the callback
+ *         halted splitting.
+ */
+HOJSON_DECL hojson_code_t hojson_split_array(hojson_splitter_t* splitter, const char* json, const size_t json_length,
+    hojson_element_t callback, void* user_data);
+
 #ifdef __cplusplus
     }
 #endif /* __cplusplus */
@@ -159,7 +634,14 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
 /******************/
 /* Implementation */
 
+#if !defined(HOJSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h> /* _mm_loadu_si128(), _mm_cmpeq_epi8(), _mm_max_epu8(), _mm_movemask_epi8() */
+    #define HOJSON_SSE2
+#endif
+
 enum {
+    HOJSON_STATE_ERROR_IO = -7,
+    HOJSON_STATE_ERROR_INVALID_INPUT = -6,
     HOJSON_STATE_ERROR_INTERNAL = -5,
     HOJSON_STATE_ERROR_INSUFFICIENT_MEMORY = -4,
     HOJSON_STATE_ERROR_UNEXPECTED_EOF = -3,
@@ -208,13 +690,6 @@ enum {
     HOJSON_FLAG_DECREMENT_DEPTH = 512 /* context object's depth value should decrease by one netx hojson_parse() */
 };
 
-enum {
-    HOJSON_ENCODING_UNKNOWN = 0, /* The character encoding is unknown. UTF-8 is assumed. */
-    HOJSON_ENCODING_UTF_8, /* Variable-length encoding (8, 16, 24, or 32 bits) compatible with ASCII */
-    HOJSON_ENCODING_UTF_16_LE, /* Variable-length encoding (16 or 32 bits), little-endian variant */
-    HOJSON_ENCODING_UTF_16_BE /* Variable-lenght encoding (16 or 32 bits), big-endian variant */
-};
-
 typedef struct _hojson_node_t hojson_node_t;
 typedef struct _hojson_node_t {
     hojson_node_t* parent; /* Points to the parent node, or NULL if this is the root */
@@ -223,12 +698,47 @@ typedef struct _hojson_node_t {
     char data; /* Where characters will be stored in the buffer, must be defined last */
 } hojson_node_t;
 
+/* Begins every checkpoint and is followed by the used portion of the buffer, whose nodes hold offsets, from the */
+/* beginning of the buffer, in place of pointers */
+typedef struct _hojson_checkpoint_t {
+    uint32_t magic; /* HOJSON_CHECKPOINT_MAGIC, which also guards against the checkpoint having another byte order */
+    uint16_t header_length; /* Length of this structure, which guards against another structure layout */
+    uint8_t pointer_length; /* Length of a pointer, which guards against another pointer size */
+    uint8_t is_multi_document; /* Copied from the context */
+    uint8_t encoding; /* Copied from the context */
+    int8_t state; /* Copied from the context */
+    int8_t escape_return_state; /* Copied from the context */
+    int8_t error_return_state; /* Copied from the context */
+    uint8_t bool_value; /* Copied from the context */
+    uint8_t value_type; /* Copied from the context */
+    uint32_t line; /* Copied from the context */
+    uint32_t column; /* Copied from the context */
+    uint32_t depth; /* Copied from the context */
+    uint32_t stream; /* Copied from the context */
+    uint32_t newline_character; /* Copied from the context */
+    size_t stream_length; /* Copied from the context */
+    size_t document_offset; /* Copied from the context */
+    size_t input_offset; /* Number of bytes of content consumed, where parsing resumes */
+    size_t used_length; /* Number of bytes of the buffer that follow */
+    size_t stack; /* Offset of the stack's current node plus one, or zero if there's no stack */
+    size_t name; /* Offset of the context's name plus one, or zero if null */
+    size_t string_value; /* Offset of the context's string value plus one, or zero if null */
+    long integer_value; /* Copied from the context */
+    double float_value; /* Copied from the context */
+} hojson_checkpoint_t;
+
 typedef struct _hojson_character_t {
     uint32_t raw; /* Character as it appeared in the content. In other words, the original, encoded character. */
     uint32_t value; /* Unicode value of the character. In other words, the decoded character. */
     size_t bytes; /* Number of eight-bit bytes of the encoded character, in the [1, 4] range */
 } hojson_character_t;
 
+/* The characters of every two-digit number, 00 through 99, for formatting numbers two digits at a time */
+static const char hojson_digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
 #ifndef UINT32_MAX /* Defined in stdint.h with later revisions of C and C++ but not for some earlier ones */
     #define UINT32_MAX (0xffffffff)
 #endif
@@ -239,23 +749,71 @@ typedef struct _hojson_character_t {
 #define HOJSON_IS_NUMERIC(c) (c >= '0' && c <= '9')
 #define HOJSON_IS_HEX_CHAR(c) (HOJSON_IS_NUMERIC(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
 #define HOJSON_MAXIMUM(a,b) (a >= b ? a : b)
-#ifdef HOJSON_DEBUG
-    #include <stdio.h> /* printf() */
-    #define HOJSON_LOG_STATE(s) printf("%s\n", s);
+#define HOJSON_ALIGN(offset) (((offset) + sizeof(void*) - 1) & ~(sizeof(void*) - 1)) /* Round up to a pointer's */
+#define HOJSON_CHECKPOINT_MAGIC (0x434a4f48) /* "HOJC" when stored little-endian */
+#ifdef HOJSON_INSTRUMENT
+    #define HOJSON_COUNT(counter, n) if (context->stats != NULL) context->stats->counter += n;
+#else
+    #define HOJSON_COUNT(counter, n)
+#endif
+#ifdef HOJSON_TRACE
+    #define HOJSON_TRACE_EVENT(event, value, offset) if (context->trace != NULL) context->trace( \
+        context->trace_user_data, event, (uint32_t)context->state, value, offset, context->line, context->column);
+#else
+    #define HOJSON_TRACE_EVENT(event, value, offset)
+#endif
+/* The parser decodes and encodes through these so, when only UTF-8 is wanted, there's no encoding to dispatch on */
+#ifdef HOJSON_UTF8_ONLY
+    #define HOJSON_DECODE(context, str, str_length) hojson_decode_byte(str, str_length)
+    #define HOJSON_ENCODE(context, value) hojson_encode_utf8(value)
+    #define HOJSON_IS_UTF16(context) 0
+    #define HOJSON_DECODES_UTF8(context) 0 /* UTF-8 is taken a byte at a time, as it is without a BOM */
 #else
-    #define HOJSON_LOG_STATE(s)
+    #define HOJSON_DECODE(context, str, str_length) ((context)->encoding == HOJSON_ENCODING_UNKNOWN ? \
+        hojson_decode_byte(str, str_length) : (context)->encoding == HOJSON_ENCODING_UTF_8 ? \
+        hojson_decode_utf8(str, str_length) : \
+        (context)->encoding == HOJSON_ENCODING_UTF_16_BE ? hojson_decode_utf16(str, str_length, 1) : \
+        hojson_decode_utf16(str, str_length, 0))
+    #define HOJSON_ENCODE(context, value) (HOJSON_IS_UTF16(context) ? \
+        hojson_encode_utf16(value, (context)->encoding == HOJSON_ENCODING_UTF_16_BE) : hojson_encode_utf8(value))
+    #define HOJSON_IS_UTF16(context) ((context)->encoding >= HOJSON_ENCODING_UTF_16_LE)
+    #define HOJSON_DECODES_UTF8(context) ((context)->encoding == HOJSON_ENCODING_UTF_8)
 #endif
 
 void hojson_stay(hojson_context_t* context);
 void hojson_push_stack(hojson_context_t* context);
 void hojson_pop_stack(hojson_context_t* context);
 hojson_code_t hojson_append_character(hojson_context_t* context, hojson_character_t c);
+hojson_code_t hojson_append_number_character(hojson_context_t* context, hojson_character_t c);
 hojson_code_t hojson_append_terminator(hojson_context_t* context);
 hojson_code_t hojson_begin_token(hojson_context_t* context, char token);
 hojson_code_t hojson_end_token(hojson_context_t* context, char token);
+size_t hojson_used_length(const hojson_context_t* context);
+hojson_character_t hojson_decode_byte(const char* str, size_t str_length);
+hojson_character_t hojson_decode_utf8(const char* str, size_t str_length);
+hojson_character_t hojson_decode_utf16(const char* str, size_t str_length, uint8_t is_big_endian);
 hojson_character_t hojson_decode_character(const char* str, size_t str_length, uint8_t encoding);
+hojson_character_t hojson_encode_utf8(uint32_t value);
+hojson_character_t hojson_encode_utf16(uint32_t value, uint8_t is_big_endian);
 hojson_character_t hojson_encode_character(uint32_t value, uint8_t encoding);
 uint32_t hojson_hex_character_to_decimal(uint32_t value);
+hojson_code_t hojson_writer_put(hojson_writer_t* writer, const char* data, size_t length);
+hojson_code_t hojson_writer_put_ascii(hojson_writer_t* writer, const char* str, size_t str_length);
+hojson_code_t hojson_writer_put_string(hojson_writer_t* writer, const char* str, size_t str_length);
+hojson_code_t hojson_writer_begin_value(hojson_writer_t* writer, const char* name, uint8_t is_container);
+hojson_code_t hojson_writer_end_container(hojson_writer_t* writer, uint8_t is_array);
+hojson_code_t hojson_writer_error(hojson_writer_t* writer);
+size_t hojson_format_integer(long value, char* str);
+uint64_t hojson_shortest_digits(uint64_t mantissa, int32_t exponent, int32_t* decimal_exponent);
+uint64_t hojson_multiply_shift(uint64_t m, int32_t power, uint8_t is_inverse, int32_t shift);
+uint32_t hojson_factors_of_five(uint64_t value);
+size_t hojson_escape_free_length(const char* str, size_t str_length);
+size_t hojson_utf8_length(const char* str, size_t str_length);
+size_t hojson_string_length(const char* str, size_t str_length, uint8_t is_ascii);
+hojson_code_t hojson_validator_error(hojson_validator_t* validator);
+hojson_code_t hojson_scan_write(hojson_validator_t* validator, const char** run, const char* at);
+hojson_code_t hojson_scan_indent(hojson_validator_t* validator, uint32_t depth);
+hojson_code_t hojson_splitter_error(hojson_splitter_t* splitter);
 
 HOJSON_DECL void hojson_init(hojson_context_t* context, char* buffer, const size_t buffer_length) {
     if (context == NULL || buffer == NULL || buffer_length <= 0)
@@ -304,12 +862,278 @@ HOJSON_DECL void hojson_realloc(hojson_context_t* context, char* buffer, const s
     }
 }
 
+HOJSON_DECL void hojson_set_multi_document(hojson_context_t* context, uint8_t is_multi_document) {
+    if (context == NULL || context->is_initialized == 0)
+        return;
+
+    context->is_multi_document = is_multi_document != 0;
+}
+
+HOJSON_DECL hojson_code_t hojson_set_stats(hojson_context_t* context, hojson_stats_t* stats) {
+#ifdef HOJSON_INSTRUMENT
+    if (context == NULL || context->is_initialized == 0)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(hojson_stats_t));
+        stats->last_state = context->state >= HOJSON_STATE_NONE && context->state <= HOJSON_STATE_DONE ?
+            context->state : (int8_t)HOJSON_STATE_NONE;
+    }
+    context->stats = stats;
+    return HOJSON_NO_OP;
+#else
+    (void)context;
+    (void)stats;
+    return HOJSON_ERROR_INVALID_INPUT; /* There's no counting to do */
+#endif /* HOJSON_INSTRUMENT */
+}
+
+HOJSON_DECL hojson_code_t hojson_set_trace(hojson_context_t* context, hojson_trace_t trace, void* user_data) {
+#ifdef HOJSON_TRACE
+    if (context == NULL || context->is_initialized == 0)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    context->trace = trace;
+    context->trace_user_data = trace == NULL ? NULL : user_data;
+    return HOJSON_NO_OP;
+#else
+    (void)context;
+    (void)trace;
+    (void)user_data;
+    return HOJSON_ERROR_INVALID_INPUT; /* There's no tracing to do */
+#endif /* HOJSON_TRACE */
+}
+
+HOJSON_DECL const char* hojson_state_name(uint32_t state) {
+    static const char* names[HOJSON_STATE_COUNT] = { "NONE", "UTF8_BOM1", "UTF8_BOM2", "UTF16BE_BOM", "UTF16LE_BOM",
+        "NAME_EXPECTED", "NAME", "POST_NAME", "VALUE_EXPECTED", "STRING_VALUE", "ESCAPE", "UNICODE_1", "UNICODE_2",
+        "UNICODE_3", "UNICODE_4", "NUMBER_VALUE", "TRUE_VALUE_T", "TRUE_VALUE_R", "TRUE_VALUE_U", "FALSE_VALUE_F",
+        "FALSE_VALUE_A", "FALSE_VALUE_L", "FALSE_VALUE_S", "NULL_VALUE_N", "NULL_VALUE_U", "NULL_VALUE_L",
+        "POST_VALUE", "DONE" };
+    return state < HOJSON_STATE_COUNT ? names[state] : "UNKNOWN";
+}
+
+HOJSON_DECL void hojson_set_reader(hojson_context_t* context, hojson_read_t read, void* user_data, char* read_buffer,
+        const size_t read_buffer_length) {
+    if (context == NULL || context->is_initialized == 0 || read == NULL || read_buffer == NULL ||
+            read_buffer_length < 2)
+        return;
+
+    context->read = read;
+    context->read_user_data = user_data;
+    context->read_buffer = read_buffer;
+    context->read_size = read_buffer_length / 2;
+    context->read_length = 0;
+    context->read_half = 0;
+}
+
+HOJSON_DECL hojson_code_t hojson_pull(hojson_context_t* context) {
+    if (context == NULL || context->is_initialized == 0 || context->read == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    while (1) {
+        size_t bytes_read = 0;
+        if (context->read_length > 0) { /* If there's content in the current half that hasn't been parsed */
+            hojson_code_t code = hojson_parse(context, context->read_buffer + context->read_half * context->read_size,
+                context->read_length);
+            if (code != HOJSON_ERROR_UNEXPECTED_EOF)
+                return code;
+            context->read_length = 0; /* Every byte of it has been consumed */
+        }
+
+        /* The parser has no use for the current half anymore so read into, and parse, the other */
+        if (context->read(context->read_user_data, context->read_buffer + (context->read_half ^ 1) *
+                context->read_size, context->read_size, &bytes_read) != 0)
+            return HOJSON_ERROR_IO;
+        else if (bytes_read == 0) /* If nothing more is available, at least not yet */
+            return HOJSON_ERROR_UNEXPECTED_EOF;
+        else if (bytes_read > context->read_size)
+            return HOJSON_ERROR_INVALID_INPUT;
+        context->read_half ^= 1;
+        context->read_length = bytes_read;
+    }
+}
+
+HOJSON_DECL hojson_code_t hojson_feed(hojson_context_t* context, const char* bytes, const size_t length) {
+    if (context == NULL || context->is_initialized == 0 || (bytes == NULL && length > 0))
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (context->feed_length > 0) /* If the previous feed has yet to be consumed */
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    context->feed = bytes;
+    context->feed_length = length;
+    return HOJSON_NO_OP;
+}
+
+HOJSON_DECL hojson_code_t hojson_next(hojson_context_t* context) {
+    if (context == NULL || context->is_initialized == 0)
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (context->feed_length == 0) /* If there's nothing to parse until the next feed */
+        return context->state == HOJSON_STATE_DONE ? HOJSON_END_OF_DOCUMENT : HOJSON_ERROR_UNEXPECTED_EOF;
+
+    hojson_code_t code = hojson_parse(context, context->feed, context->feed_length);
+    if (code == HOJSON_ERROR_UNEXPECTED_EOF) { /* The feed has been consumed and belongs to the caller again */
+        context->feed = NULL;
+        context->feed_length = 0;
+    }
+    return code;
+}
+
+HOJSON_DECL hojson_code_t hojson_checkpoint(const hojson_context_t* context, char* blob, const size_t blob_length,
+        size_t* checkpoint_length, size_t* input_offset) {
+    if (context == NULL || context->is_initialized == 0 || checkpoint_length == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (sizeof(size_t) != sizeof(char*)) /* Offsets take the place of pointers so they must be the same size */
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_checkpoint_t header;
+    memset(&header, 0, sizeof(hojson_checkpoint_t));
+    header.used_length = hojson_used_length(context);
+    header.input_offset = context->json_offset;
+    if (context->json != NULL) /* The current string was consumed up to the iterator */
+        header.input_offset += (size_t)(context->iterator - context->json);
+    *checkpoint_length = sizeof(hojson_checkpoint_t) + header.used_length;
+    if (input_offset != NULL)
+        *input_offset = header.input_offset;
+    if (blob == NULL || blob_length < *checkpoint_length)
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+
+    header.magic = HOJSON_CHECKPOINT_MAGIC;
+    header.header_length = (uint16_t)sizeof(hojson_checkpoint_t);
+    header.pointer_length = (uint8_t)sizeof(char*);
+    header.is_multi_document = context->is_multi_document;
+    header.encoding = context->encoding;
+    header.state = context->state;
+    header.escape_return_state = context->escape_return_state;
+    header.error_return_state = context->error_return_state;
+    header.bool_value = context->bool_value;
+    header.value_type = (uint8_t)context->value_type;
+    header.line = context->line;
+    header.column = context->column;
+    header.depth = context->depth;
+    header.stream = context->stream;
+    header.newline_character = context->newline_character;
+    header.stream_length = context->stream_length;
+    header.document_offset = context->document_offset;
+    header.integer_value = context->integer_value;
+    header.float_value = context->float_value;
+    if (context->stack != NULL)
+        header.stack = (size_t)(context->stack - context->buffer) + 1;
+    /* The name and string value are within the used portion of the buffer, or just past it for a string yet to have */
+    /* its first character appended, unless they're stale, left pointing at a popped node's erased memory, in which */
+    /* case they're as good as null */
+    if (context->name != NULL && (size_t)(context->name - context->buffer) <= header.used_length)
+        header.name = (size_t)(context->name - context->buffer) + 1;
+    if (context->string_value != NULL && (size_t)(context->string_value - context->buffer) <= header.used_length)
+        header.string_value = (size_t)(context->string_value - context->buffer) + 1;
+    memcpy(blob, &header, sizeof(hojson_checkpoint_t));
+    memcpy(blob + sizeof(hojson_checkpoint_t), context->buffer, header.used_length);
+
+    /* Within the copy, replace the end and parent pointers of each node with offsets, beginning at the tail and */
+    /* iterating to the head. Nodes may be unaligned so the offsets are copied byte by byte. */
+    hojson_node_t* node = HOJSON_STACK;
+    while (node != NULL) {
+        char* copy = blob + sizeof(hojson_checkpoint_t) + ((char*)node - context->buffer);
+        size_t end = (size_t)(node->end - context->buffer);
+        size_t parent = node->parent == NULL ? 0 : (size_t)((char*)node->parent - context->buffer) + 1;
+        memcpy(copy + offsetof(hojson_node_t, end), &end, sizeof(size_t));
+        memcpy(copy + offsetof(hojson_node_t, parent), &parent, sizeof(size_t));
+        node = node->parent;
+    }
+    return HOJSON_NO_OP;
+}
+
+HOJSON_DECL hojson_code_t hojson_restore(hojson_context_t* context, char* buffer, const size_t buffer_length,
+        const char* blob, const size_t blob_length, size_t* input_offset) {
+    if (context == NULL || buffer == NULL || buffer_length <= 0 || blob == NULL ||
+            blob_length < sizeof(hojson_checkpoint_t))
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_checkpoint_t header;
+    memcpy(&header, blob, sizeof(hojson_checkpoint_t));
+    if (header.magic != HOJSON_CHECKPOINT_MAGIC || header.header_length != sizeof(hojson_checkpoint_t) ||
+            header.pointer_length != sizeof(char*) || sizeof(size_t) != sizeof(char*))
+        return HOJSON_ERROR_INVALID_INPUT; /* Made by an incompatible build, or not a checkpoint at all */
+    else if (blob_length < sizeof(hojson_checkpoint_t) + header.used_length || header.stream_length > 4 ||
+            header.state < HOJSON_STATE_ERROR_IO || header.state > HOJSON_STATE_DONE ||
+            header.encoding > HOJSON_ENCODING_UTF_16_BE || header.name > header.used_length + 1 ||
+            header.string_value > header.used_length + 1 || (header.stack == 0 && header.used_length > 0))
+        return HOJSON_ERROR_INVALID_INPUT;
+#ifdef HOJSON_UTF8_ONLY
+    if (header.encoding >= HOJSON_ENCODING_UTF_16_LE) /* Made by a build that parses UTF-16, midway through some */
+        return HOJSON_ERROR_INVALID_INPUT;
+#endif /* HOJSON_UTF8_ONLY */
+    else if (header.used_length > buffer_length)
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+
+    /* Check every node lies within the used portion of the buffer, and before its child, before trusting any of */
+    /* them. Offsets decrease from the tail to the head so this ends. */
+    const char* used = blob + sizeof(hojson_checkpoint_t);
+    size_t offset = header.stack;
+    while (offset != 0) {
+        size_t end, parent;
+        if (offset - 1 + sizeof(hojson_node_t) > header.used_length)
+            return HOJSON_ERROR_INVALID_INPUT;
+        memcpy(&end, used + offset - 1 + offsetof(hojson_node_t, end), sizeof(size_t));
+        memcpy(&parent, used + offset - 1 + offsetof(hojson_node_t, parent), sizeof(size_t));
+        if (end >= header.used_length || end + 1 < offset - 1 + offsetof(hojson_node_t, data) || parent >= offset)
+            return HOJSON_ERROR_INVALID_INPUT;
+        offset = parent;
+    }
+
+    hojson_init(context, buffer, buffer_length);
+    memcpy(buffer, used, header.used_length);
+    context->is_multi_document = header.is_multi_document;
+    context->encoding = header.encoding;
+    context->state = header.state;
+    context->escape_return_state = header.escape_return_state;
+    context->error_return_state = header.error_return_state;
+    context->bool_value = header.bool_value;
+    context->value_type = (hojson_type_t)header.value_type;
+    context->line = header.line;
+    context->column = header.column;
+    context->depth = header.depth;
+    context->stream = header.stream;
+    context->newline_character = header.newline_character;
+    context->stream_length = header.stream_length;
+    context->document_offset = header.document_offset;
+    context->integer_value = header.integer_value;
+    context->float_value = header.float_value;
+    /* With no content string yet, the next one is new and parsing begins at its first byte */
+    context->json_offset = header.input_offset;
+    if (header.stack != 0)
+        context->stack = buffer + header.stack - 1;
+    if (header.name != 0)
+        context->name = buffer + header.name - 1;
+    if (header.string_value != 0)
+        context->string_value = buffer + header.string_value - 1;
+
+    /* Turn the offsets of each node back into pointers, now into this buffer */
+    hojson_node_t* node = HOJSON_STACK;
+    while (node != NULL) {
+        size_t end, parent;
+        memcpy(&end, (char*)node + offsetof(hojson_node_t, end), sizeof(size_t));
+        memcpy(&parent, (char*)node + offsetof(hojson_node_t, parent), sizeof(size_t));
+        node->end = buffer + end;
+        node->parent = parent == 0 ? NULL : (hojson_node_t*)(buffer + parent - 1);
+        node = node->parent;
+    }
+
+    if (input_offset != NULL)
+        *input_offset = header.input_offset;
+    return HOJSON_NO_OP;
+}
+
 HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* json, const size_t json_length) {
     /* If there's no context object, the context is unintialized, or no JSON content was provided */
      if (context == NULL || context->is_initialized == 0 || json == NULL || json_length <= 0)
         return HOJSON_ERROR_INVALID_INPUT;
+    HOJSON_COUNT(parses, 1)
 
-    if (HOJSON_STACK != NULL) {
+    /* Work left over from the previous code, if any. When resuming from HOJSON_ERROR_UNEXPECTED_EOF, there usually */
+    /* isn't any so all of it is skipped with a single test. */
+    if (HOJSON_STACK != NULL && (HOJSON_STACK->flags & (HOJSON_FLAG_INCREMENT_DEPTH | HOJSON_FLAG_DECREMENT_DEPTH |
+            HOJSON_FLAG_MUST_POP_STACK | HOJSON_FLAG_POST_VALUE_CLEAN_UP))) {
         if (HOJSON_STACK->flags & HOJSON_FLAG_INCREMENT_DEPTH) /* If an object/array began, increasing nesting */
         {
             context->depth += 1;
@@ -327,14 +1151,20 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
             hojson_node_t* parent = HOJSON_STACK->parent;
             hojson_pop_stack(context); /* (Potentially) return to the parent node */
             if (parent == NULL) { /* If there was no parent (i.e. the popped object or array was the root) */
-                context->state = HOJSON_STATE_DONE;
+                context->document_offset = context->json_offset + (size_t)(context->iterator - context->json);
+                if (context->is_multi_document) { /* If another document may follow, start over without a stack */
+                    context->name = NULL;
+                    context->value_type = HOJSON_TYPE_NONE;
+                    context->state = HOJSON_STATE_NONE;
+                } else
+                    context->state = HOJSON_STATE_DONE;
                 return HOJSON_END_OF_DOCUMENT;
             }
         }
 
         if (HOJSON_STACK->flags & HOJSON_FLAG_POST_VALUE_CLEAN_UP) {
             /* If data, like a name or string value, had previously been appended to this node */
-            if (HOJSON_STACK->end - (char*)&(HOJSON_STACK->data) > 0) {
+            if (HOJSON_STACK->end - (char*)&(HOJSON_STACK->data) >= 0) {
                 /* Zero the memory from the first character of the node's data to its end. Any data in this memory */
                 /* range is now stale and taking up space unnecessarily. */
                 memset(&(HOJSON_STACK->data), 0, HOJSON_STACK->end - (char*)&(HOJSON_STACK->data) + 1);
@@ -358,24 +1188,42 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
         }
     }
 
+    uint8_t is_new_content = context->json != json; /* Whether the JSON content string is a new one */
     switch (context->state) { /* Check for error states or the "parsing has already finished" state */
     /* Two errors are recoverable: HOJSON_ERROR_INSUFFICIENT_MEMORY and HOJSON_ERROR_UNEXPECTED_EOF. The former can */
     /* be recovered by assigning a new buffer with hojson_realloc(). The latter can be recovered by passing a */
-    /* new JSON content string to hojson_parse() so we'll check for one before concluding we're still in error. */
+    /* new JSON content string to hojson_parse(). The previous string was consumed in its entirety, with any partial */
+    /* character at its end kept in the stream, so this string is new even if its pointer is the same. */
     case HOJSON_STATE_ERROR_UNEXPECTED_EOF: {
-        /* Try to decode a character, or remainder of a character, at the beginning of this hopefully-new string */
+        is_new_content = 1;
+        HOJSON_COUNT(resumes, 1)
+        if (context->stream_length == 0) {
+            /* This runs once per string so, with small strings, it's worth skipping the decoding below when no */
+            /* partial character was carried over. Parsing resumes and, if this string is empty, the main loop finds */
+            /* its null terminator and returns here, having consumed nothing. */
+            context->state = context->error_return_state;
+            context->error_return_state = HOJSON_STATE_NONE;
+            HOJSON_TRACE_EVENT(HOJSON_TRACE_RESUME, 0, context->json_offset +
+                (size_t)(context->iterator - context->json))
+            break;
+        }
+
+        /* Try to decode the remainder of the partial character at the beginning of this new string */
         uint32_t stream = context->stream;
-        size_t bytes_to_copy = (json_length <= 4 ? json_length : 4) - context->stream_length;
+        size_t bytes_to_copy = json_length < 4 - context->stream_length ? json_length : 4 - context->stream_length;
         if (bytes_to_copy < 4)
             memcpy((char*)&stream + context->stream_length, json, bytes_to_copy);
         else
-            stream = *(uint32_t*)json;
-        hojson_character_t c = hojson_decode_character((const char*)&stream, json_length, context->encoding);
-        if (c.value == 0 || c.value == UINT32_MAX) /* If a null terminator or there was not enough data */
+            memcpy(&stream, json, 4); /* The content may not be aligned */
+        hojson_character_t c = HOJSON_DECODE(context, (const char*)&stream, context->stream_length + bytes_to_copy);
+        if (c.value == 0) /* If a null terminator, the string is empty */
             return HOJSON_ERROR_UNEXPECTED_EOF;
-        context->state = context->error_return_state;
-        context->error_return_state = HOJSON_STATE_NONE;
-        /* Note: there is a check for a change to the input pointer a little further down */
+        if (c.value != UINT32_MAX) { /* If there's a whole character, resume. Otherwise, it's kept just below. */
+            context->state = context->error_return_state;
+            context->error_return_state = HOJSON_STATE_NONE;
+            HOJSON_TRACE_EVENT(HOJSON_TRACE_RESUME, 0, context->json_offset +
+                (size_t)(context->iterator - context->json))
+        }
     } break;
     case HOJSON_STATE_DONE: return HOJSON_END_OF_DOCUMENT;
     case HOJSON_STATE_ERROR_INTERNAL: return HOJSON_ERROR_INTERNAL;
@@ -384,13 +1232,25 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
     case HOJSON_STATE_ERROR_SYNTAX: return HOJSON_ERROR_SYNTAX;
     }
 
-    if (context->json != json) { /* If the pointer to the JSON content string has changed */
+    if (is_new_content) {
+        /* The previous string was parsed up to the iterator, which includes any bytes of a partial character that */
+        /* were kept in the stream */
+        if (context->json != NULL)
+            context->json_offset += (size_t)(context->iterator - context->json);
         /* A few variables are now invalid: the pointer to the content, its length, and the iterator */
         context->json = json;
         context->json_length = json_length;
         context->iterator = json;
     }
 
+    if (context->state == HOJSON_STATE_ERROR_UNEXPECTED_EOF) {
+        /* The new string is too short to complete the partial character so keep all of it, too, in the stream */
+        memcpy((char*)&(context->stream) + context->stream_length, json, json_length);
+        context->stream_length += json_length;
+        context->iterator += json_length;
+        return HOJSON_ERROR_UNEXPECTED_EOF;
+    }
+
     while (context->state >= HOJSON_STATE_NONE && context->state <= HOJSON_STATE_DONE) {
         /* Apart from the error states, "none" state, and BOM states, all states assume the stack is non-null */
         if (context->state >= HOJSON_STATE_NAME_EXPECTED && HOJSON_STACK == NULL) {
@@ -401,17 +1261,31 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
         }
 
         size_t bytes_remaining = (size_t)(context->json_length - (context->iterator - context->json));
-        size_t bytes_to_copy = (bytes_remaining <= 4 ? bytes_remaining : 4) - context->stream_length;
-        if (bytes_to_copy < 4)
-            memcpy((char*)&(context->stream) + context->stream_length, context->iterator, bytes_to_copy);
-        else
-            context->stream = *(uint32_t*)context->iterator;
-        hojson_character_t c = hojson_decode_character((const char*)&(context->stream), bytes_remaining,
-            context->encoding);
+        /* Fill the stream behind any bytes of a partial character carried over from the previous string */
+        size_t bytes_to_copy = bytes_remaining < 4 - context->stream_length ? bytes_remaining :
+            4 - context->stream_length;
+        hojson_character_t c;
+        if (bytes_to_copy == 0) { /* If the string has been consumed, there's nothing to decode */
+            c.raw = c.value = UINT32_MAX;
+            c.bytes = 0;
+        } else {
+            if (bytes_to_copy < 4) { /* Near the end of the string. Copying a few bytes beats calling memcpy(). */
+                size_t i;
+                for (i = 0; i < bytes_to_copy; i++)
+                    ((char*)&(context->stream))[context->stream_length + i] = context->iterator[i];
+            } else
+                memcpy(&(context->stream), context->iterator, 4); /* The content may not be aligned */
+            c = HOJSON_DECODE(context, (const char*)&(context->stream), context->stream_length + bytes_to_copy);
+        }
 
         /* If the character is the equivalent of a null terminator or there was not enough data to decode the value */
         if (c.value == 0 || c.value == UINT32_MAX) {
-            context->stream_length = bytes_to_copy;
+            if (c.value == UINT32_MAX) { /* Keep the partial character so the whole string has been consumed */
+                context->stream_length += bytes_to_copy;
+                context->iterator += bytes_to_copy;
+            }
+            HOJSON_TRACE_EVENT(HOJSON_TRACE_SUSPEND, 0, context->json_offset +
+                (size_t)(context->iterator - context->json))
             context->error_return_state = context->state;
             context->state = HOJSON_STATE_ERROR_UNEXPECTED_EOF;
             return HOJSON_ERROR_UNEXPECTED_EOF;
@@ -429,37 +1303,44 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
         /* variable where 'stream_length' tells us the number of said bytes. */
         context->bytes_iterated = c.bytes - context->stream_length;
         context->iterator += context->bytes_iterated;
+        context->bytes_carried = context->stream_length;
         context->stream_length = 0;
 
-        #ifdef HOJSON_DEBUG
-            char debugValue = HOJSON_IS_NEW_LINE(c.value) ? ' ' : c.value;
-            printf(" %c [%08X] [L%02dC%02d] [%c%c%c%c%c] -> ", debugValue, c.value, context->line, context->column,
-                HOJSON_STACK ? (HOJSON_STACK->flags & HOJSON_FLAG_IS_ARRAY ? '1' : '0') : '0',
-                HOJSON_STACK ? (HOJSON_STACK->flags & HOJSON_FLAG_COMMA ? '1' : '0') : '0',
-                HOJSON_STACK ? (HOJSON_STACK->flags & HOJSON_FLAG_DECIMAL ? '1' : '0') : '0',
-                HOJSON_STACK ? (HOJSON_STACK->flags & HOJSON_FLAG_EXPONENT ? '1' : '0') : '0',
-                HOJSON_STACK ? (HOJSON_STACK->flags & HOJSON_FLAG_PLUS_OR_MINUS ? '1' : '0') : '0');
+        #ifdef HOJSON_INSTRUMENT
+            if (context->stats != NULL) {
+                context->stats->characters[context->state]++;
+                if (context->stats->last_state != context->state) {
+                    context->stats->transitions[context->stats->last_state][context->state]++;
+                    context->stats->last_state = context->state;
+                }
+            }
         #endif
 
+        /* The character began this many bytes back, including any carried over from the previous string */
+        HOJSON_TRACE_EVENT(HOJSON_TRACE_CHARACTER, c.value, context->json_offset +
+            (size_t)(context->iterator - context->json) - c.bytes)
+
         switch (context->state) {
         case HOJSON_STATE_NONE: /* Initial state meaning no JSON content has been found yet */
-            HOJSON_LOG_STATE("HOJSON_STATE_NONE")
             if (c.value == '{' || c.value == '[')
                 return hojson_begin_token(context, c.value);
             else if (c.value == 0xEF) { /* The UTF-8 Byte Order Marker (BOM) is [EF] BB BF, as hex bytes */
                 context->state = HOJSON_STATE_UTF8_BOM1;
                 context->column--; /* Don't count this as a column */
-            } else if (c.value == 0xFE) { /* The UTF-16BE BOM is [FE] FF, as hex bytes */
+            }
+#ifndef HOJSON_UTF8_ONLY /* Otherwise, a UTF-16 byte order marker is a syntax error like any other stray byte */
+            else if (c.value == 0xFE) { /* The UTF-16BE BOM is [FE] FF, as hex bytes */
                 context->state = HOJSON_STATE_UTF16BE_BOM;
                 context->column--; /* Don't count this as a column */
             } else if (c.value == 0xFF) { /* The UTF-16LE BOM is [FF] FE, as hex bytes */
                 context->state = HOJSON_STATE_UTF16LE_BOM;
                 context->column--; /* Don't count this as a column */
-            } else if (!HOJSON_IS_WHITESPACE(c.value))
+            }
+#endif /* HOJSON_UTF8_ONLY */
+            else if (!HOJSON_IS_WHITESPACE(c.value))
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_UTF8_BOM1: /* The first byte of a UTF-8 byte order marker was found */
-            HOJSON_LOG_STATE("HOJSON_STATE_UTF8_BOM1")
             context->column--; /* Don't count this as a column */
             if (c.value == 0xBB) /* The UTF-8 BOM is EF [BB] BF, as hex bytes */
                 context->state = HOJSON_STATE_UTF8_BOM2;
@@ -467,7 +1348,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_UTF8_BOM2: /* The second byte of a UTF-8 byte order marker was found */
-            HOJSON_LOG_STATE("HOJSON_STATE_UTF8_BOM2")
             context->column--; /* Don't count this as a column */
             if (c.value == 0xBF) { /* The UTF-8 BOM is EF BB [BF], as hex bytes */
                 context->state = HOJSON_STATE_NONE;
@@ -475,8 +1355,8 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
             } else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
+#ifndef HOJSON_UTF8_ONLY
         case HOJSON_STATE_UTF16BE_BOM: /* The first byte of a UTF-16BE byte order marker was found */
-            HOJSON_LOG_STATE("HOJSON_STATE_UTF16BE_BOM")
             context->column--; /* Don't count this as a column */
             if (c.value == 0xFF) { /* The UTF-16BE BOM is FE [FF], as hex bytes */
                 context->state = HOJSON_STATE_NONE;
@@ -485,7 +1365,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_UTF16LE_BOM: /* The first byte of a UTF-16LE byte order marker was found */
-            HOJSON_LOG_STATE("HOJSON_STATE_UTF16LE_BOM")
             context->column--; /* Don't count this as a column */
             if (c.value == 0xFE) { /* The UTF-16LE BOM is FF [FE], as hex bytes */
                 context->state = HOJSON_STATE_NONE;
@@ -493,8 +1372,8 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
             } else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
+#endif /* HOJSON_UTF8_ONLY */
         case HOJSON_STATE_NAME_EXPECTED: /* A name is expected due to beginning an object or finding a comma after a pair */
-            HOJSON_LOG_STATE("HOJSON_STATE_NAME_EXPECTED")
             if (c.value == '\"') { /* If a name started */
                 HOJSON_STACK->flags |= HOJSON_FLAG_HAS_NAME;
                 context->state = HOJSON_STATE_NAME;
@@ -504,7 +1383,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_NAME: /* A name was started by a double quote (") and characters are being appended */
-            HOJSON_LOG_STATE("HOJSON_STATE_NAME")
             if (c.value == '\"') {
                 hojson_code_t code = hojson_append_terminator(context);
                 if (code < HOJSON_NO_OP) /* If appending the terminator failed */
@@ -526,14 +1404,12 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                     return code;
             } break;
         case HOJSON_STATE_POST_NAME: /* A name was ended by a double quote (") and a colon (:) is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_POST_NAME")
             if (c.value == ':')
                 context->state = HOJSON_STATE_VALUE_EXPECTED;
             else if (!HOJSON_IS_WHITESPACE(c.value))
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_VALUE_EXPECTED: /* A value is expected due to a colon (:) or a comma (,) in an array */
-            HOJSON_LOG_STATE("HOJSON_STATE_VALUE_EXPECTED")
             if (c.value == '"') { /* If a double quote (") was found " */
                 context->string_value = HOJSON_STACK->end + 1; /* The value's string will begin here */
                 context->state = HOJSON_STATE_STRING_VALUE; /* Expect a string value */
@@ -541,7 +1417,7 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 /* The characters of the number will be appended as they appear with the string value variable being */
                 /* used, temporarily, to build the full string to be parsed as a number */
                 context->string_value = HOJSON_STACK->end + 1; /* The value's string will begin here */
-                hojson_code_t code = hojson_append_character(context, c);
+                hojson_code_t code = hojson_append_number_character(context, c);
                 if (code < HOJSON_NO_OP) /* If appending the character failed */
                     return code;
                 else /* If appending the character succeeded */
@@ -560,8 +1436,11 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_STRING_VALUE: /* A double quote (") was found after a colon (:) or in an array */
-            HOJSON_LOG_STATE("HOJSON_STATE_STRING_VALUE")
             if (c.value == '"') {
+                /* Terminate the value so it can't be read past the end of the buffer, if it happens to fill it */
+                hojson_code_t code = hojson_append_terminator(context);
+                if (code < HOJSON_NO_OP) /* If appending the terminator failed */
+                    return code;
                 context->value_type = HOJSON_TYPE_STRING;
                 HOJSON_STACK->flags |= HOJSON_FLAG_POST_VALUE_CLEAN_UP; /* Clean up with the next hojson_parse() */
                 context->state = HOJSON_STATE_POST_VALUE;
@@ -576,7 +1455,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                     return code;
             } break;
         case HOJSON_STATE_ESCAPE: { /* A backslash (\) was found and an escaped or Unicode character is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_ESCAPE")
             uint32_t characterToAppend;
             switch (c.value) {
             /* The non-default cases here represent the only characters that are acceptable after a backslash */
@@ -595,7 +1473,7 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
             /* All other characters are invalid syntax */
             default: context->state = HOJSON_STATE_ERROR_SYNTAX; continue;
             }
-            hojson_character_t encodedCharacter = hojson_encode_character(characterToAppend, context->encoding);
+            hojson_character_t encodedCharacter = HOJSON_ENCODE(context, characterToAppend);
             hojson_code_t code = hojson_append_character(context, encodedCharacter);
             if (code < HOJSON_NO_OP) /* If appending the character failed */
                 return code;
@@ -605,7 +1483,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->escape_return_state = HOJSON_STATE_NONE;
             } } break;
         case HOJSON_STATE_UNICODE_1: /* Unicode escapement notation was found, a hex number is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_UNICODE_1")
             if (HOJSON_IS_HEX_CHAR(c.value)) {
                 /* Hexadecimal (base-16) can be converted to decimal (base-ten) iteratively. For example, given the */
                 /* hex value ABCD, the decimal equivalent is (A * 16^3) + (B * 16^2) + (C * 16^1) + (D * 16^0). This */
@@ -617,7 +1494,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_UNICODE_2: /* Unicode escapement notation was found, a second hex number is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_UNICODE_2")
             if (HOJSON_IS_HEX_CHAR(c.value)) {
                 context->integer_value += hojson_hex_character_to_decimal(c.value) * 256; /* 16^2 */
                 context->state = HOJSON_STATE_UNICODE_3;
@@ -625,7 +1501,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_UNICODE_3: /* Unicode escapement notation was found, a third hex number is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_UNICODE_3")
             if (HOJSON_IS_HEX_CHAR(c.value)) {
                 context->integer_value += hojson_hex_character_to_decimal(c.value) * 16; /* 16^1 */
                 context->state = HOJSON_STATE_UNICODE_4;
@@ -633,11 +1508,10 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_UNICODE_4: /* Unicode escapement notation was found, a fourth hex number is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_UNICODE_4")
             if (HOJSON_IS_HEX_CHAR(c.value)) {
-                context->integer_value += hojson_hex_character_to_decimal(c.value) * 1; /* 16^0 */
-                hojson_character_t encodedCharacter = hojson_encode_character(context->integer_value,
-                    context->encoding);
+                /* The last digit is added to a copy. If appending fails, this digit is processed again. */
+                hojson_character_t encodedCharacter = HOJSON_ENCODE(context, context->integer_value +
+                    hojson_hex_character_to_decimal(c.value) * 1); /* 16^0 */
                 hojson_code_t code = hojson_append_character(context, encodedCharacter);
                 if (code < HOJSON_NO_OP) /* If appending the character failed */
                     return code;
@@ -650,16 +1524,15 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_NUMBER_VALUE: /* A number character (0-9) was found after a colon (:) or in an array */
-            HOJSON_LOG_STATE("HOJSON_STATE_NUMBER_VALUE")
             if (HOJSON_IS_NUMERIC(c.value)) {
-                hojson_code_t code = hojson_append_character(context, c);
+                hojson_code_t code = hojson_append_number_character(context, c);
                 if (code < HOJSON_NO_OP) /* If appending the character failed */
                     return code;
             } else if (c.value == '.') {
                 if (HOJSON_STACK->flags & HOJSON_FLAG_DECIMAL) /* If the number already has a decimal */
                     context->state = HOJSON_STATE_ERROR_SYNTAX;
                 else {
-                    hojson_code_t code = hojson_append_character(context, c);
+                    hojson_code_t code = hojson_append_number_character(context, c);
                     if (code < HOJSON_NO_OP) /* If appending the character failed */
                         return code;
                     else /* If appending the character succeeded */
@@ -669,7 +1542,7 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 if (HOJSON_STACK->flags & HOJSON_FLAG_EXPONENT) /* If the number already has an 'e' or 'E' */
                     context->state = HOJSON_STATE_ERROR_SYNTAX;
                 else {
-                    hojson_code_t code = hojson_append_character(context, c);
+                    hojson_code_t code = hojson_append_number_character(context, c);
                     if (code < HOJSON_NO_OP) /* If appending the character failed */
                         return code;
                     else /* If appending the character succeeded */
@@ -681,13 +1554,18 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 } else if (HOJSON_STACK->flags & HOJSON_FLAG_PLUS_OR_MINUS) /* If there was a previous '+' or '-' */
                     context->state = HOJSON_STATE_ERROR_SYNTAX;
                 else {
-                    hojson_code_t code = hojson_append_character(context, c);
+                    hojson_code_t code = hojson_append_number_character(context, c);
                     if (code < HOJSON_NO_OP) /* If appending the character failed */
                         return code;
                     else /* If appending the character succeeded */
                         HOJSON_STACK->flags |= HOJSON_FLAG_PLUS_OR_MINUS; /* Set the "has a + or -" flag */
                 }
             } else if (HOJSON_IS_WHITESPACE(c.value) || c.value == ',' || c.value == ']' || c.value == '}') {
+                /* Terminate the number so atoi() and atof() can't read past the end of the buffer */
+                hojson_code_t code = hojson_append_terminator(context);
+                if (code < HOJSON_NO_OP) /* If appending the terminator failed */
+                    return code;
+
                 /* Parse the string from the JSON content as a number. Strings with decimals or exponents will be */
                 /* parsed as floating-point values. Strings without both will be parsed as integer values. */
                 /* Note: while E notation could potentially describe an integer, atoi() does not support E notation. */
@@ -700,8 +1578,8 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                     if (context->string_value != NULL) /* Quick error check */
                         context->integer_value = atoi(context->string_value);
                 }
-                /* Nullify the value string. It was temporarily pointing to the number as a string. */
-                context->string_value = NULL;
+                /* The value string is left pointing to the number as it appeared, which is exact where the integer */
+                /* or floating-point value may not be */
 
                 HOJSON_STACK->flags |= HOJSON_FLAG_POST_VALUE_CLEAN_UP; /* Clean up with the next hojson_parse() */
                 context->state = HOJSON_STATE_POST_VALUE;
@@ -714,21 +1592,18 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_TRUE_VALUE_T: /* A 't' was found after a colon (:) or in an array, an 'r' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_TRUE_VALUE_T")
             if (c.value == 'r')
                 context->state = HOJSON_STATE_TRUE_VALUE_R;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_TRUE_VALUE_R: /* An 'r' was found after a 't', a 'u' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_TRUE_VALUE_R")
             if (c.value == 'u')
                 context->state = HOJSON_STATE_TRUE_VALUE_U;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_TRUE_VALUE_U: /* A 'u' was found after an 'r', an 'e' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_TRUE_VALUE_U")
             if (c.value == 'e') {
                 context->value_type = HOJSON_TYPE_BOOLEAN; /* Indicate the value is a boolean type */
                 context->bool_value = 1; /* Non-zero values evalulate to true */
@@ -739,28 +1614,24 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_FALSE_VALUE_F: /* An 'f' was found after a colon (:) or in an array, an 'a' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_FALSE_VALUE_F")
             if (c.value == 'a')
                 context->state = HOJSON_STATE_FALSE_VALUE_A;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_FALSE_VALUE_A: /* An 'a' was found after an 'f', an 'l' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_FALSE_VALUE_A")
             if (c.value == 'l')
                 context->state = HOJSON_STATE_FALSE_VALUE_L;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_FALSE_VALUE_L: /* An 'l' was found after an 'a', an 's' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_FALSE_VALUE_L")
             if (c.value == 's')
                 context->state = HOJSON_STATE_FALSE_VALUE_S;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_FALSE_VALUE_S: /* An 's' was found after an 'l', an 'e' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_FALSE_VALUE_S")
             if (c.value == 'e') {
                 context->value_type = HOJSON_TYPE_BOOLEAN; /* Indicate the value is a boolean type */
                 context->bool_value = 0; /* Zero evalulates to false */
@@ -771,21 +1642,18 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_NULL_VALUE_N: /* An 'n' was found after a colon (:) or in an array, a 'u' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_NULL_VALUE_N")
             if (c.value == 'u')
                 context->state = HOJSON_STATE_NULL_VALUE_U;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_NULL_VALUE_U: /* A 'u' was found after an 'n', an 'l' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_NULL_VALUE_U")
             if (c.value == 'l')
                 context->state = HOJSON_STATE_NULL_VALUE_L;
             else
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_NULL_VALUE_L: /* An 'l' was found after a 'u', another 'l' is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_NULL_VALUE_L")
             if (c.value == 'l') {
                 context->value_type = HOJSON_TYPE_NULL; /* Indicate the value is a null/unset type */
                 HOJSON_STACK->flags |= HOJSON_FLAG_POST_VALUE_CLEAN_UP; /* Clean up with the next hojson_parse() */
@@ -795,7 +1663,6 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
                 context->state = HOJSON_STATE_ERROR_SYNTAX;
             break;
         case HOJSON_STATE_POST_VALUE: /* A value was found, a comma (,) or closing token (} or ]) is expected */
-            HOJSON_LOG_STATE("HOJSON_STATE_POST_VALUE")
             if (c.value == '}' || c.value == ']')
                 return hojson_end_token(context, c.value);
             else if (c.value == ',') {
@@ -820,24 +1687,28 @@ HOJSON_DECL hojson_code_t hojson_parse(hojson_context_t* context, const char* js
 void hojson_stay(hojson_context_t* context) {
     /* For the X-byte step forward, take an X-byte step back. With this, parsing will return to the last character. */
     context->iterator -= context->bytes_iterated;
+    context->stream_length = context->bytes_carried; /* The carried bytes remain at the beginning of the stream */
     context->column--;
+    HOJSON_COUNT(stays, 1)
+    HOJSON_TRACE_EVENT(HOJSON_TRACE_STAY, 0, context->json_offset + (size_t)(context->iterator - context->json))
 }
 
 void hojson_push_stack(hojson_context_t* context) {
+    /* The root node is placed at the beginning of the buffer and any other right after its parent node, rounded up */
+    /* so its pointers are aligned, as long as the buffer is. Offsets, rather than addresses, are rounded so nodes */
+    /* stay put relative to the buffer when it's reallocated or restored from a checkpoint. */
+    size_t offset = 0;
+    if (HOJSON_STACK != NULL)
+        offset = HOJSON_ALIGN((size_t)(HOJSON_STACK->end + 1 - context->buffer));
+
     /* If "allocating" a new node would overflow the buffer */
-    if ((HOJSON_STACK == NULL && sizeof(hojson_node_t) >= context->buffer_length) || (HOJSON_STACK != NULL &&
-            HOJSON_STACK->end + 1 + sizeof(hojson_node_t) >= context->buffer + context->buffer_length)) {
+    if (offset + sizeof(hojson_node_t) >= context->buffer_length) {
         context->error_return_state = context->state;
         context->state = HOJSON_STATE_ERROR_INSUFFICIENT_MEMORY;
         return;
     }
 
-    hojson_node_t* node;
-    if (HOJSON_STACK == NULL) /* If pushing the root node */
-        node = (hojson_node_t*)context->buffer; /* Place the new node at the beginning of the buffer */
-    else
-        node = (hojson_node_t*)(HOJSON_STACK->end + 1); /* Place the new node right after the parent node */
-
+    hojson_node_t* node = (hojson_node_t*)(context->buffer + offset);
     if (node != NULL) { /* Quick error check, just in case */
         node->parent = HOJSON_STACK; /* This new node's parent is the previous stack node */
         node->end = &(node->data) - 1; /* Point node's last byte, -1 because nothing has been appended yet */
@@ -869,12 +1740,23 @@ hojson_code_t hojson_append_character(hojson_context_t* context, hojson_characte
 
     memcpy(HOJSON_STACK->end + 1, &(c.raw), c.bytes); /* Copy the character to the stack */
     HOJSON_STACK->end += c.bytes; /* Redirect the end pointer to the new end just after the appended character */
+    HOJSON_COUNT(appends, 1)
+    HOJSON_COUNT(bytes_appended, c.bytes)
     return HOJSON_NO_OP;
 }
 
+hojson_code_t hojson_append_number_character(hojson_context_t* context, hojson_character_t c) {
+    /* Numbers are made only of ASCII characters so, whatever the document's encoding, each is appended as one byte */
+    /* and atoi() and atof() can parse the result */
+    c.raw = 0;
+    *(uint8_t*)&(c.raw) = (uint8_t)c.value;
+    c.bytes = 1;
+    return hojson_append_character(context, c);
+}
+
 hojson_code_t hojson_append_terminator(hojson_context_t* context) {
     /* If the document is encoded with UTF-16, two bytes will be appended. One byte otherwise. */
-    uint8_t bytes = context->encoding >= HOJSON_ENCODING_UTF_16_BE ? 2 : 1;
+    uint8_t bytes = HOJSON_IS_UTF16(context) ? 2 : 1;
     if (HOJSON_STACK->end + bytes >= context->buffer + context->buffer_length) {
         hojson_stay(context); /* Rewind by one character */
         context->error_return_state = context->state;
@@ -884,6 +1766,8 @@ hojson_code_t hojson_append_terminator(hojson_context_t* context) {
 
     memset(HOJSON_STACK->end + 1, '\0', bytes); /* Copy the terminator to the stack */
     HOJSON_STACK->end += bytes; /* Redirect the end pointer to the new end just after the appended terminator */
+    HOJSON_COUNT(appends, 1)
+    HOJSON_COUNT(bytes_appended, bytes)
     return HOJSON_NO_OP;
 }
 
@@ -959,187 +1843,194 @@ hojson_code_t hojson_end_token(hojson_context_t* context, char token) {
         return HOJSON_OBJECT_END;
 }
 
-hojson_character_t hojson_decode_character(const char* str, size_t str_length, uint8_t encoding) {
+size_t hojson_used_length(const hojson_context_t* context) {
+    if (HOJSON_STACK == NULL) /* If there's no stack, nothing in the buffer is in use */
+        return 0;
+
+    /* The current node is the last in the buffer. It ends with its last byte of data or, if it has yet to grow */
+    /* further, with the node itself. */
+    size_t node_end = (size_t)(context->stack - context->buffer) + sizeof(hojson_node_t);
+    size_t data_end = (size_t)(HOJSON_STACK->end - context->buffer) + 1;
+    return HOJSON_MAXIMUM(node_end, data_end);
+}
+
+hojson_character_t hojson_decode_byte(const char* str, size_t str_length) {
+    /* Until a byte order marker says otherwise, content is taken a byte at a time. As every token is ASCII, the */
+    /* bytes of any other character are appended one by one and end up exactly as they appeared. */
+    hojson_character_t c;
+    if (str_length == 0) { /* If there's no byte to decode */
+        c.value = UINT32_MAX;
+        c.raw = 0;
+        c.bytes = 0;
+    } else {
+        c.value = (uint32_t)(uint8_t)str[0];
+        c.raw = 0;
+        *(uint8_t*)&(c.raw) = (uint8_t)str[0];
+        c.bytes = 1;
+    }
+    return c;
+}
+
+hojson_character_t hojson_decode_utf8(const char* str, size_t str_length) {
     hojson_character_t c;
     c.raw = c.value = 0; /* These default values are not valid so parsing will cease if returned */
     c.bytes = 0;
-    switch (encoding) {
-    case HOJSON_ENCODING_UNKNOWN:
+
+    /* The first byte of a UTF-8 character can can begin with one of four bit patterns, each indicating the */
+    /* number of remaining bytes: 0XXXXXXX = 1 byte, 110XXXXX = 2 bytes, 1110XXXX = 3 bytes, 11110XXX = 4 bytes. */
+    /* NOTE: UTF-8 is *big* endian. */
+    if (((str[0] >> 7) & 0x01) == 0x00)
         c.bytes = 1;
-        break;
-    case HOJSON_ENCODING_UTF_8:
-        /* The first byte of a UTF-8 character can can begin with one of four bit patterns, each indicating the */
-        /* number of remaining bytes: 0XXXXXXX = 1 byte, 110XXXXX = 2 bytes, 1110XXXX = 3 bytes, 11110XXX = 4 bytes. */
-        /* NOTE: UTF-8 is *big* endian. */
-        if (((str[0] >> 7) & 0x01) == 0x00)
-            c.bytes = 1;
-        else if (((str[0] >> 5) & 0x07) == 0x06)
-            c.bytes = 2;
-        else if (((str[0] >> 4) & 0x0F) == 0x0E)
-            c.bytes = 3;
-        else if (((str[0] >> 3) & 0x1F) == 0x1E)
-            c.bytes = 4;
-        break;
-    case HOJSON_ENCODING_UTF_16_BE:
-        /* UTF-16 characters are either two bytes or four bytes where the four-byte characters are encoded such that */
-        /* the first two bytes begin with 110110XX and the second with 110111XX. The rest are two-byte characters. */
-        if (((str[0] >> 2) & 0x3F) == 0x36 && ((str[2] >> 2) & 0x3F) == 0x37)
-            c.bytes = 4;
-        else
-            c.bytes = 2;
-        break;
-    case HOJSON_ENCODING_UTF_16_LE:
-        /* UTF-16LE (Little Endian) is just like UTF-16BE (Big Endian) but the most and least significant bytes in */
-        /* any 16-bit sequence are swapped. (Technically, a byte isn't defined as eight bits but it is in practice.) */
-        if (((str[1] >> 2) & 0x3F) == 0x36 && ((str[3] >> 2) & 0x3F) == 0x37)
-            c.bytes = 4;
-        else
-            c.bytes = 2;
-        break;
-    }
+    else if (((str[0] >> 5) & 0x07) == 0x06)
+        c.bytes = 2;
+    else if (((str[0] >> 4) & 0x0F) == 0x0E)
+        c.bytes = 3;
+    else if (((str[0] >> 3) & 0x1F) == 0x1E)
+        c.bytes = 4;
 
     /* If the string doesn't have enough bytes in it to decode this character */
     if (c.bytes > str_length) {
         /* Set the decoded value to the maximum possible to indicate a failure, zero the rest, and return early */
         c.value = UINT32_MAX;
-        c.raw = 0;
         c.bytes = 0;
         return c;
     }
 
-    switch (encoding) {
-    case HOJSON_ENCODING_UNKNOWN:
-        c.value = (uint32_t)str[0] & 0x000000FF; /* The mask ensures the remainder of the bits are zero */
-        break;
-    case HOJSON_ENCODING_UTF_8:
-        if (c.bytes == 1) {
-            /* One-byte UTF-8 characters are encoded as 0XXXXXXX where the Xs represent the bits of the character's */
-            /* value. For all decoding, we want to grab only those bits and transform them into an integer. */
-            /* The method here takes one byte from the string, uses a mask to zero out any bit that is not part of */
-            /* resulting value, casts the masked byte to an unsigned 32-bit integer, shifts those bits to the left to */
-            /* place them at the indexes they're expected in the value, and then bitwise ORs these components into a */
-            /* single unsigned 32-bit integer. This one-byte case does not need any shift but the remaining cases do. */
-            c.value = (uint32_t)(str[0] & 0x7F);
-        } else if (c.bytes == 2) {
-            /* Two-byte UTF-8 characters are encoded as 110XXXXX 10XXXXXX */
-            c.value = ((uint32_t)(str[0] & 0x1F) << 6) | (uint32_t)(str[1] & 0x3F);
-        } else if (c.bytes == 3) {
-            /* Three-byte UTF-8 characters are encoded as 1110XXXX 10XXXXXX 10XXXXXX */
-            c.value = ((uint32_t)(str[0] & 0x0F) << 12) | ((uint32_t)(str[1] & 0x3F) << 6) |
-                       (uint32_t)(str[2] & 0x3F);
-        } else if (c.bytes == 4) {
-            /* Four-byte UTF-8 characters are encoded as 11110XXX 10XXXXXX 10XXXXXX 10XXXXXX */
-            c.value = ((uint32_t)(str[0] & 0x07) << 18) | ((uint32_t)(str[1] & 0x3F) << 12) |
-                      ((uint32_t)(str[2] & 0x3F) << 6)  |  (uint32_t)(str[3] & 0x3F);
-        } break;
-    case HOJSON_ENCODING_UTF_16_BE:
-        if (c.bytes == 2) {
-            /* Concatenate the two bytes together to retrieve the original value */
-            c.value = ((uint32_t)str[0] << 8) | (uint32_t)str[1];
-        } else if (c.bytes == 4) {
-            /* Four-byte UTF-16 characters are encoded as 110110XX XXXXXXXX 110111XX XXXXXXXX after first subtracting */
-            /* 0x00010000 from the value. Here, that subtracted value is reconstructed and 0x00010000 is added back. */
-            c.value = (((uint32_t)(str[0] & 0x03) << 18) | ((uint32_t)str[1] << 16) |
-                       ((uint32_t)(str[2] & 0x03) << 8)  |  (uint32_t)str[3]) + 0x00010000;
-        }
-        break;
-    case HOJSON_ENCODING_UTF_16_LE:
-        if (c.bytes == 2)
-            c.value = ((uint32_t)str[1] << 8) | (uint32_t)str[0];
-        else if (c.bytes == 4) {
-            c.value = (((uint32_t)(str[1] & 0x03) << 18) | ((uint32_t)str[0] << 16) |
-                       ((uint32_t)(str[3] & 0x03) << 8)  |  (uint32_t)str[2]) + 0x00010000;
-        }
-        break;
+    if (c.bytes == 1) {
+        /* One-byte UTF-8 characters are encoded as 0XXXXXXX where the Xs represent the bits of the character's */
+        /* value. For all decoding, we want to grab only those bits and transform them into an integer. */
+        /* The method here takes one byte from the string, uses a mask to zero out any bit that is not part of */
+        /* resulting value, casts the masked byte to an unsigned 32-bit integer, shifts those bits to the left to */
+        /* place them at the indexes they're expected in the value, and then bitwise ORs these components into a */
+        /* single unsigned 32-bit integer. This one-byte case does not need any shift but the remaining cases do. */
+        c.value = (uint32_t)(str[0] & 0x7F);
+        memcpy(&(c.raw), str, 1); /* The original bytes, in their original order */
+    } else if (c.bytes == 2) {
+        /* Two-byte UTF-8 characters are encoded as 110XXXXX 10XXXXXX */
+        c.value = ((uint32_t)(str[0] & 0x1F) << 6) | (uint32_t)(str[1] & 0x3F);
+        memcpy(&(c.raw), str, 2);
+    } else if (c.bytes == 3) {
+        /* Three-byte UTF-8 characters are encoded as 1110XXXX 10XXXXXX 10XXXXXX */
+        c.value = ((uint32_t)(str[0] & 0x0F) << 12) | ((uint32_t)(str[1] & 0x3F) << 6) |
+                   (uint32_t)(str[2] & 0x3F);
+        memcpy(&(c.raw), str, 3);
+    } else if (c.bytes == 4) {
+        /* Four-byte UTF-8 characters are encoded as 11110XXX 10XXXXXX 10XXXXXX 10XXXXXX */
+        c.value = ((uint32_t)(str[0] & 0x07) << 18) | ((uint32_t)(str[1] & 0x3F) << 12) |
+                  ((uint32_t)(str[2] & 0x3F) << 6)  |  (uint32_t)(str[3] & 0x3F);
+        memcpy(&(c.raw), str, 4);
     }
+    return c;
+}
 
-    switch (c.bytes) {
-        /* The method here takes the char pointer, casts it to an unsigned 32-bit integer pointer (pointing to four */
-        /* bytes rather than one), dereferences it to get its integer value, applies a mask to zero any unwanted bits */
-        /* (e.g. the 0x000000FF mask retains just the last eight bits), and assigns this value to 'raw' value. */
-        case 1: c.raw = *(uint32_t*)str & 0x000000FF; break;
-        case 2: c.raw = *(uint32_t*)str & 0x0000FFFF; break;
-        case 3: c.raw = *(uint32_t*)str & 0x00FFFFFF; break;
-        case 4: c.raw = *(uint32_t*)str; break;
+hojson_character_t hojson_decode_utf16(const char* str, size_t str_length, uint8_t is_big_endian) {
+    /* The more significant byte of each 16-bit unit comes first in UTF-16BE and second in UTF-16LE */
+    const size_t high = is_big_endian ? 0 : 1, low = 1 - high;
+    hojson_character_t c;
+    c.raw = 0;
+
+    /* UTF-16 characters are either two bytes or four bytes where the four-byte characters are encoded such that */
+    /* the first two bytes begin with 110110XX and the second with 110111XX. The rest are two-byte characters. */
+    if (str_length >= 4 && ((str[high] >> 2) & 0x3F) == 0x36 && ((str[2 + high] >> 2) & 0x3F) == 0x37)
+        c.bytes = 4;
+    else if (str_length >= 2 && (((str[high] >> 2) & 0x3F) != 0x36 || str_length >= 4))
+        c.bytes = 2;
+    else { /* If the string doesn't have enough bytes in it to decode this character */
+        c.value = UINT32_MAX;
+        c.bytes = 0;
+        return c;
     }
 
+    if (c.bytes == 2) {
+        /* Concatenate the two bytes together to retrieve the original value */
+        /* Bytes are cast to unsigned first so those from 0x80 up aren't sign extended */
+        c.value = ((uint32_t)(uint8_t)str[high] << 8) | (uint32_t)(uint8_t)str[low];
+        memcpy(&(c.raw), str, 2); /* The original bytes, in their original order */
+    } else {
+        /* Four-byte UTF-16 characters are encoded as 110110XX XXXXXXXX 110111XX XXXXXXXX after first subtracting */
+        /* 0x00010000 from the value. Here, that subtracted value is reconstructed and 0x00010000 is added back. */
+        c.value = (((uint32_t)(str[high] & 0x03) << 18) | ((uint32_t)(uint8_t)str[low] << 10) |
+                   ((uint32_t)(str[2 + high] & 0x03) << 8)  |  (uint32_t)(uint8_t)str[2 + low]) + 0x00010000;
+        memcpy(&(c.raw), str, 4);
+    }
     return c;
 }
 
-hojson_character_t hojson_encode_character(uint32_t value, uint8_t encoding) {
+hojson_character_t hojson_decode_character(const char* str, size_t str_length, uint8_t encoding) {
+    switch (encoding) {
+    case HOJSON_ENCODING_UTF_8: return hojson_decode_utf8(str, str_length);
+    case HOJSON_ENCODING_UTF_16_BE: return hojson_decode_utf16(str, str_length, 1);
+    case HOJSON_ENCODING_UTF_16_LE: return hojson_decode_utf16(str, str_length, 0);
+    default: return hojson_decode_byte(str, str_length);
+    }
+}
+
+hojson_character_t hojson_encode_utf8(uint32_t value) {
     hojson_character_t c;
     c.value = value;
     c.raw = 0;
+    if (value <= 0x0000007F) { /* If the value will fit into one byte */
+        ((uint8_t*)&c.raw)[0] = (uint8_t)value;
+        c.bytes = 1;
+    } else if (value >= 0x000080 && value <= 0x000007FF) { /* If the value will fit into two bytes */
+        /* For a value with bits XXXXXAAA AABBBBBB we want to transform the bits to the form 110AAAAA 10BBBBBB. */
+        /* The method here treats c.raw as an array of unsigned, eight-bit integers. This is done to assign bytes */
+        /* individually for the sake of endianness where UTF-8 is big endian. The value is masked in order to */
+        /* zero any bits that are not used in the byte being assigned, then shifted all the way to the right. */
+        /* prefixed "0xC0" and "0x80" bitwise ORs prepend the UTF-8 markers 110 and 10, respectively. The */
+        ((uint8_t*)&c.raw)[0] = 0xC0 | (uint8_t)((value & 0x000007C0) >> 6); /* 110AAAAA */
+        ((uint8_t*)&c.raw)[1] = 0x80 | (uint8_t) (value & 0x0000003F); /* 10BBBBBB */
+        c.bytes = 2;
+    } else if ((value >= 0x00000800 && value <= 0x0000D7FF) || (value >= 0x0000E000 && value <= 0x0000FFFF)) {
+        /* For a value with bits AAAABBBB BBCCCCCC we want 1110AAAA 10BBBBBB 10CCCCCC */
+        ((uint8_t*)&c.raw)[0] = 0xE0 | (uint8_t)((value & 0x0000F000) >> 12); /* 1110AAAA */
+        ((uint8_t*)&c.raw)[1] = 0x80 | (uint8_t)((value & 0x00000FC0) >> 6); /* 10BBBBBB */
+        ((uint8_t*)&c.raw)[2] = 0x80 | (uint8_t) (value & 0x0000003F); /* 10CCCCCC */
+        c.bytes = 3;
+    } else if (value >= 0x00010000 && value <= 0x0010FFFF) {
+        /* For a value with bits XXXAAABB BBBBCCCC CCDDDDDD we want 11110AAA 10BBBBBB 10CCCCCC 10DDDDDD */
+        ((uint8_t*)&c.raw)[0] = 0xF0 | (uint8_t)((value & 0x001C0000) >> 18) ; /* 11110AAA */
+        ((uint8_t*)&c.raw)[1] = 0x80 | (uint8_t)((value & 0x0003F000) >> 12); /* 10BBBBBB */
+        ((uint8_t*)&c.raw)[2] = 0x80 | (uint8_t)((value & 0x00000FC0) >> 6); /* 10CCCCCC */
+        ((uint8_t*)&c.raw)[3] = 0x80 | (uint8_t) (value & 0x0000003F); /* 10DDDDDD */
+        c.bytes = 4;
+    } else /* If the reference's value is not valid */
+        c.bytes = 0; /* Don't even try */
+    return c;
+}
 
+hojson_character_t hojson_encode_utf16(uint32_t value, uint8_t is_big_endian) {
+    /* UTF-16LE (Little Endian) is just like UTF-16BE (Big Endian) but the most and least significant bytes in any */
+    /* 16-bit unit are swapped, so the same operations are used with the indexes chosen to reflect endianness */
+    const size_t high = is_big_endian ? 0 : 1, low = 1 - high;
+    hojson_character_t c;
+    c.value = value;
+    c.raw = 0;
+    if (value <= 0x0000D7FF || (value >= 0x0000E000 && value <= 0x0000FFFF)) { /* If the value fits in two bytes */
+        ((uint8_t*)&c.raw)[high] = (uint8_t)((value & 0x0000FF00) >> 8);
+        ((uint8_t*)&c.raw)[low] = (uint8_t) (value & 0x000000FF);
+        c.bytes = 2;
+    } else if (value >= 0x00010000 && value <= 0x0010FFFF) { /* If the value fits in four bytes */
+        /* For a value - 0x00010000 with bits XXXXXXXX XXXXAABB BBBBBBCC DDDDDDDD we want to transform the bits */
+        /* to the form 110110AA BBBBBBBB 110111CC DDDDDDDD. When decoded, as per UTF-16, 0x00010000 is added. */
+        /* The prefixed "0xD8" and "0xDC" bitwise ORs prepend the UTF-16 markers 110110 and 110111, respectively. */
+        value -= 0x00010000;
+        ((uint8_t*)&c.raw)[high] = 0xD8 | (uint8_t)((value & 0x000C0000) >> 18); /* 110110AA */
+        ((uint8_t*)&c.raw)[low] =         (uint8_t)((value & 0x0003FC00) >> 10); /* BBBBBBBB */
+        ((uint8_t*)&c.raw)[2 + high] = 0xDC | (uint8_t)((value & 0x00000300) >> 8); /* 110111CC */
+        ((uint8_t*)&c.raw)[2 + low] =         (uint8_t) (value & 0x000000FF); /* DDDDDDDD */
+        c.bytes = 4;
+    } else /* If the reference's value is not valid */
+        c.bytes = 0; /* Don't even try */
+    return c;
+}
+
+hojson_character_t hojson_encode_character(uint32_t value, uint8_t encoding) {
     switch (encoding) {
-    case HOJSON_ENCODING_UNKNOWN: /* If the encoding is somehow not specified, assume UTF-8 */
-    case HOJSON_ENCODING_UTF_8:
-        if (value <= 0x0000007F) { /* If the value will fit into one byte */
-            c.raw = value;
-            c.bytes = 1;
-        } else if (value >= 0x000080 && value <= 0x000007FF) { /* If the value will fit into two bytes */
-            /* For a value with bits XXXXXAAA AABBBBBB we want to transform the bits to the form 110AAAAA 10BBBBBB. */
-            /* The method here treats c.raw as an array of unsigned, eight-bit integers. This is done to assign bytes */
-            /* individually for the sake of endianness where UTF-8 is big endian. The value is masked in order to */
-            /* zero any bits that are not used in the byte being assigned, then shifted all the way to the right. */
-            /* prefixed "0xC0" and "0x80" bitwise ORs prepend the UTF-8 markers 110 and 10, respectively. The */
-            ((uint8_t*)&c.raw)[0] = 0xC0 | (uint8_t)((value & 0x0000007C0) >> 6); /* 110AAAAAA */
-            ((uint8_t*)&c.raw)[1] = 0x80 | (uint8_t) (value & 0x0000000FF); /* 10BBBBBB */
-            c.bytes = 2;
-        } else if ((value >= 0x00000800 && value <= 0x0000D7FF) || (value >= 0x0000E000 && value <= 0x0000FFFF)) {
-            /* For a value with bits AAAABBBB BBCCCCCC we want 1110AAAA 10BBBBBB 10CCCCCC */
-            ((uint8_t*)&c.raw)[0] = 0xE0 | (uint8_t)((value & 0x0000F000) >> 12); /* 1110AAAA */
-            ((uint8_t*)&c.raw)[1] = 0x80 | (uint8_t)((value & 0x00000FC0) >> 6); /* 10BBBBBB */
-            ((uint8_t*)&c.raw)[2] = 0x80 | (uint8_t) (value & 0x0000003F); /* 10CCCCCC */
-            c.bytes = 3;
-        } else if (value >= 0x00010000 && value <= 0x0010FFFF) {
-            /* For a value with bits XXXAAABB BBBBCCCC CCDDDDDD we want 11110AAA 10BBBBBB 10CCCCCC 10DDDDDD */
-            ((uint8_t*)&c.raw)[0] = 0xF0 | (uint8_t)((value & 0x001C0000) >> 18) ; /* 11110AAA */
-            ((uint8_t*)&c.raw)[1] = 0x80 | (uint8_t)((value & 0x0003F000) >> 12); /* 10BBBBBB */
-            ((uint8_t*)&c.raw)[2] = 0x80 | (uint8_t)((value & 0x00000FC0) >> 6); /* 10CCCCCC */
-            ((uint8_t*)&c.raw)[3] = 0x80 | (uint8_t) (value & 0x0000003F); /* 10DDDDDD */
-            c.bytes = 4;
-        } else /* If the reference's value is not valid */
-            c.bytes = 0; /* Don't even try */
-        break;
-    case HOJSON_ENCODING_UTF_16_BE:
-        if (value <= 0x0000D7FF || (value >= 0x0000E000 && value <= 0x0000FFFF)) { /* If the value fits in two bytes */
-            ((uint8_t*)&c.raw)[0] = (uint8_t)((value & 0x0000FF00) >> 8);
-            ((uint8_t*)&c.raw)[1] = (uint8_t) (value & 0x000000FF);
-            c.bytes = 2;
-        } else if (value >= 0x00010000 && value <= 0x0010FFFF) { /* If the value fits in four bytes */
-            /* For a value - 0x00010000 with bits XXXXXXXX XXXXAABB BBBBBBCC DDDDDDDD we want to transform the bits */
-            /* to the form 110110AA BBBBBBBB 110111CC DDDDDDDD. When decoded, as per UTF-16, 0x00010000 is added. */
-            /* The prefixed "0xD8" and "0xDC" bitwise ORs prepend the UTF-16 markers 110110 and 110111, respectively. */
-            value -= 0x00010000;
-            ((uint8_t*)&c.raw)[0] = 0xD8 | (uint8_t)((value & 0x000C0000) >> 20); /* 110110AA */
-            ((uint8_t*)&c.raw)[1] =        (uint8_t)((value & 0x0003FC00) >> 18); /* BBBBBBBB */
-            ((uint8_t*)&c.raw)[2] = 0xDC | (uint8_t)((value & 0x00000300) >> 8); /* 110111CC */
-            ((uint8_t*)&c.raw)[3] =        (uint8_t) (value & 0x000000FF); /* DDDDDDDD */
-            c.bytes = 4;
-        } else /* If the reference's value is not valid */
-            c.bytes = 0; /* Don't even try */
-        break;
-    case HOJSON_ENCODING_UTF_16_LE:
-        /* UTF-16LE (Little Endian) is just like UTF-16BE (Big Endian) with the reverse endianness meaning that the */
-        /* operations here are identical to those above but the indexes have been changed to reflect endianness */
-        if (value <= 0x0000D7FF || (value >= 0x0000E000 && value <= 0x0000FFFF)) {
-            ((uint8_t*)&c.raw)[1] = (uint8_t)((value & 0x0000FF00) >> 8);
-            ((uint8_t*)&c.raw)[0] = (uint8_t) (value & 0x000000FF);
-            c.bytes = 2;
-        } else if (value >= 0x00010000 && value <= 0x0010FFFF) {
-            value -= 0x00010000;
-            ((uint8_t*)&c.raw)[3] = 0xD8 | (uint8_t)((value & 0x000C0000) >> 20); /* 110110AA */
-            ((uint8_t*)&c.raw)[2] =        (uint8_t)((value & 0x0003FC00) >> 18); /* BBBBBBBB */
-            ((uint8_t*)&c.raw)[1] = 0xDC | (uint8_t)((value & 0x00000300) >> 8); /* 110111CC */
-            ((uint8_t*)&c.raw)[0] =        (uint8_t) (value & 0x000000FF); /* DDDDDDDD */
-            c.bytes = 4;
-        } else
-            c.bytes = 0;
-        break;
+    case HOJSON_ENCODING_UTF_16_BE: return hojson_encode_utf16(value, 1);
+    case HOJSON_ENCODING_UTF_16_LE: return hojson_encode_utf16(value, 0);
+    default: return hojson_encode_utf8(value); /* If the encoding is somehow not specified, assume UTF-8 */
     }
-
-    return c;
 }
 
 uint32_t hojson_hex_character_to_decimal(uint32_t character) {
@@ -1170,6 +2061,1805 @@ uint32_t hojson_hex_character_to_decimal(uint32_t character) {
     }
 }
 
+HOJSON_DECL hojson_code_t hojson_validate(const char* json, const size_t json_length, uint32_t* max_depth) {
+    hojson_validator_t validator[1];
+    char stack[128]; /* 1024 levels */
+    hojson_validator_init(validator, stack, sizeof(stack));
+
+    hojson_code_t code = hojson_validate_chunk(validator, json, json_length);
+    if (max_depth != NULL)
+        *max_depth = validator->max_depth;
+    return code;
+}
+
+HOJSON_DECL void hojson_validator_init(hojson_validator_t* validator, char* buffer, const size_t buffer_length) {
+    if (validator == NULL || buffer == NULL || buffer_length <= 0)
+        return;
+
+    memset(validator, 0, sizeof(hojson_validator_t)); /* Assign all values of the validator to zero */
+    validator->stack = buffer;
+    validator->stack_length = buffer_length;
+    validator->is_initialized = 1;
+}
+
+HOJSON_DECL hojson_code_t hojson_validate_chunk(hojson_validator_t* validator, const char* json,
+        const size_t json_length) {
+    if (validator == NULL || validator->is_initialized == 0 || json == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    if (validator->state == HOJSON_STATE_DONE) /* If validation has already finished */
+        return HOJSON_END_OF_DOCUMENT;
+    else if (validator->state < HOJSON_STATE_NONE) /* If validation already failed */
+        return hojson_validator_error(validator);
+
+    /* This follows the same states and checks as hojson_parse() but nothing is appended to a buffer, no numbers */
+    /* are converted, and nothing is returned until the content runs out or the root closes */
+    /* When reformatting, UTF-8 content is written in runs, beginning at 'run', that are broken up wherever */
+    /* whitespace is removed or added. UTF-16 content is written a character at a time, as 'unit'. */
+    const char* iterator = json, *end = json + json_length, *run = json;
+    while (iterator < end) {
+        const char* character = iterator; /* Where the current character begins, for reporting the offset */
+        uint32_t c;
+        char unit[2];
+        uint8_t is_empty = 0; /* An object/array ended immediately after it began */
+        if (validator->encoding < HOJSON_ENCODING_UTF_16_LE) {
+            /* Every character with meaning to JSON is ASCII so UTF-8 can be validated a byte at a time. Within */
+            /* strings, only double quotes (") and backslashes (\) have meaning so skip everything in between. */
+            if ((validator->state == HOJSON_STATE_STRING_VALUE || validator->state == HOJSON_STATE_NAME) &&
+                    validator->carry_length == 0) {
+                iterator += hojson_string_length(iterator, (size_t)(end - iterator), HOJSON_DECODES_UTF8(validator));
+                if (iterator == end)
+                    break;
+                character = iterator;
+            }
+            if (HOJSON_DECODES_UTF8(validator) && (validator->carry_length > 0 || (uint8_t)*iterator >= 0x80)) {
+                /* Multi-byte characters are decoded exactly as hojson_parse() decodes them so that content it */
+                /* can't decode fails here, too, and the bytes may be split between two parts */
+                char bytes[4];
+                size_t carried = validator->carry_length;
+                size_t available = (size_t)(end - iterator) < 4 - carried ? (size_t)(end - iterator) : 4 - carried;
+                memcpy(bytes, validator->carry, carried);
+                memcpy(bytes + carried, iterator, available);
+                hojson_character_t decoded = hojson_decode_utf8(bytes, carried + available);
+                if (decoded.value == UINT32_MAX) { /* If the rest of the character is in the next part */
+                    memcpy(validator->carry + carried, iterator, available);
+                    validator->carry_length = (uint8_t)(carried + available);
+                    iterator += available;
+                    break;
+                }
+                if (decoded.bytes > 0) /* Otherwise, the value is zero and ends the content like a terminator */
+                    iterator += decoded.bytes - carried;
+                validator->carry_length = 0;
+                c = decoded.value;
+            } else
+                c = (uint8_t)*iterator++;
+        } else {
+            /* UTF-16 content is validated sixteen bits at a time. The bits may be split between two parts. */
+            uint8_t first, second;
+            if (validator->carry_length == 1) { /* If the first byte was at the end of the previous part */
+                first = (uint8_t)validator->carry[0];
+                second = (uint8_t)*iterator++;
+                validator->carry_length = 0;
+            } else if (end - iterator < 2) { /* If the second byte will be at the beginning of the next part */
+                validator->carry[0] = *iterator++;
+                validator->carry_length = 1;
+                break;
+            } else {
+                first = (uint8_t)iterator[0];
+                second = (uint8_t)iterator[1];
+                iterator += 2;
+            }
+            c = validator->encoding == HOJSON_ENCODING_UTF_16_BE ? ((uint32_t)first << 8) | second :
+                ((uint32_t)second << 8) | first;
+            unit[0] = (char)first;
+            unit[1] = (char)second;
+        }
+
+        if (c == 0) { /* A null terminator ends the content just like it does for hojson_parse() */
+            iterator = character;
+            break;
+        }
+
+        if (validator->state == HOJSON_STATE_NUMBER_VALUE) {
+            if (HOJSON_IS_NUMERIC(c))
+                continue;
+            else if (c == '.') {
+                if (validator->flags & HOJSON_FLAG_DECIMAL) /* If the number already has a decimal */
+                    validator->state = HOJSON_STATE_ERROR_SYNTAX;
+                validator->flags |= HOJSON_FLAG_DECIMAL;
+            } else if (c == 'e' || c == 'E') {
+                if (validator->flags & HOJSON_FLAG_EXPONENT) /* If the number already has an 'e' or 'E' */
+                    validator->state = HOJSON_STATE_ERROR_SYNTAX;
+                validator->flags |= HOJSON_FLAG_EXPONENT;
+            } else if (c == '-' || c == '+') {
+                /* If not preceded by an 'e' or 'E' or there was a previous '+' or '-' */
+                if (!(validator->flags & HOJSON_FLAG_EXPONENT) || validator->flags & HOJSON_FLAG_PLUS_OR_MINUS)
+                    validator->state = HOJSON_STATE_ERROR_SYNTAX;
+                validator->flags |= HOJSON_FLAG_PLUS_OR_MINUS;
+            } else if (HOJSON_IS_WHITESPACE(c) || c == ',' || c == ']' || c == '}') {
+                /* The number ended. Clear its flags and let the "post value" state handle this character. */
+                validator->flags &= ~(HOJSON_FLAG_DECIMAL | HOJSON_FLAG_EXPONENT | HOJSON_FLAG_PLUS_OR_MINUS);
+                validator->state = HOJSON_STATE_POST_VALUE;
+            } else
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+
+            if (validator->state == HOJSON_STATE_NUMBER_VALUE) {
+                if (validator->output != NULL && validator->encoding >= HOJSON_ENCODING_UTF_16_LE)
+                    hojson_writer_put(validator->output, unit, 2);
+                continue;
+            }
+        }
+
+        if (validator->output != NULL && validator->state >= HOJSON_STATE_NONE &&
+                validator->state != HOJSON_STATE_NAME && validator->state != HOJSON_STATE_STRING_VALUE &&
+                (validator->state < HOJSON_STATE_ESCAPE || validator->state > HOJSON_STATE_UNICODE_4)) {
+            if (HOJSON_IS_WHITESPACE(c)) { /* Whitespace between tokens is never copied */
+                hojson_scan_write(validator, &run, character);
+                run = iterator;
+                unit[0] = unit[1] = '\0'; /* Nothing to write for UTF-16 either */
+            } else if (validator->pending_newline) { /* If this is the first token after an object/array began */
+                validator->pending_newline = 0;
+                if (c == '}' || c == ']') /* Empty objects and arrays are kept on one line */
+                    is_empty = 1;
+                else {
+                    hojson_scan_write(validator, &run, character);
+                    hojson_scan_indent(validator, validator->depth);
+                }
+            }
+        }
+
+        switch (validator->state) {
+        case HOJSON_STATE_NONE: /* Initial state meaning no JSON content has been found yet */
+            if (c == '{' || c == '[')
+                goto begin_token;
+            else if (c == 0xEF && validator->encoding == HOJSON_ENCODING_UNKNOWN) /* UTF-8 BOM is [EF] BB BF */
+                validator->state = HOJSON_STATE_UTF8_BOM1;
+#ifndef HOJSON_UTF8_ONLY /* Otherwise, a UTF-16 byte order marker is a syntax error just as it is for parsing */
+            else if (c == 0xFE && validator->encoding == HOJSON_ENCODING_UNKNOWN) /* UTF-16BE BOM is [FE] FF */
+                validator->state = HOJSON_STATE_UTF16BE_BOM;
+            else if (c == 0xFF && validator->encoding == HOJSON_ENCODING_UNKNOWN) /* UTF-16LE BOM is [FF] FE */
+                validator->state = HOJSON_STATE_UTF16LE_BOM;
+#endif /* HOJSON_UTF8_ONLY */
+            else if (!HOJSON_IS_WHITESPACE(c))
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_UTF8_BOM1: /* The first byte of a UTF-8 byte order marker was found */
+            validator->state = c == 0xBB ? HOJSON_STATE_UTF8_BOM2 : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_UTF8_BOM2: /* The second byte of a UTF-8 byte order marker was found */
+            validator->state = c == 0xBF ? HOJSON_STATE_NONE : HOJSON_STATE_ERROR_SYNTAX;
+            validator->encoding = HOJSON_ENCODING_UTF_8;
+            break;
+#ifndef HOJSON_UTF8_ONLY
+        case HOJSON_STATE_UTF16BE_BOM: /* The first byte of a UTF-16BE byte order marker was found */
+        case HOJSON_STATE_UTF16LE_BOM: /* The first byte of a UTF-16LE byte order marker was found */
+            if (validator->state == HOJSON_STATE_UTF16BE_BOM) {
+                validator->state = c == 0xFF ? HOJSON_STATE_NONE : HOJSON_STATE_ERROR_SYNTAX;
+                validator->encoding = HOJSON_ENCODING_UTF_16_BE;
+            } else {
+                validator->state = c == 0xFE ? HOJSON_STATE_NONE : HOJSON_STATE_ERROR_SYNTAX;
+                validator->encoding = HOJSON_ENCODING_UTF_16_LE;
+            }
+            if (validator->output != NULL) { /* The marker is written as-is, everything after it as UTF-16 */
+                hojson_writer_put(validator->output, run, (size_t)(iterator - run));
+                validator->output->encoding = validator->encoding;
+                unit[0] = unit[1] = '\0';
+            } break;
+#endif /* HOJSON_UTF8_ONLY */
+        case HOJSON_STATE_NAME_EXPECTED: /* A name is expected due to beginning an object or finding a comma */
+            if (c == '"') {
+                validator->state = HOJSON_STATE_NAME;
+                break;
+            } else if (c == '}' || c == ']')
+                goto end_token;
+            else if (!HOJSON_IS_WHITESPACE(c))
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_NAME: /* A name was started by a double quote (") */
+        case HOJSON_STATE_STRING_VALUE: /* A double quote (") was found after a colon (:) or in an array */
+            if (c == '"')
+                validator->state = validator->state == HOJSON_STATE_NAME ? HOJSON_STATE_POST_NAME :
+                    HOJSON_STATE_POST_VALUE;
+            else if (c == '\\') { /* If a character is being escaped */
+                validator->escape_return_state = validator->state;
+                validator->state = HOJSON_STATE_ESCAPE;
+            } break;
+        case HOJSON_STATE_POST_NAME: /* A name was ended by a double quote (") and a colon (:) is expected */
+            if (c == ':') {
+                validator->state = HOJSON_STATE_VALUE_EXPECTED;
+                if (validator->output != NULL && validator->indent > 0) { /* Pretty-print with a space after */
+                    hojson_scan_write(validator, &run, iterator);
+                    if (validator->encoding >= HOJSON_ENCODING_UTF_16_LE)
+                        hojson_writer_put(validator->output, unit, 2);
+                    hojson_writer_put_ascii(validator->output, " ", 1);
+                    run = iterator;
+                    unit[0] = unit[1] = '\0';
+                }
+            } else if (!HOJSON_IS_WHITESPACE(c))
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_VALUE_EXPECTED: /* A value is expected due to a colon (:) or a comma (,) in an array */
+            if (c == '"')
+                validator->state = HOJSON_STATE_STRING_VALUE;
+            else if (HOJSON_IS_NUMERIC(c) || c == '-')
+                validator->state = HOJSON_STATE_NUMBER_VALUE;
+            else if (c == 't')
+                validator->state = HOJSON_STATE_TRUE_VALUE_T;
+            else if (c == 'f')
+                validator->state = HOJSON_STATE_FALSE_VALUE_F;
+            else if (c == 'n')
+                validator->state = HOJSON_STATE_NULL_VALUE_N;
+            else if (c == '{' || c == '[')
+                goto begin_token;
+            else if (c == '}' || c == ']')
+                goto end_token;
+            else if (!HOJSON_IS_WHITESPACE(c))
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_ESCAPE: /* A backslash (\) was found and an escaped or Unicode character is expected */
+            if (c == 'u')
+                validator->state = HOJSON_STATE_UNICODE_1;
+            else if (c == '"' || c == '\\' || c == '/' || c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't')
+                validator->state = validator->escape_return_state;
+            else
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_UNICODE_1: /* Unicode escapement notation was found, a hex number is expected */
+        case HOJSON_STATE_UNICODE_2:
+        case HOJSON_STATE_UNICODE_3:
+        case HOJSON_STATE_UNICODE_4:
+            if (!HOJSON_IS_HEX_CHAR(c))
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            else if (validator->state == HOJSON_STATE_UNICODE_4)
+                validator->state = validator->escape_return_state;
+            else
+                validator->state++;
+            break;
+        case HOJSON_STATE_TRUE_VALUE_T: /* The remaining characters of "true", "false", and "null" */
+            validator->state = c == 'r' ? HOJSON_STATE_TRUE_VALUE_R : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_TRUE_VALUE_R:
+            validator->state = c == 'u' ? HOJSON_STATE_TRUE_VALUE_U : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_TRUE_VALUE_U:
+            validator->state = c == 'e' ? HOJSON_STATE_POST_VALUE : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_FALSE_VALUE_F:
+            validator->state = c == 'a' ? HOJSON_STATE_FALSE_VALUE_A : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_FALSE_VALUE_A:
+            validator->state = c == 'l' ? HOJSON_STATE_FALSE_VALUE_L : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_FALSE_VALUE_L:
+            validator->state = c == 's' ? HOJSON_STATE_FALSE_VALUE_S : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_FALSE_VALUE_S:
+            validator->state = c == 'e' ? HOJSON_STATE_POST_VALUE : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_NULL_VALUE_N:
+            validator->state = c == 'u' ? HOJSON_STATE_NULL_VALUE_U : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_NULL_VALUE_U:
+            validator->state = c == 'l' ? HOJSON_STATE_NULL_VALUE_L : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_NULL_VALUE_L:
+            validator->state = c == 'l' ? HOJSON_STATE_POST_VALUE : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_POST_VALUE: /* A value was found, a comma (,) or closing token (} or ]) is expected */
+            validator->flags &= ~HOJSON_FLAG_COMMA; /* Any comma before the value has been followed by one */
+            if (c == '}' || c == ']')
+                goto end_token;
+            else if (c == ',') {
+                validator->flags |= HOJSON_FLAG_COMMA;
+                if (validator->output != NULL && validator->indent > 0) { /* Pretty-print with a line break after */
+                    hojson_scan_write(validator, &run, iterator);
+                    if (validator->encoding >= HOJSON_ENCODING_UTF_16_LE)
+                        hojson_writer_put(validator->output, unit, 2);
+                    hojson_scan_indent(validator, validator->depth);
+                    run = iterator;
+                    unit[0] = unit[1] = '\0';
+                }
+                if (validator->stack[(validator->depth - 1) / 8] & (1 << ((validator->depth - 1) % 8)))
+                    validator->state = HOJSON_STATE_VALUE_EXPECTED;
+                else
+                    validator->state = HOJSON_STATE_NAME_EXPECTED;
+            } else if (!HOJSON_IS_WHITESPACE(c))
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        begin_token: /* An object or array began */
+            if (validator->depth >= validator->stack_length * 8) /* If there's no bit left for this level */
+                validator->state = HOJSON_STATE_ERROR_INSUFFICIENT_MEMORY;
+            else {
+                if (c == '[')
+                    validator->stack[validator->depth / 8] |= (char)(1 << (validator->depth % 8));
+                else
+                    validator->stack[validator->depth / 8] &= (char)~(1 << (validator->depth % 8));
+                validator->depth++;
+                if (validator->depth > validator->max_depth)
+                    validator->max_depth = validator->depth;
+                validator->flags = 0; /* The new object or array begins without a comma */
+                validator->state = c == '[' ? HOJSON_STATE_VALUE_EXPECTED : HOJSON_STATE_NAME_EXPECTED;
+                validator->pending_newline = validator->output != NULL && validator->indent > 0;
+            } break;
+        end_token: { /* An object or array potentially ended */
+            uint8_t is_array = validator->stack[(validator->depth - 1) / 8] & (1 << ((validator->depth - 1) % 8));
+            if ((is_array && c != ']') || (!is_array && c != '}'))
+                validator->state = HOJSON_STATE_ERROR_TOKEN_MISMATCH;
+            else if (validator->flags & HOJSON_FLAG_COMMA) /* Trailing commas are not allowed */
+                validator->state = HOJSON_STATE_ERROR_SYNTAX;
+            else {
+                if (validator->output != NULL && validator->indent > 0 && !is_empty) { /* Line break before */
+                    hojson_scan_write(validator, &run, character);
+                    hojson_scan_indent(validator, validator->depth - 1);
+                }
+                validator->flags = 0; /* The object or array was a value of its parent which needs no comma yet */
+                validator->depth--;
+                validator->state = validator->depth == 0 ? HOJSON_STATE_DONE : HOJSON_STATE_POST_VALUE;
+            } } break;
+        }
+
+        if (validator->output != NULL) {
+            if (validator->encoding >= HOJSON_ENCODING_UTF_16_LE && (unit[0] != '\0' || unit[1] != '\0'))
+                hojson_writer_put(validator->output, unit, 2);
+            if (validator->output->state < HOJSON_STATE_NONE) /* If writing failed */
+                return hojson_writer_error(validator->output);
+        }
+
+        if (validator->state < HOJSON_STATE_NONE) { /* If the character led to an error */
+            validator->offset += (size_t)(character - json);
+            return hojson_validator_error(validator);
+        } else if (validator->state == HOJSON_STATE_DONE) {
+            validator->offset += (size_t)(iterator - json);
+            if (validator->output != NULL && hojson_scan_write(validator, &run, iterator) < HOJSON_NO_OP)
+                return hojson_writer_error(validator->output);
+            return HOJSON_END_OF_DOCUMENT;
+        }
+    }
+
+    validator->offset += (size_t)(iterator - json);
+    if (validator->output != NULL && hojson_scan_write(validator, &run, iterator) < HOJSON_NO_OP)
+        return hojson_writer_error(validator->output);
+    return HOJSON_ERROR_UNEXPECTED_EOF;
+}
+
+HOJSON_DECL void hojson_reformatter_init(hojson_validator_t* validator, char* buffer, const size_t buffer_length,
+        hojson_writer_t* writer, uint8_t indent) {
+    hojson_validator_init(validator, buffer, buffer_length);
+    if (validator == NULL || writer == NULL || writer->is_initialized == 0)
+        return;
+
+    validator->output = writer;
+    validator->indent = indent;
+}
+
+HOJSON_DECL hojson_code_t hojson_reformat_chunk(hojson_validator_t* validator, const char* json,
+        const size_t json_length) {
+    if (validator == NULL || validator->output == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+    return hojson_validate_chunk(validator, json, json_length);
+}
+
+HOJSON_DECL void hojson_splitter_init(hojson_splitter_t* splitter) {
+    if (splitter == NULL)
+        return;
+
+    memset(splitter, 0, sizeof(hojson_splitter_t)); /* Assign all values of the splitter to zero */
+    splitter->is_initialized = 1;
+}
+
+HOJSON_DECL hojson_code_t hojson_split_array(hojson_splitter_t* splitter, const char* json, const size_t json_length,
+        hojson_element_t callback, void* user_data) {
+    if (splitter == NULL || splitter->is_initialized == 0 || json == NULL || callback == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    if (splitter->state == HOJSON_STATE_DONE) /* If the root array has already closed */
+        return HOJSON_END_OF_DOCUMENT;
+    else if (splitter->state < HOJSON_STATE_NONE) /* If splitting already failed */
+        return hojson_splitter_error(splitter);
+
+    /* Offsets are counted from the beginning of the first part, 'offset' being where this part begins */
+    const char* iterator = json, *end = json + json_length;
+    while (iterator < end) {
+        const char* character = iterator++;
+        char c = *character;
+        switch (splitter->state) {
+        case HOJSON_STATE_NONE: /* Nothing but whitespace, or a UTF-8 byte order marker, may come before the root */
+            if (c == '[') {
+                splitter->depth = 1;
+                splitter->state = HOJSON_STATE_VALUE_EXPECTED;
+            } else if ((uint8_t)c == 0xEF && splitter->offset + (size_t)(character - json) == 0)
+                splitter->state = HOJSON_STATE_UTF8_BOM1;
+            else if (!HOJSON_IS_WHITESPACE(c))
+                splitter->state = HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_UTF8_BOM1: /* The UTF-8 BOM is EF [BB] BF, as hex bytes */
+            splitter->state = (uint8_t)c == 0xBB ? HOJSON_STATE_UTF8_BOM2 : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_UTF8_BOM2: /* The UTF-8 BOM is EF BB [BF], as hex bytes */
+            splitter->state = (uint8_t)c == 0xBF ? HOJSON_STATE_NONE : HOJSON_STATE_ERROR_SYNTAX;
+            break;
+        case HOJSON_STATE_STRING_VALUE: /* Skip to the string's end or the next escape */
+            iterator = character + hojson_string_length(character, (size_t)(end - character), 0);
+            if (iterator == end)
+                break;
+            if (*iterator == '"')
+                splitter->state = HOJSON_STATE_VALUE_EXPECTED;
+            else if (*iterator == '\\')
+                splitter->state = HOJSON_STATE_ESCAPE;
+            iterator++;
+            splitter->element_end = splitter->offset + (size_t)(iterator - json);
+            break;
+        case HOJSON_STATE_ESCAPE: /* Whatever follows a backslash can't end the string */
+            splitter->state = HOJSON_STATE_STRING_VALUE;
+            break;
+        case HOJSON_STATE_VALUE_EXPECTED: /* In the root array, between elements or in one */
+            if (HOJSON_IS_WHITESPACE(c))
+                break;
+            else if (splitter->depth == 1 && (c == ',' || c == ']' || c == '}')) { /* If an element ended */
+                if (c == '}' || (splitter->has_element == 0 && (c == ',' || splitter->element_count > 0)))
+                    splitter->state = HOJSON_STATE_ERROR_SYNTAX; /* A mismatch, missing element, or extra comma */
+                else if (splitter->has_element) {
+                    splitter->has_element = 0;
+                    splitter->element_count++;
+                    if (callback(user_data, splitter->element_begin, splitter->element_end) != 0)
+                        splitter->state = HOJSON_STATE_ERROR_IO;
+                }
+                if (c == ']' && splitter->state >= HOJSON_STATE_NONE) {
+                    splitter->depth = 0;
+                    splitter->state = HOJSON_STATE_DONE;
+                }
+                break;
+            } else if (splitter->depth == 1 && splitter->has_element == 0) { /* If an element began */
+                splitter->has_element = 1;
+                splitter->element_begin = splitter->offset + (size_t)(character - json);
+            }
+
+            if (c == '"')
+                splitter->state = HOJSON_STATE_STRING_VALUE;
+            else if (c == '{' || c == '[')
+                splitter->depth++;
+            else if (c == '}' || c == ']')
+                splitter->depth--;
+            splitter->element_end = splitter->offset + (size_t)(iterator - json);
+            break;
+        }
+
+        if (splitter->state < HOJSON_STATE_NONE) { /* If the character led to an error */
+            splitter->offset += (size_t)(character - json);
+            return hojson_splitter_error(splitter);
+        } else if (splitter->state == HOJSON_STATE_DONE) {
+            splitter->offset += (size_t)(iterator - json);
+            return HOJSON_END_OF_DOCUMENT;
+        }
+    }
+
+    splitter->offset += (size_t)(iterator - json);
+    return HOJSON_ERROR_UNEXPECTED_EOF;
+}
+
+HOJSON_DECL size_t hojson_format_double(double value, char* str) {
+    if (str == NULL)
+        return 0;
+
+    /* Split the IEEE 754 binary64 representation into its sign, biased exponent, and fraction */
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint8_t is_negative = (uint8_t)(bits >> 63);
+    uint32_t biased_exponent = (uint32_t)(bits >> 52) & 0x7FF;
+    uint64_t fraction = bits & ((((uint64_t)1) << 52) - 1);
+
+    char* iterator = str;
+    if (biased_exponent == 0x7FF) { /* NaN and the infinities have every exponent bit set */
+        const char* name = fraction != 0 ? "NaN" : (is_negative ? "-Infinity" : "Infinity");
+        size_t name_length = strlen(name);
+        memcpy(str, name, name_length + 1);
+        return name_length;
+    }
+    if (is_negative)
+        *iterator++ = '-';
+    if (biased_exponent == 0 && fraction == 0) { /* Zero */
+        *iterator++ = '0';
+        *iterator = '\0';
+        return (size_t)(iterator - str);
+    }
+
+    /* Find the shortest digits, as an integer, and the power of ten they're multiplied by */
+    int32_t decimal_exponent;
+    uint64_t digits = hojson_shortest_digits(fraction, (int32_t)biased_exponent, &decimal_exponent);
+    char buffer[20], *end = buffer + sizeof(buffer), *first = end; /* Digits are placed from the end, backward */
+    while (digits >= 100) { /* Two digits at a time */
+        uint32_t pair = (uint32_t)(digits % 100) * 2;
+        digits /= 100;
+        *--first = hojson_digit_pairs[pair + 1];
+        *--first = hojson_digit_pairs[pair];
+    }
+    if (digits >= 10) {
+        *--first = hojson_digit_pairs[digits * 2 + 1];
+        *--first = hojson_digit_pairs[digits * 2];
+    } else
+        *--first = (char)('0' + digits);
+    int32_t digit_count = (int32_t)(end - first);
+
+    /* With 'point' being the position of the decimal point relative to the first digit, place the digits the same */
+    /* way JavaScript does: plainly for points in the (-6, 21] range and with exponent notation otherwise */
+    int32_t point = decimal_exponent + digit_count;
+    if (point >= digit_count && point <= 21) { /* Integers, padded with trailing zeroes */
+        memcpy(iterator, first, digit_count);
+        memset(iterator + digit_count, '0', point - digit_count);
+        iterator += point;
+    } else if (point > 0 && point <= 21) { /* Decimals with at least one digit before the point */
+        memcpy(iterator, first, point);
+        iterator[point] = '.';
+        memcpy(iterator + point + 1, first + point, digit_count - point);
+        iterator += digit_count + 1;
+    } else if (point > -6 && point <= 0) { /* Decimals below one, padded with leading zeroes */
+        iterator[0] = '0';
+        iterator[1] = '.';
+        memset(iterator + 2, '0', -point);
+        memcpy(iterator + 2 - point, first, digit_count);
+        iterator += 2 - point + digit_count;
+    } else { /* Exponent notation with one digit before the point */
+        *iterator++ = first[0];
+        if (digit_count > 1) {
+            *iterator++ = '.';
+            memcpy(iterator, first + 1, digit_count - 1);
+            iterator += digit_count - 1;
+        }
+        int32_t exponent = point - 1 < 0 ? 1 - point : point - 1; /* At most 324 */
+        *iterator++ = 'e';
+        *iterator++ = point - 1 < 0 ? '-' : '+';
+        if (exponent >= 100) {
+            *iterator++ = (char)('0' + exponent / 100);
+            exponent %= 100;
+            *iterator++ = hojson_digit_pairs[exponent * 2];
+            *iterator++ = hojson_digit_pairs[exponent * 2 + 1];
+        } else if (exponent >= 10) {
+            *iterator++ = hojson_digit_pairs[exponent * 2];
+            *iterator++ = hojson_digit_pairs[exponent * 2 + 1];
+        } else
+            *iterator++ = (char)('0' + exponent);
+    }
+
+    *iterator = '\0';
+    return (size_t)(iterator - str);
+}
+
+HOJSON_DECL void hojson_writer_init(hojson_writer_t* writer, char* buffer, const size_t buffer_length,
+        hojson_encoding_t encoding, hojson_flush_t flush, void* user_data) {
+    if (writer == NULL || buffer == NULL || buffer_length <= 0)
+        return;
+
+    memset(writer, 0, sizeof(hojson_writer_t)); /* Assign all values of the writer to zero */
+    writer->buffer = buffer; /* Use the provided buffer */
+    writer->buffer_length = buffer_length; /* Remember the length of the provided buffer */
+    writer->encoding = encoding == HOJSON_ENCODING_UNKNOWN ? HOJSON_ENCODING_UTF_8 : encoding;
+    writer->flush = flush;
+    writer->user_data = user_data;
+    writer->state = HOJSON_STATE_NONE;
+    writer->is_initialized = 1;
+}
+
+HOJSON_DECL hojson_code_t hojson_write_object_begin(hojson_writer_t* writer, const char* name) {
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 1);
+    if (code < HOJSON_NO_OP)
+        return code;
+
+    writer->nesting[writer->depth / 8] &= ~(1 << (writer->depth % 8)); /* Mark the new level as an object */
+    writer->depth++;
+    writer->needs_comma = 0; /* The first pair of the object won't be preceded by a comma */
+    return hojson_writer_put_ascii(writer, "{", 1);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_object_end(hojson_writer_t* writer) {
+    return hojson_writer_end_container(writer, 0);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_array_begin(hojson_writer_t* writer, const char* name) {
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 1);
+    if (code < HOJSON_NO_OP)
+        return code;
+
+    writer->nesting[writer->depth / 8] |= (1 << (writer->depth % 8)); /* Mark the new level as an array */
+    writer->depth++;
+    writer->needs_comma = 0; /* The first value of the array won't be preceded by a comma */
+    return hojson_writer_put_ascii(writer, "[", 1);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_array_end(hojson_writer_t* writer) {
+    return hojson_writer_end_container(writer, 1);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_string(hojson_writer_t* writer, const char* name, const char* value) {
+    if (value == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 0);
+    if (code < HOJSON_NO_OP)
+        return code;
+    return hojson_writer_put_string(writer, value, strlen(value));
+}
+
+HOJSON_DECL hojson_code_t hojson_write_integer(hojson_writer_t* writer, const char* name, long value) {
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 0);
+    if (code < HOJSON_NO_OP)
+        return code;
+
+    char digits[24]; /* Enough for the sign and digits of a 64-bit integer */
+    return hojson_writer_put_ascii(writer, digits, hojson_format_integer(value, digits));
+}
+
+HOJSON_DECL hojson_code_t hojson_write_float(hojson_writer_t* writer, const char* name, double value) {
+    /* JSON has no representation of NaN or the infinities. NaN is the only value not equal to itself and the */
+    /* infinities are the only values that don't result in zero when subtracted from themselves. */
+    if (value != value || value - value != 0.0)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 0);
+    if (code < HOJSON_NO_OP)
+        return code;
+
+    char digits[HOJSON_FORMAT_DOUBLE_LENGTH + 2];
+    size_t length = hojson_format_double(value, digits);
+
+    /* The parser treats numbers without a decimal or exponent as integers so make sure one of the two is present */
+    if (strpbrk(digits, ".e") == NULL) {
+        digits[length++] = '.';
+        digits[length++] = '0';
+    }
+    return hojson_writer_put_ascii(writer, digits, length);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_boolean(hojson_writer_t* writer, const char* name, uint8_t value) {
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 0);
+    if (code < HOJSON_NO_OP)
+        return code;
+    return value ? hojson_writer_put_ascii(writer, "true", 4) : hojson_writer_put_ascii(writer, "false", 5);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_null(hojson_writer_t* writer, const char* name) {
+    hojson_code_t code = hojson_writer_begin_value(writer, name, 0);
+    if (code < HOJSON_NO_OP)
+        return code;
+    return hojson_writer_put_ascii(writer, "null", 4);
+}
+
+HOJSON_DECL hojson_code_t hojson_write_flush(hojson_writer_t* writer) {
+    if (writer == NULL || writer->is_initialized == 0)
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (writer->state < HOJSON_STATE_NONE)
+        return hojson_writer_error(writer);
+
+    if (writer->buffer_used > 0) { /* If there's anything to hand off */
+        if (writer->flush == NULL || writer->flush(writer->user_data, writer->buffer, writer->buffer_used) != 0) {
+            writer->state = writer->flush == NULL ? HOJSON_STATE_ERROR_INSUFFICIENT_MEMORY : HOJSON_STATE_ERROR_IO;
+            return hojson_writer_error(writer);
+        }
+        writer->buffer_used = 0;
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_writer_put(hojson_writer_t* writer, const char* data, size_t length) {
+    while (length > 0) {
+        if (writer->buffer_used == writer->buffer_length) { /* If the buffer is full */
+            hojson_code_t code = hojson_write_flush(writer);
+            if (code < HOJSON_NO_OP)
+                return code;
+        }
+
+        size_t bytes_to_copy = writer->buffer_length - writer->buffer_used;
+        if (bytes_to_copy > length)
+            bytes_to_copy = length;
+        memcpy(writer->buffer + writer->buffer_used, data, bytes_to_copy);
+        writer->buffer_used += bytes_to_copy;
+        data += bytes_to_copy;
+        length -= bytes_to_copy;
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_writer_put_ascii(hojson_writer_t* writer, const char* str, size_t str_length) {
+    if (writer->encoding == HOJSON_ENCODING_UTF_8) /* ASCII is a subset of UTF-8 so no conversion is needed */
+        return hojson_writer_put(writer, str, str_length);
+
+    /* Widen each character to sixteen bits, in batches, for UTF-16 */
+    char wide[64];
+    while (str_length > 0) {
+        size_t i, batch_length = str_length < sizeof(wide) / 2 ? str_length : sizeof(wide) / 2;
+        for (i = 0; i < batch_length; i++) {
+            wide[i * 2 + (writer->encoding == HOJSON_ENCODING_UTF_16_LE ? 0 : 1)] = str[i];
+            wide[i * 2 + (writer->encoding == HOJSON_ENCODING_UTF_16_LE ? 1 : 0)] = '\0';
+        }
+        hojson_code_t code = hojson_writer_put(writer, wide, batch_length * 2);
+        if (code < HOJSON_NO_OP)
+            return code;
+        str += batch_length;
+        str_length -= batch_length;
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_writer_put_string(hojson_writer_t* writer, const char* str, size_t str_length) {
+    hojson_code_t code = hojson_writer_put_ascii(writer, "\"", 1);
+
+    while (str_length > 0 && code >= HOJSON_NO_OP) {
+        /* Characters needing no escape are checked and copied in runs when the output is UTF-8 */
+        if (writer->encoding == HOJSON_ENCODING_UTF_8) {
+            size_t run_length = hojson_escape_free_length(str, str_length);
+            if (run_length > 0) {
+                code = hojson_writer_put(writer, str, run_length);
+                str += run_length;
+                str_length -= run_length;
+                continue;
+            }
+        }
+
+        /* Decode a single character once it's known to be well-formed. hojson_decode_utf8() doesn't check. */
+        if (hojson_utf8_length(str, str_length) == 0) {
+            /* The string may have been partly written and can't be finished so no more content may follow it */
+            writer->state = HOJSON_STATE_ERROR_INVALID_INPUT;
+            return HOJSON_ERROR_INVALID_INPUT;
+        }
+        hojson_character_t c = hojson_decode_utf8(str, str_length);
+        str += c.bytes;
+        str_length -= c.bytes;
+
+        char escape[6];
+        switch (c.value) {
+        case '"':  code = hojson_writer_put_ascii(writer, "\\\"", 2); break;
+        case '\\': code = hojson_writer_put_ascii(writer, "\\\\", 2); break;
+        case '\b': code = hojson_writer_put_ascii(writer, "\\b", 2); break;
+        case '\f': code = hojson_writer_put_ascii(writer, "\\f", 2); break;
+        case '\n': code = hojson_writer_put_ascii(writer, "\\n", 2); break;
+        case '\r': code = hojson_writer_put_ascii(writer, "\\r", 2); break;
+        case '\t': code = hojson_writer_put_ascii(writer, "\\t", 2); break;
+        default:
+            if (c.value < 0x20) { /* Remaining control characters are written with Unicode escapement notation */
+                escape[0] = '\\';
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = "0123456789ABCDEF"[c.value >> 4];
+                escape[5] = "0123456789ABCDEF"[c.value & 0x0F];
+                code = hojson_writer_put_ascii(writer, escape, 6);
+            } else { /* Re-encode the character in the writer's encoding */
+                c = hojson_encode_character(c.value, writer->encoding);
+                code = hojson_writer_put(writer, (const char*)&(c.raw), c.bytes);
+            } break;
+        }
+    }
+
+    return code < HOJSON_NO_OP ? code : hojson_writer_put_ascii(writer, "\"", 1);
+}
+
+hojson_code_t hojson_writer_begin_value(hojson_writer_t* writer, const char* name, uint8_t is_container) {
+    if (writer == NULL || writer->is_initialized == 0)
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (writer->state < HOJSON_STATE_NONE)
+        return hojson_writer_error(writer);
+    else if (writer->state == HOJSON_STATE_DONE) /* Only one root object or array may be written */
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    if (writer->depth == 0) { /* If writing the root, it must be an unnamed object or array */
+        if (name != NULL || !is_container)
+            return HOJSON_ERROR_INVALID_INPUT;
+    } else if (writer->nesting[(writer->depth - 1) / 8] & (1 << ((writer->depth - 1) % 8))) {
+        if (name != NULL) /* Array values don't have names */
+            return HOJSON_ERROR_INVALID_INPUT;
+    } else if (name == NULL) /* Object members must have names */
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    if (is_container && writer->depth >= HOJSON_WRITER_MAX_DEPTH) /* If there's no room to track another level */
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+
+    hojson_code_t code = HOJSON_NO_OP;
+    if (writer->depth == 0 && writer->encoding != HOJSON_ENCODING_UTF_8) { /* UTF-16 requires a byte order marker */
+        if (writer->encoding == HOJSON_ENCODING_UTF_16_BE)
+            code = hojson_writer_put(writer, "\xFE\xFF", 2);
+        else
+            code = hojson_writer_put(writer, "\xFF\xFE", 2);
+    }
+    if (writer->needs_comma && code >= HOJSON_NO_OP)
+        code = hojson_writer_put_ascii(writer, ",", 1);
+    if (name != NULL && code >= HOJSON_NO_OP) {
+        code = hojson_writer_put_string(writer, name, strlen(name));
+        if (code >= HOJSON_NO_OP)
+            code = hojson_writer_put_ascii(writer, ":", 1);
+    }
+
+    writer->needs_comma = 1; /* Whatever follows this value at the same depth must be preceded by a comma */
+    return code;
+}
+
+hojson_code_t hojson_writer_end_container(hojson_writer_t* writer, uint8_t is_array) {
+    if (writer == NULL || writer->is_initialized == 0)
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (writer->state < HOJSON_STATE_NONE)
+        return hojson_writer_error(writer);
+    else if (writer->depth == 0) /* If there's nothing to end */
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if ((writer->nesting[(writer->depth - 1) / 8] & (1 << ((writer->depth - 1) % 8)) ? 1 : 0) != is_array)
+        return HOJSON_ERROR_TOKEN_MISMATCH; /* If a '{' would be closed by a ']' or a '[' by a '}' */
+
+    hojson_code_t code = hojson_writer_put_ascii(writer, is_array ? "]" : "}", 1);
+    if (code < HOJSON_NO_OP)
+        return code;
+
+    writer->depth--;
+    writer->needs_comma = 1; /* The container just closed was a value of its parent */
+    if (writer->depth == 0) { /* If the root closed */
+        writer->state = HOJSON_STATE_DONE;
+        return HOJSON_END_OF_DOCUMENT;
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_writer_error(hojson_writer_t* writer) {
+    switch (writer->state) {
+    case HOJSON_STATE_ERROR_IO: return HOJSON_ERROR_IO;
+    case HOJSON_STATE_ERROR_INVALID_INPUT: return HOJSON_ERROR_INVALID_INPUT;
+    case HOJSON_STATE_ERROR_INSUFFICIENT_MEMORY: return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    default: return HOJSON_ERROR_INTERNAL;
+    }
+}
+
+size_t hojson_format_integer(long value, char* str) {
+    /* Digits are produced two at a time, from least to most significant, using the table of all pairs */
+    char reversed[24], *end = reversed + sizeof(reversed), *iterator = end;
+    /* The magnitude is taken as unsigned so the most negative value doesn't overflow */
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+
+    while (magnitude >= 100) {
+        unsigned long pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        *--iterator = hojson_digit_pairs[pair + 1];
+        *--iterator = hojson_digit_pairs[pair];
+    }
+    if (magnitude >= 10) {
+        *--iterator = hojson_digit_pairs[magnitude * 2 + 1];
+        *--iterator = hojson_digit_pairs[magnitude * 2];
+    } else
+        *--iterator = (char)('0' + magnitude);
+    if (value < 0)
+        *--iterator = '-';
+
+    memcpy(str, iterator, end - iterator);
+    return (size_t)(end - iterator);
+}
+
+uint64_t hojson_shortest_digits(uint64_t fraction, int32_t biased_exponent, int32_t* decimal_exponent) {
+    /* This is the Ryu algorithm by Ulf Adams (https://github.com/ulfjack/ryu). The value is m2 * 2^e2. Its */
+    /* neighbors' halfway points, mm (below) and mp (above), bound the interval of decimals that read back as the */
+    /* value. The interval is scaled by a power of ten, 10^e10, chosen so the decimals of interest are integers */
+    /* no longer than 17 digits and then digits are removed for as long as the interval still holds a decimal. */
+    int32_t e2;
+    uint64_t m2;
+
+    /* Integers below 2^53 are their own shortest digits, once trailing zeroes are removed */
+    if (biased_exponent >= 1023 && biased_exponent <= 1023 + 52) {
+        m2 = (((uint64_t)1) << 52) | fraction;
+        e2 = 1023 + 52 - biased_exponent; /* The number of fractional bits */
+        if ((m2 & ((((uint64_t)1) << e2) - 1)) == 0) { /* If none of the fractional bits are set */
+            m2 >>= e2;
+            *decimal_exponent = 0;
+            while (m2 % 10 == 0) {
+                m2 /= 10;
+                (*decimal_exponent)++;
+            }
+            return m2;
+        }
+    }
+
+    if (biased_exponent == 0) { /* Subnormal numbers */
+        e2 = 1 - 1023 - 52 - 2; /* The extra 2 makes room for the halfway points with four times the mantissa */
+        m2 = fraction;
+    } else {
+        e2 = biased_exponent - 1023 - 52 - 2;
+        m2 = (((uint64_t)1) << 52) | fraction;
+    }
+    uint8_t accept_bounds = (m2 & 1) == 0; /* Halfway points read back as the value when rounding to even */
+    uint64_t mv = 4 * m2;
+    /* The gap to the lower neighbor is half as large when the value is a power of two (other than the smallest) */
+    uint32_t mm_shift = fraction != 0 || biased_exponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    uint8_t vm_is_trailing_zeros = 0, vr_is_trailing_zeros = 0;
+    if (e2 >= 0) {
+        /* log10(2^e2), less one for e2 > 3 so the scaled values keep enough digits */
+        int32_t q = (int32_t)(((uint32_t)e2 * 78913) >> 18) - (e2 > 3);
+        /* bits(5^q), which the table of inverse powers of five was scaled by, sets the shift */
+        int32_t k = 125 + (int32_t)((((uint32_t)q * 1217359) >> 19) + 1) - 1;
+        int32_t shift = -e2 + q + k;
+        e10 = q;
+        vr = hojson_multiply_shift(4 * m2, q, 1, shift);
+        vp = hojson_multiply_shift(4 * m2 + 2, q, 1, shift);
+        vm = hojson_multiply_shift(4 * m2 - 1 - mm_shift, q, 1, shift);
+        if (q <= 21) { /* Only small powers of ten can leave the scaled values exact */
+            if (mv % 5 == 0)
+                vr_is_trailing_zeros = hojson_factors_of_five(mv) >= (uint32_t)q;
+            else if (accept_bounds)
+                vm_is_trailing_zeros = hojson_factors_of_five(mv - 1 - mm_shift) >= (uint32_t)q;
+            else
+                vp -= hojson_factors_of_five(mv + 2) >= (uint32_t)q;
+        }
+    } else {
+        /* log10(5^-e2), less one for -e2 > 1 */
+        int32_t q = (int32_t)(((uint32_t)-e2 * 732923) >> 20) - (-e2 > 1);
+        int32_t i = -e2 - q;
+        int32_t k = (int32_t)((((uint32_t)i * 1217359) >> 19) + 1) - 125;
+        int32_t shift = q - k;
+        e10 = q + e2;
+        vr = hojson_multiply_shift(4 * m2, i, 0, shift);
+        vp = hojson_multiply_shift(4 * m2 + 2, i, 0, shift);
+        vm = hojson_multiply_shift(4 * m2 - 1 - mm_shift, i, 0, shift);
+        if (q <= 1) {
+            vr_is_trailing_zeros = 1; /* mv has at least q trailing binary zeroes */
+            if (accept_bounds)
+                vm_is_trailing_zeros = mm_shift == 1;
+            else
+                vp--; /* mp is excluded so step down from it */
+        } else if (q < 63)
+            vr_is_trailing_zeros = (mv & ((((uint64_t)1) << q) - 1)) == 0;
+    }
+
+    /* Remove digits while the interval (vm, vp) still contains a decimal with fewer digits */
+    int32_t removed = 0;
+    uint8_t last_removed_digit = 0;
+    uint64_t output;
+    if (vm_is_trailing_zeros || vr_is_trailing_zeros) { /* Uncommon case where the exact values matter */
+        while (vp / 10 > vm / 10) {
+            vm_is_trailing_zeros &= vm % 10 == 0;
+            vr_is_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_is_trailing_zeros) { /* The lower bound is itself a shorter decimal */
+            while (vm % 10 == 0) {
+                vr_is_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0)
+            last_removed_digit = 4; /* Exactly halfway so round to even */
+        output = vr + ((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5);
+    } else { /* Common case */
+        uint8_t round_up = 0;
+        if (vp / 100 > vm / 100) { /* Remove two digits at once when possible, most values have several to remove */
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+
+    *decimal_exponent = e10 + removed;
+    return output;
+}
+
+uint64_t hojson_multiply_shift(uint64_t m, int32_t power, uint8_t is_inverse, int32_t shift) {
+    /* Computes (m * 5^power) >> shift, or (m / 5^power) >> shift, where the power of five is a 125-bit value */
+    /* taken from one of the tables below. Those tables are stored as four 32-bit words, least significant first. */
+    static const uint32_t inverse_powers_of_five[292][4] = { /* floor(2^(bits(5^q) + 124) / 5^q) + 1 */
+        { 0x00000001u, 0x00000000u, 0x00000000u, 0x20000000u },
+        { 0x9999999Au, 0x99999999u, 0x99999999u, 0x19999999u },
+        { 0xE147AE15u, 0x47AE147Au, 0xAE147AE1u, 0x147AE147u },
+        { 0x810624DEu, 0x6C8B4395u, 0xF1A9FBE7u, 0x10624DD2u },
+        { 0x6809D496u, 0x7A786C22u, 0x1C432CA5u, 0x1A36E2EBu },
+        { 0x866E43ABu, 0x61F9F01Bu, 0xE368F084u, 0x14F8B588u },
+        { 0x38583622u, 0xB4C7F349u, 0xB5ED8D36u, 0x10C6F7A0u },
+        { 0xC08D236Au, 0x87A6520Eu, 0xBCAF4857u, 0x1AD7F29Au },
+        { 0x66D74F88u, 0x9FB841A5u, 0x308C39DFu, 0x15798EE2u },
+        { 0x1F12A607u, 0xE62D0151u, 0x26D694B2u, 0x112E0BE8u },
+        { 0xCB5109A4u, 0xD6AE6881u, 0xD7BDBAB7u, 0x1B7CDFD9u },
+        { 0xA2A73AEAu, 0xDEF1ED34u, 0x7964955Fu, 0x15FD7FE1u },
+        { 0xE885C8BBu, 0x7F27F0F6u, 0x2DEA1119u, 0x11979981u },
+        { 0x40D60DF8u, 0x650CB4BEu, 0x497681C2u, 0x1C25C268u },
+        { 0x33DE7193u, 0xEA709098u, 0xA12B9B01u, 0x16849B86u },
+        { 0x297EC143u, 0x21F3A6E0u, 0xE756159Bu, 0x1203AF9Eu },
+        { 0x0F313537u, 0x6985D7CDu, 0xD889BC2Bu, 0x1CD2B297u },
+        { 0x3F5A90F9u, 0x2137DFD7u, 0x46D49689u, 0x170EF546u },
+        { 0xCC4873FAu, 0xE75FE645u, 0xD243ABA0u, 0x12725DD1u },
+        { 0x7A0D865Du, 0xA5663D3Cu, 0xB6D2AC34u, 0x1D83C94Fu },
+        { 0x94D79EB1u, 0x511E9763u, 0x9242235Du, 0x179CA10Cu },
+        { 0xDD794BC1u, 0xDA7EDF82u, 0x0E9B4F7Du, 0x12E3B40Au },
+        { 0x625BAC68u, 0x2A6498D1u, 0x175EE596u, 0x1E392010u },
+        { 0x81E2F053u, 0xEEB6E0A7u, 0x12B25144u, 0x182DB340u },
+        { 0xCE4F26A9u, 0x58924D52u, 0xA88EA76Au, 0x1357C299u },
+        { 0xB07EA441u, 0x27507BB7u, 0xDA7DD8AAu, 0x1EF2D0F5u },
+        { 0xC0655034u, 0x52A6C95Fu, 0xAECB13BBu, 0x18C240C4u },
+        { 0x99EAA690u, 0x0EEBD44Cu, 0xF23C0FC9u, 0x13CE9A36u },
+        { 0xC3110A80u, 0xB17953ADu, 0x50601941u, 0x1FB0F6BEu },
+        { 0x02740867u, 0xC12DDC8Bu, 0xA6B34767u, 0x195A5EFEu },
+        { 0x3529A052u, 0x3424B06Fu, 0xEBC29F86u, 0x14484BFEu },
+        { 0x90EE19DBu, 0x901D59F2u, 0x89687F9Eu, 0x1039D665u },
+        { 0xB4B0295Fu, 0x4CFBC31Du, 0xA8A73297u, 0x19F623D5u },
+        { 0x5D59BAB2u, 0x3D9635B1u, 0xBA1F5BACu, 0x14C4E977u },
+        { 0x7DE16228u, 0x97AB5E27u, 0xFB4C4956u, 0x109D8792u },
+        { 0xC9689D0Du, 0xF2ABC9D8u, 0xF87A0EF0u, 0x1A95A5B7u },
+        { 0x3ABA173Eu, 0x5BBCA17Au, 0x2D2E725Au, 0x15448493u },
+        { 0x2EFB45CBu, 0xAFCA1AC8u, 0x8A8B8EAEu, 0x11039D42u },
+        { 0xB1920945u, 0xB2DCF7A6u, 0xAA78E44Au, 0x1B38FB9Du },
+        { 0xC141A104u, 0xF57D92EBu, 0x552D836Eu, 0x15C72FB1u },
+        { 0x6767B403u, 0xC4647589u, 0x77579C58u, 0x116C2627u },
+        { 0xD8A5ECD2u, 0x6D6D88DBu, 0xF225C6F4u, 0x1BE03D0Bu },
+        { 0x46EB23DBu, 0x8ABE0716u, 0x281E38C3u, 0x164CFDA3u },
+        { 0xD255B649u, 0x6EFE6C11u, 0x534B609Cu, 0x11D7314Fu },
+        { 0xB6EF8A0Eu, 0xB197134Fu, 0x85456760u, 0x1C8B8218u },
+        { 0xF8BFA1A5u, 0x27AC0F72u, 0x376AB91Au, 0x16D601ADu },
+        { 0x60994E1Eu, 0xB95672C2u, 0x2C5560E1u, 0x1244CE24u },
+        { 0xCDC21695u, 0xF5571E03u, 0x13BBCE35u, 0x1D3AE36Du },
+        { 0x0B01ABABu, 0x2AAC1803u, 0x762FD82Bu, 0x17624F8Au },
+        { 0x6F348956u, 0xBBBCE002u, 0xC4F31355u, 0x12B50C6Eu },
+        { 0xB1EDA889u, 0x92C7CCD0u, 0xD4B81EEFu, 0x1DEE7A4Au },
+        { 0x8E57BA07u, 0xDBD30A40u, 0x10934BF2u, 0x17F1FB6Fu },
+        { 0x71DFC806u, 0x7CA8D500u, 0xDA0F6FF5u, 0x1327FC58u },
+        { 0xE9660CD6u, 0xFAA7BB33u, 0x29B24CBBu, 0x1EA6608Eu },
+        { 0x8784D711u, 0x9552FC29u, 0x548EA3C9u, 0x18851A0Bu },
+        { 0xD2D0AC0Eu, 0xAAA8C9BAu, 0x76D88307u, 0x139DAE6Fu },
+        { 0x1E1AACE3u, 0xDDDADC5Eu, 0x57C0D1A5u, 0x1F62B0B2u },
+        { 0x4B488A4Fu, 0x7E48B04Bu, 0xAC9A4151u, 0x191BC08Eu },
+        { 0xD5D3A1D9u, 0xCB6D59D5u, 0x56E1CDDAu, 0x141633A5u },
+        { 0x77DC817Bu, 0x3C577B11u, 0xABE7D7E2u, 0x1011C2EAu },
+        { 0x5960CF2Au, 0xC6F25E82u, 0xACA62636u, 0x19B604AAu },
+        { 0x4780A5BBu, 0x6BF51868u, 0x56EB51C5u, 0x14919D55u },
+        { 0x06008496u, 0x232A79EDu, 0xDF22A7D1u, 0x10747DDDu },
+        { 0xA3340756u, 0xD1DD8FE1u, 0x31D10C81u, 0x1A53FC96u },
+        { 0xE8F66C45u, 0xA7E4731Au, 0xF4A73D34u, 0x150FFD44u },
+        { 0x53F8569Eu, 0x531D28E2u, 0x5D52975Du, 0x10D9976Au },
+        { 0xB98D5762u, 0xEB61DB03u, 0x9550F22Eu, 0x1AF5BF10u },
+        { 0xC7A445E8u, 0xBC4E48CFu, 0xDDDA5B58u, 0x159165A6u },
+        { 0x6C836B20u, 0x6371D3D9u, 0x17E1E2ADu, 0x11411E1Fu },
+        { 0xAD9F11CDu, 0x9F1C8628u, 0xF3030448u, 0x1B9B6364u },
+        { 0xBE18DB0Bu, 0xE5B06B53u, 0x8F359D06u, 0x1615E91Du },
+        { 0xCB4715A2u, 0xEAF3890Fu, 0x72914A6Bu, 0x11AB20E4u },
+        { 0x7871BC37u, 0x44B8DB4Cu, 0x841BAA46u, 0x1C45016Du },
+        { 0xC6C1635Fu, 0x03C715D6u, 0x03495505u, 0x169D9ABEu },
+        { 0x6BCDE919u, 0x3638DE45u, 0x69077737u, 0x1217AEFEu },
+        { 0x461641C1u, 0x56C163A2u, 0x0E725858u, 0x1CF2B197u },
+        { 0xD1AB67CEu, 0xDF011C81u, 0x71F51379u, 0x17288E12u },
+        { 0x4155ECA5u, 0x7F3416CEu, 0xC190DC61u, 0x1286D80Eu },
+        { 0x3556476Eu, 0x6520247Du, 0x68E7C702u, 0x1DA48CE4u },
+        { 0xF7783925u, 0xEA801D30u, 0x20B96C01u, 0x17B6D71Du },
+        { 0xF92CFA84u, 0xBB99B0F3u, 0x4D612334u, 0x12F8AC17u },
+        { 0x2847F739u, 0x5F5C4E53u, 0x15683854u, 0x1E5AACF2u },
+        { 0xB9D32C2Eu, 0x7F7D0B75u, 0x44536043u, 0x18488A5Bu },
+        { 0xC7DC2358u, 0x9930D5F7u, 0x36A919CFu, 0x136D3B7Cu },
+        { 0x72F9D226u, 0x8EB4898Cu, 0xF10E8FB2u, 0x1F152BF9u },
+        { 0x8F2E41B8u, 0x722A07A3u, 0xF40BA628u, 0x18DDBCC7u },
+        { 0xA5BE9AFAu, 0xC1BB394Fu, 0x5CD61E86u, 0x13E49706u },
+        { 0x0930F7F6u, 0x9C5EC219u, 0xFAF030D7u, 0x1FD424D6u },
+        { 0x075A5FF8u, 0x49E56814u, 0x2F268D79u, 0x197683DFu },
+        { 0x05E1E660u, 0x6E512010u, 0xBF520AC7u, 0x145ECFE5u },
+        { 0xD181851Au, 0xF1DA800Cu, 0x990E6F05u, 0x104BD984u },
+        { 0x8268D4F5u, 0x4FC40014u, 0xF4E3E4D6u, 0x1A12F5A0u },
+        { 0x01ED772Bu, 0xD96999AAu, 0xF71CB711u, 0x14DBF7B3u },
+        { 0x018AC5BCu, 0xADEE1488u, 0xC5B09274u, 0x10AFF95Cu },
+        { 0x68DE092Cu, 0x497CEDA6u, 0x6F80EA54u, 0x1AB32894u },
+        { 0x53E4D424u, 0x3ACA57B8u, 0xBF9A5510u, 0x155C2076u },
+        { 0x431D7683u, 0x623B7960u, 0xFFAEAA73u, 0x1116805Eu },
+        { 0xD1C8BD9Eu, 0x9D2BF566u, 0x32B110B8u, 0x1B5733CBu },
+        { 0x416D647Fu, 0x7DBCC452u, 0x8EF40D60u, 0x15DF5CA2u },
+        { 0x678AB6CCu, 0xCAFD69DBu, 0xD8C33DE6u, 0x117F7D4Eu },
+        { 0x72778ADFu, 0xAB2F0FC5u, 0x8E052FD7u, 0x1BFF2EE4u },
+        { 0x5B92D580u, 0x88F27304u, 0x3E6A8CACu, 0x1665BF1Du },
+        { 0x49424466u, 0xD3F528D0u, 0x98553D56u, 0x11EAFF4Au },
+        { 0x4203A0A3u, 0xB988414Du, 0xF3BB9557u, 0x1CAB3210u },
+        { 0x6802E6E9u, 0x6139CDD7u, 0xC2FC7779u, 0x16EF5B40u },
+        { 0x20025254u, 0xE7617179u, 0x68C9F92Du, 0x125915CDu },
+        { 0x999D5086u, 0xA568B58Eu, 0x74765B7Cu, 0x1D5B5615u },
+        { 0xE14AA6D2u, 0x5120913Eu, 0xF6C515FDu, 0x177C44DDu },
+        { 0x1AA21F0Eu, 0xA74D40FFu, 0x923744CAu, 0x12C9D0B1u },
+        { 0xF769CB4Au, 0x0BAECE64u, 0x50586E11u, 0x1E0FB44Fu },
+        { 0xC5EE3C3Bu, 0x3C8BD850u, 0x7379F1A7u, 0x180C903Fu },
+        { 0x37F1C9C9u, 0xCA0979DAu, 0xC2C7F485u, 0x133D4032u },
+        { 0xBFE942DBu, 0xA9A8C2F6u, 0x9E0CBA6Fu, 0x1EC866B7u },
+        { 0xCCBA9BE3u, 0x2153CF2Bu, 0x7E709526u, 0x18A0522Cu },
+        { 0x70954982u, 0x1AA97289u, 0x6526DDB8u, 0x13B374F0u },
+        { 0x1A88759Du, 0xF775840Fu, 0x083E2F8Cu, 0x1F8587E7u },
+        { 0x7BA05E17u, 0x5F913672u, 0x0698260Au, 0x19379FECu },
+        { 0x9619E4DFu, 0x1940F85Bu, 0x054684D5u, 0x142C7FF0u },
+        { 0xAB47EA4Cu, 0xE100C6AFu, 0xD1053710u, 0x1023998Cu },
+        { 0x453FDD47u, 0xCE67A44Cu, 0xB4D524E7u, 0x19D28F47u },
+        { 0x9DCCB106u, 0xD852E9D6u, 0xC3DDB71Fu, 0x14A8729Fu },
+        { 0x4B0A2738u, 0x79DBEE45u, 0x697E2C19u, 0x1086C219u },
+        { 0x11A9D859u, 0x295FE3A2u, 0x0F30468Fu, 0x1A71368Fu },
+        { 0xA7BB137Au, 0xBAB31C81u, 0xD8F36BA5u, 0x15275ED8u },
+        { 0xEC95A92Fu, 0x6228E39Au, 0xAD8F8951u, 0x10EC4BE0u },
+        { 0xE0EF7517u, 0x9D0E38F7u, 0xAF4C0EE8u, 0x1B13AC9Au },
+        { 0x1A592A79u, 0xB0D82D93u, 0x25D67253u, 0x15A956E2u },
+        { 0x4847552Eu, 0x8D79BE0Fu, 0xB7DEC1DCu, 0x11544581u },
+        { 0xDA0BBB7Cu, 0x158F967Eu, 0x8C979C94u, 0x1BBA08CFu },
+        { 0x14D62F97u, 0x77A611FFu, 0xD6DFB076u, 0x162E6D72u },
+        { 0x43DE8C79u, 0xF951A7FFu, 0x78B2F391u, 0x11BEBDF5u },
+        { 0xD2FDAD8Eu, 0xC21C3FFEu, 0x5AB7EC1Cu, 0x1C646322u },
+        { 0x42648AD8u, 0x01B03332u, 0x155FF017u, 0x16B6B5B5u },
+        { 0x9B83A246u, 0x0159C28Eu, 0xDDE659ACu, 0x122BC490u },
+        { 0x5F3903A3u, 0xCEF60417u, 0xFCA3C2ACu, 0x1D12D41Au },
+        { 0x4C2D9C83u, 0x725E69ACu, 0xCA1C9BBDu, 0x17424348u },
+        { 0xD68AE39Cu, 0xF5185489u, 0x0816E2FDu, 0x129B6907u },
+        { 0xBDAB05C6u, 0xEE8D540Fu, 0x0CF16B2Fu, 0x1DC574D8u },
+        { 0xFE226B05u, 0xBED77672u, 0x70C1228Cu, 0x17D12A46u },
+        { 0xCB4EBC04u, 0xFF12C528u, 0x8D674ED6u, 0x130DBB6Bu },
+        { 0x787DF9A0u, 0xCB513B74u, 0x7BD87E24u, 0x1E7C5F12u },
+        { 0xF9FE614Du, 0x090DC929u, 0xFCAD31B7u, 0x18637F41u },
+        { 0x94CB810Au, 0xA0D7D421u, 0xCA2427C5u, 0x1382CC34u },
+        { 0x5478CE77u, 0x67BFB9CFu, 0x436D0C6Fu, 0x1F37AD21u },
+        { 0xDD2D71F9u, 0x1FCC94A5u, 0xCF8A7059u, 0x18F9574Du },
+        { 0x7DBDF4C7u, 0x7FD6DD51u, 0x3FA1F37Au, 0x13FAAC3Eu },
+        { 0xC92FEE0Bu, 0xFFBE2EE8u, 0x329CB8C3u, 0x1FF779FDu },
+        { 0xA0F324D6u, 0x6631BF20u, 0xC216FA36u, 0x1992C7FDu },
+        { 0x1A5C1D78u, 0xB827CC1Au, 0x01ABFB5Eu, 0x14756CCBu },
+        { 0x7B7CE460u, 0x935309AEu, 0x67BCC918u, 0x105DF0A2u },
+        { 0xC594A099u, 0x1EEB42B0u, 0x3F9474F4u, 0x1A2FE76Au },
+        { 0x0476E6E1u, 0xE5890227u, 0x32DD2A5Cu, 0x14F31F88u },
+        { 0x9D2BEBE7u, 0xB7A0CE85u, 0x28B0EEB0u, 0x10C27FA0u },
+        { 0x61DFDFD8u, 0x59014A6Fu, 0x744E4AB4u, 0x1AD0CC33u },
+        { 0xE7E64CADu, 0xE0CDD525u, 0x903EA229u, 0x1573D68Fu },
+        { 0x8651D6F1u, 0x4D717751u, 0xD9CBB4EEu, 0x11297872u },
+        { 0xD6E957E8u, 0x7BE8BEE8u, 0x8FAC54B0u, 0x1B758D84u },
+        { 0xDF211320u, 0xFCBA3253u, 0x0C89DD59u, 0x15F7A46Au },
+        { 0x18E74280u, 0x63C82843u, 0x706E4AAEu, 0x1192E9EEu },
+        { 0x27D86A66u, 0x060D0D38u, 0x1A4A1117u, 0x1C1E4317u },
+        { 0xECAD21EBu, 0x6B3DA42Cu, 0x7B6E7412u, 0x167E9C12u },
+        { 0xBD574E56u, 0x88FE1CF0u, 0xFC585CDBu, 0x11FEE341u },
+        { 0x62254A23u, 0x419694B4u, 0x608D615Fu, 0x1CCB0536u },
+        { 0xE81DD4E9u, 0x67ABAA29u, 0x4D3DE77Fu, 0x1708D0F8u },
+        { 0x2017DD87u, 0xB95621BBu, 0xD764B932u, 0x126D73F9u },
+        { 0x668C95A5u, 0xC223692Bu, 0xF23AC1EAu, 0x1D7BECC2u },
+        { 0x1ED6DE1Du, 0xCE82BA89u, 0x5B6234BBu, 0x17965702u },
+        { 0x4BDF1818u, 0xA5356207u, 0xE2B4F6FCu, 0x12DEAC01u },
+        { 0x7964F359u, 0x3B889CD8u, 0x3787F194u, 0x1E311336u },
+        { 0xC783F5E1u, 0xFC6D4A46u, 0xC6065ADCu, 0x18274291u },
+        { 0x06032B1Au, 0x30576E9Fu, 0xD19EAF17u, 0x13529BA7u },
+        { 0x3CD1DE90u, 0x1A257DCBu, 0x1C311825u, 0x1EEA92A6u },
+        { 0x30A7E540u, 0x481DFE3Cu, 0xE35A79B7u, 0x18BBA884u },
+        { 0xC0865100u, 0xD34B31C9u, 0x82AEC7C5u, 0x13C9539Du },
+        { 0xCDA3B4CDu, 0x5211E942u, 0xD117A609u, 0x1FA885C8u },
+        { 0x3E1C90A4u, 0x74DB2102u, 0x40DFB807u, 0x19539E3Au },
+        { 0xCB4A0D50u, 0xF715B401u, 0x67196005u, 0x1442E4FBu },
+        { 0x09080AA7u, 0xF8DE299Bu, 0x527AB337u, 0x103583FCu },
+        { 0xA80CDDD7u, 0x8E304291u, 0xB72AB859u, 0x19EF3993u },
+        { 0x200A4B13u, 0x3E8D020Eu, 0xF8EEF9E1u, 0x14BF6142u },
+        { 0x80083C0Fu, 0x653D9B3Eu, 0xFA58C7E7u, 0x10991A9Bu },
+        { 0x000D2CE4u, 0x6EC8F864u, 0x908E0CA5u, 0x1A8E90F9u },
+        { 0x99A423EAu, 0x8BD3F9E9u, 0x4071A3B7u, 0x153EDA61u },
+        { 0xE1501CBBu, 0x3CA994BAu, 0x99F482F9u, 0x10FF151Au },
+        { 0x9BB3612Bu, 0xC775BAC4u, 0xC320D18Eu, 0x1B31BB5Du },
+        { 0x16291A89u, 0xD2C4956Au, 0x68E70E0Bu, 0x15C162B1u },
+        { 0x11BA7BA1u, 0xDBD07788u, 0x871F3E6Fu, 0x11678227u },
+        { 0x1C5D929Bu, 0x2C80BF40u, 0x3E9863E6u, 0x1BD8D03Fu },
+        { 0x49E47549u, 0xBD33CC33u, 0x6546B651u, 0x16470CFFu },
+        { 0x6E505DD4u, 0xCA8FD68Fu, 0x51055EA7u, 0x11D270CCu },
+        { 0xE3B3C953u, 0x4419574Bu, 0x4E6EFDD9u, 0x1C83E7ADu },
+        { 0x82F63AA9u, 0x03477909u, 0xA52597E1u, 0x16CFEC8Au },
+        { 0x68C4FBBAu, 0xCF6C60D4u, 0xEA847980u, 0x123FF06Eu },
+        { 0x0E07F92Au, 0xE57A3487u, 0x10D3F59Au, 0x1D331A4Bu },
+        { 0x0B399422u, 0x512E906Cu, 0xDA432AE2u, 0x175C1508u },
+        { 0xD5C7A9B5u, 0xDA8BA6BCu, 0xE1CF5581u, 0x12B010D3u },
+        { 0x22D90F87u, 0x90DF712Eu, 0x02E5559Cu, 0x1DE68153u },
+        { 0x4F140C6Cu, 0xDA4C5A8Bu, 0xCF1DDE16u, 0x17EB9AA8u },
+        { 0xA5A9A38Au, 0xAEA37BA2u, 0xA5B17E78u, 0x1322E220u },
+        { 0xA2A905A9u, 0x7DD25F6Au, 0xA2B59727u, 0x1E9E369Au },
+        { 0x8220D154u, 0x97DB7F88u, 0x4EF7AC1Fu, 0x187E9215u },
+        { 0xCE80A777u, 0x797C6606u, 0xD8C6234Cu, 0x139874DDu },
+        { 0xE4010BF1u, 0x8F2D700Au, 0x27A36BADu, 0x1F5A5496u },
+        { 0x5000D65Au, 0x0C2459A2u, 0x1FB5EFBEu, 0x19151078u },
+        { 0xD99A4515u, 0x701D1481u, 0xB2F7F2FEu, 0x1410D9F9u },
+        { 0x147B6A77u, 0xC017439Bu, 0x28C65BFEu, 0x100D7B2Eu },
+        { 0xED9243F2u, 0xCCF205C4u, 0x0E0A2CCAu, 0x19AF2B7Du },
+        { 0xBE0E9CC2u, 0x0A5B37D0u, 0x71A1BD6Fu, 0x148C22CAu },
+        { 0xCB3EE3CEu, 0x0848F973u, 0x27B4978Cu, 0x10701BD5u },
+        { 0x78649FB0u, 0xDA0E5BECu, 0x0C5425ACu, 0x1A4CF955u },
+        { 0x60507FC0u, 0x7B3EAFF0u, 0xD6A9B7BDu, 0x150A6110u },
+        { 0x80406633u, 0x95CBBFF3u, 0xDEEE2C97u, 0x10D51A73u },
+        { 0x66CD7052u, 0xEFAC6652u, 0x64B04758u, 0x1AEE90B9u },
+        { 0xB8A459DBu, 0x2623850Eu, 0xB6F36C47u, 0x158BA6FAu },
+        { 0x93B6AE49u, 0x1E82D0D8u, 0x5F29236Cu, 0x113C8595u },
+        { 0x1F8AB075u, 0xFD9E1AF4u, 0xFEA838ACu, 0x1B9408EEu },
+        { 0xB2D559F7u, 0x97B1AF29u, 0x988693BDu, 0x16100725u },
+        { 0xF5777B2Cu, 0xAC8E25BAu, 0x139EDC97u, 0x11A66C1Eu },
+        { 0x2258C513u, 0x7A7D092Bu, 0xB8FE2DBFu, 0x1C3D79C9u },
+        { 0x4EAD6A76u, 0x61FDA0EFu, 0x60CB57CCu, 0x169794A1u },
+        { 0x0BBDEEC5u, 0xE7FE1A59u, 0xE7091309u, 0x1212DD4Du },
+        { 0x45FCB13Au, 0xA6635D5Bu, 0xD80E84DCu, 0x1CEAFBAFu },
+        { 0x6B308DC8u, 0x851C4AAFu, 0x133ED0B0u, 0x172262F3u },
+        { 0xBC26D7D4u, 0xD0E36EF2u, 0x75CBDA26u, 0x1281E8C2u },
+        { 0xC6A48C86u, 0xB49F17EAu, 0x894629D7u, 0x1D9CA79Du },
+        { 0x0550706Bu, 0x2A18DFEFu, 0xA104EE46u, 0x17B08617u },
+        { 0x9DD9F389u, 0x54E0B325u, 0x4D9D8B6Bu, 0x12F39E79u },
+        { 0x62F65274u, 0x87CDEB6Fu, 0x7C2F4578u, 0x1E529728u },
+        { 0x825EA85Du, 0xD30B22BFu, 0xC9BF6AC6u, 0x18421286u },
+        { 0x684BB9E4u, 0x0F3C1BCCu, 0x3AFF889Fu, 0x13680ED2u },
+        { 0x4079296Du, 0x18602C7Au, 0x9198DA98u, 0x1F0CE483u },
+        { 0x33942124u, 0x46B356C8u, 0x0E13E213u, 0x18D71D36u },
+        { 0x29434DB6u, 0x388F78A0u, 0xA4DCB4DCu, 0x13DF4A91u },
+        { 0xA86BAF8Au, 0x5A7F2766u, 0xA1612160u, 0x1FCBAA82u },
+        { 0xB9EFBFA2u, 0x153285EBu, 0xB44DB44Du, 0x196FBB9Bu },
+        { 0x618C994Eu, 0xAA8ED189u, 0xF6A4903Du, 0x145962E2u },
+        { 0x1AD6E10Cu, 0xEED8A7A1u, 0x2BB6D9CAu, 0x1047824Fu },
+        { 0x5E249B45u, 0x7E27729Bu, 0xDF8AF611u, 0x1A0C03B1u },
+        { 0x181D4904u, 0xFE85F549u, 0x193BF80Du, 0x14D6695Bu },
+        { 0x134AA0D0u, 0xCB9E5DD4u, 0x142FF9A4u, 0x10AB877Cu },
+        { 0x5211014Du, 0xDF63C953u, 0xB9E65C3Au, 0x1AAC0BF9u },
+        { 0x74DA6771u, 0x191CA10Fu, 0xFB1EB02Fu, 0x15566FFAu },
+        { 0x2A4852C1u, 0xADB080D9u, 0x2F4BC025u, 0x1111F32Fu },
+        { 0xAA0D5134u, 0x15E7348Eu, 0xB212CD09u, 0x1B4FEB7Eu },
+        { 0xEE710DC4u, 0xAB1F5D3Eu, 0x280F0A6Du, 0x15D98932u },
+        { 0x8B8DA49Du, 0xBC191765u, 0x200C0857u, 0x117AD428u },
+        { 0x127C3A94u, 0x2CF4F23Cu, 0xCCE00D59u, 0x1BF7B9D9u },
+        { 0xDB969543u, 0xF0C3F4FCu, 0x70B33DE0u, 0x165FC7E1u },
+        { 0x16121103u, 0x5A365D97u, 0x26F5CB1Au, 0x11E63981u },
+        { 0xF01CE804u, 0x9056FC24u, 0x0B22DE90u, 0x1CA38F35u },
+        { 0x8CE3ECD0u, 0xD9DF301Du, 0xA2824BA6u, 0x16E93F5Du },
+        { 0x3D8323DAu, 0xE17F59B1u, 0x4ECEA2EBu, 0x125432B1u },
+        { 0x2F38395Cu, 0x68CBC2B5u, 0xE47DD179u, 0x1D53844Eu },
+        { 0xBF602DE3u, 0x53D6355Du, 0x5064A794u, 0x17760372u },
+        { 0x65E68B1Cu, 0xA9782AB1u, 0xA6B6EC76u, 0x12C4CF8Eu },
+        { 0x6FD744FAu, 0x0F26AAB5u, 0xD78B13F1u, 0x1E07B27Du },
+        { 0xBFDF6A62u, 0x3F52222Au, 0xAC6F4327u, 0x18062864u },
+        { 0x997F884Eu, 0x65DB4E88u, 0x89F29C1Fu, 0x13382050u },
+        { 0x28CC0D4Au, 0x6FC54A74u, 0x0FEA9365u, 0x1EC033B4u },
+        { 0x8709A43Bu, 0x596AA1F6u, 0x73220F84u, 0x1899C2F6u },
+        { 0x6C07B696u, 0xADEEE7F8u, 0xF5B4D936u, 0x13AE3591u },
+        { 0xE00C5756u, 0x497E3FF3u, 0x22BAF524u, 0x1F7D2283u },
+        { 0x4CD6AC45u, 0xD464FFF6u, 0xE89590E9u, 0x1930E868u },
+        { 0x3D7889D1u, 0x4383FFF8u, 0xED4473EEu, 0x14272053u },
+        { 0x9793A174u, 0xCF9CCCC6u, 0xF1038FF1u, 0x101F4D0Fu },
+        { 0x25B90252u, 0x7F6147A4u, 0xE805B31Cu, 0x19CBAE7Fu },
+        { 0xB7C7350Fu, 0xCC4DD2E9u, 0xECD15C16u, 0x14A2F1FFu },
+        { 0x5FD290D9u, 0x3D0B0F21u, 0x23DAB012u, 0x10825B33u },
+        { 0x9950E7C1u, 0x61AB4B68u, 0x062AB350u, 0x1A6A2B85u },
+        { 0x1440B967u, 0x4E22A2BAu, 0x6B555C40u, 0x1521BC6Au },
+        { 0xDD009453u, 0x0B4EE894u, 0xBC4449CDu, 0x10E7C9EEu },
+        { 0xC800ED51u, 0x1217DA87u, 0xC6D3A948u, 0x1B0C764Au },
+        { 0xA000BDDAu, 0xDB46486Cu, 0x6BDC876Cu, 0x15A391D5u },
+        { 0x4CCD64AFu, 0x490506BDu, 0xEFE39F8Au, 0x114FA7DDu },
+        { 0x7AE23AB1u, 0xA8080AC8u, 0xE638FF43u, 0x1BB2A62Fu },
+        { 0xFBE82EF4u, 0x5339A239u, 0x1E93FF69u, 0x162884F3u },
+        { 0x2FECF25Du, 0x75C7B4FBu, 0xB20FFF87u, 0x11BA03F5u },
+        { 0xE647EA2Eu, 0x22D92191u, 0xB67FFF3Fu, 0x1C5CD322u },
+        { 0x850654F2u, 0xB57A8141u, 0x91FFFF65u, 0x16B0A8E8u },
+        { 0x373843F5u, 0xC4620101u, 0xDB3332B7u, 0x1226ED86u },
+        { 0xF1F39FEEu, 0x3A366801u, 0x91EB8459u, 0x1D0B15A4u },
+        { 0x27F6198Bu, 0xFB5EB99Bu, 0x74BC69E0u, 0x173C1150u },
+        { 0x865E7AD6u, 0x2F7EFAE2u, 0x5D6387E7u, 0x12967440u },
+        { 0xD6FD9156u, 0xE597F7D0u, 0x6238D971u, 0x1DBD86CDu },
+        { 0x78CADAABu, 0x8479930Du, 0xE82D7AC1u, 0x17CAD23Du },
+        { 0x2D6F1556u, 0xD0614271u, 0x868AC89Au, 0x1308A831u },
+        { 0xAF182222u, 0x4D686A4Eu, 0x3DAADA91u, 0x1E74404Fu },
+        { 0xF279B4E8u, 0xA453883Eu, 0x6488AEDAu, 0x185D003Fu },
+        { 0x28615D87u, 0xE9DC6CFFu, 0x506D58AEu, 0x137D99CCu },
+        { 0x0D6895A4u, 0xA960AE65u, 0x1A488DE4u, 0x1F2F5C7Au },
+        { 0x3DED4483u, 0xBAB3BEB7u, 0xAEA07183u, 0x18F2B061u },
+        { 0x318A9D36u, 0x2EF6322Cu, 0xBEE6C136u, 0x13F559E7u }
+    };
+    static const uint32_t powers_of_five[326][4] = { /* The 125 most significant bits of 5^i */
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x10000000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x14000000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x19000000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x1F400000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x13880000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x186A0000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x1E848000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x1312D000u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x17D78400u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x1DCD6500u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x12A05F20u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x174876E8u },
+        { 0x00000000u, 0x00000000u, 0x00000000u, 0x1D1A94A2u },
+        { 0x00000000u, 0x00000000u, 0x40000000u, 0x12309CE5u },
+        { 0x00000000u, 0x00000000u, 0x90000000u, 0x16BCC41Eu },
+        { 0x00000000u, 0x00000000u, 0x34000000u, 0x1C6BF526u },
+        { 0x00000000u, 0x00000000u, 0xE0800000u, 0x11C37937u },
+        { 0x00000000u, 0x00000000u, 0xD8A00000u, 0x16345785u },
+        { 0x00000000u, 0x00000000u, 0x4EC80000u, 0x1BC16D67u },
+        { 0x00000000u, 0x00000000u, 0x913D0000u, 0x1158E460u },
+        { 0x00000000u, 0x00000000u, 0xB58C4000u, 0x15AF1D78u },
+        { 0x00000000u, 0x00000000u, 0xE2EF5000u, 0x1B1AE4D6u },
+        { 0x00000000u, 0x00000000u, 0x4DD59200u, 0x10F0CF06u },
+        { 0x00000000u, 0x00000000u, 0xE14AF680u, 0x152D02C7u },
+        { 0x00000000u, 0x00000000u, 0xD99DB420u, 0x1A784379u },
+        { 0x00000000u, 0x00000000u, 0x28029094u, 0x108B2A2Cu },
+        { 0x00000000u, 0x00000000u, 0x320334B9u, 0x14ADF4B7u },
+        { 0x00000000u, 0x40000000u, 0xFE8401E7u, 0x19D971E4u },
+        { 0x00000000u, 0x88000000u, 0x1F128130u, 0x1027E72Fu },
+        { 0x00000000u, 0xAA000000u, 0xE6D7217Cu, 0x1431E0FAu },
+        { 0x00000000u, 0xD4800000u, 0xA08CE9DBu, 0x193E5939u },
+        { 0x00000000u, 0xC9A00000u, 0x08B02452u, 0x1F8DEF88u },
+        { 0x00000000u, 0xBE040000u, 0x056E16B3u, 0x13B8B5B5u },
+        { 0x00000000u, 0xAD850000u, 0x46C99C60u, 0x18A6E322u },
+        { 0x00000000u, 0xD8E64000u, 0xD87C0378u, 0x1ED09BEAu },
+        { 0x00000000u, 0x878FE800u, 0xC74D822Bu, 0x13426172u },
+        { 0x00000000u, 0x6973E200u, 0x7920E2B6u, 0x1812F9CFu },
+        { 0x00000000u, 0x03D0DA80u, 0x57691B64u, 0x1E17B843u },
+        { 0x00000000u, 0x82628890u, 0x16A1B11Eu, 0x12CED32Au },
+        { 0x00000000u, 0x22FB2AB4u, 0x9C4A1D66u, 0x178287F4u },
+        { 0x00000000u, 0xABB9F561u, 0xC35CA4BFu, 0x1D6329F1u },
+        { 0xA0000000u, 0xCB54395Cu, 0x1A19E6F7u, 0x125DFA37u },
+        { 0xC8000000u, 0xBE2947B3u, 0xE0A060B5u, 0x16F578C4u },
+        { 0xBA000000u, 0x2DB399A0u, 0x18C878E3u, 0x1CB2D6F6u },
+        { 0x74400000u, 0xFC904004u, 0xCF7D4B8Du, 0x11EFC659u },
+        { 0x91500000u, 0x7BB45005u, 0x435C9E71u, 0x166BB7F0u },
+        { 0xF5A40000u, 0xDAA16406u, 0x5433C60Du, 0x1C06A5ECu },
+        { 0x59868000u, 0xA8A4DE84u, 0xB4A05BC8u, 0x118427B3u },
+        { 0x6FE82000u, 0xD2CE1625u, 0xA1C872BAu, 0x15E531A0u },
+        { 0xCBE22800u, 0x87819BAEu, 0xCA3A8F69u, 0x1B5E7E08u },
+        { 0x3F6D5900u, 0xF4B1014Du, 0x7E6499A1u, 0x111B0EC5u },
+        { 0x8F48AF40u, 0x71DD41A0u, 0xDDFDC00Au, 0x1561D276u },
+        { 0xB31ADB10u, 0x0E549208u, 0x957D300Du, 0x1ABA4714u },
+        { 0x6FF0C8EAu, 0x28F4DB45u, 0xDD6E3E08u, 0x10B46C6Cu },
+        { 0xCBECFB24u, 0x33321216u, 0x14C9CD8Au, 0x14E18788u },
+        { 0x7EE839EDu, 0xBFFE969Cu, 0x19FC40ECu, 0x1A19E96Au },
+        { 0xCF512434u, 0xF7FF1E21u, 0x503DA893u, 0x105031E2u },
+        { 0x43256D41u, 0xF5FEE5AAu, 0xE44D12B8u, 0x14643E5Au },
+        { 0xD3EEC892u, 0x337E9F14u, 0x9D605767u, 0x197D4DF1u },
+        { 0x08EA7AB6u, 0x005E46DAu, 0x04B86D41u, 0x1FDCA16Eu },
+        { 0x45928CB2u, 0xA03AEC48u, 0xC2F34448u, 0x13E9E4E4u },
+        { 0x56F72FDEu, 0xC849A75Au, 0xF3B0155Au, 0x18E45E1Du },
+        { 0xECB4FBD6u, 0x7A5C1130u, 0x709C1AB1u, 0x1F1D75A5u },
+        { 0x93F11D65u, 0xEC798ABEu, 0x666190AEu, 0x13726987u },
+        { 0x38ED64BFu, 0xA797ED6Eu, 0x3FF9F4DAu, 0x184F03E9u },
+        { 0xC728BDEFu, 0x517DE8C9u, 0x8FF87211u, 0x1E62C4E3u },
+        { 0x1C7976B5u, 0xD2EEB17Eu, 0x39FB474Au, 0x12FDBB0Eu },
+        { 0xA397D462u, 0x87AA5DDDu, 0xC87A191Du, 0x17BD29D1u },
+        { 0x0C7DC97Bu, 0xE994F555u, 0x3A989F64u, 0x1DAC7446u },
+        { 0x27CE9DEDu, 0x11FD1955u, 0xE49F639Fu, 0x128BC8ABu },
+        { 0x71C24568u, 0xD67C5FAAu, 0xDDC73C86u, 0x172EBAD6u },
+        { 0x0E32D6C2u, 0x8C1B7795u, 0x95390BA8u, 0x1CFA698Cu },
+        { 0x28DFC639u, 0x57912ABDu, 0xDD43A749u, 0x121C81F7u },
+        { 0x7317B7C8u, 0xAD75756Cu, 0xD494911Bu, 0x16A3A275u },
+        { 0x8FDDA5BAu, 0x98D2D2C7u, 0x49B9B562u, 0x1C4C8B13u },
+        { 0xB9EA8794u, 0x9F83C3BCu, 0x0E14115Du, 0x11AFD6ECu },
+        { 0xE8652979u, 0x0764B4ABu, 0x119915B5u, 0x161BCCA7u },
+        { 0xE27E73D7u, 0x493DE1D6u, 0xD5FF5B22u, 0x1BA2BFD0u },
+        { 0x4D8F0866u, 0x6DC6AD26u, 0x85BF98F5u, 0x1145B7E2u },
+        { 0xE0F2CA80u, 0xC938586Fu, 0x272F7F32u, 0x159725DBu },
+        { 0xD92F7D20u, 0x7B866E8Bu, 0xF0FB5EFFu, 0x1AFCEF51u },
+        { 0x67BDAE34u, 0xAD340517u, 0x369D1B5Fu, 0x10DE1593u },
+        { 0x41AD19C1u, 0x9881065Du, 0x04446237u, 0x15159AF8u },
+        { 0x92186032u, 0x7EA147F4u, 0x05557AC5u, 0x1A5B01B6u },
+        { 0xDB4F3C1Fu, 0x6F24CCF8u, 0xC3556CBBu, 0x1078E111u },
+        { 0x12230B27u, 0x4AEE0037u, 0x342AC7EAu, 0x14971956u },
+        { 0xD6ABCDF0u, 0xDDA98044u, 0xC13579E4u, 0x19BCDFABu },
+        { 0x062B60B6u, 0x0A89F02Bu, 0x58C16C2Fu, 0x10160BCBu },
+        { 0xC7B638E4u, 0xCD2C6C35u, 0x2EF1C73Au, 0x141B8EBEu },
+        { 0x39A3C71Du, 0x80778743u, 0xBAAE3909u, 0x1922726Du },
+        { 0x080CB8E4u, 0xE0956914u, 0x2959C74Bu, 0x1F6B0F09u },
+        { 0x8507F38Eu, 0x6C5D61ACu, 0xB9D81C8Fu, 0x13A2E965u },
+        { 0xA649F072u, 0x4774BA17u, 0x284E23B3u, 0x188BA3BFu },
+        { 0x8FDC6C8Fu, 0x1951E89Du, 0xF261ACA0u, 0x1EAE8CAEu },
+        { 0x79E9C3D9u, 0x0FD33162u, 0x577D0BE4u, 0x132D17EDu },
+        { 0x186434CFu, 0x13C7FDBBu, 0xAD5C4EDDu, 0x17F85DE8u },
+        { 0xDE7D4203u, 0x58B9FD29u, 0xD8B36294u, 0x1DF67562u },
+        { 0x2B0E4942u, 0xB7743E3Au, 0xC7701D9Cu, 0x12BA095Du },
+        { 0xB5D1DB92u, 0xE5514DC8u, 0x394C2503u, 0x17688BB5u },
+        { 0xE3465277u, 0xDEA5A13Au, 0x879F2E44u, 0x1D42AEA2u },
+        { 0xCE0BF38Au, 0x0B2784C4u, 0x94C37CEBu, 0x1249AD25u },
+        { 0x018EF06Du, 0xCDF165F6u, 0xF9F45C25u, 0x16DC186Eu },
+        { 0x81F2AC88u, 0x416DBF73u, 0xB871732Fu, 0x1C931E8Au },
+        { 0x3137ABD5u, 0x88E497A8u, 0xB346E7FDu, 0x11DBF316u },
+        { 0x3D8596CAu, 0xEB1DBD92u, 0x6018A1FCu, 0x1652EFDCu },
+        { 0xCCE6FC7Du, 0x25E52CF6u, 0x781ECA7Cu, 0x1BE7ABD3u },
+        { 0x40105DCEu, 0x97AF3C1Au, 0x2B133E8Du, 0x1170CB64u },
+        { 0xD0147542u, 0xFD9B0B20u, 0x35D80E30u, 0x15CCFE3Du },
+        { 0x04199292u, 0x3D01CDE9u, 0x834E11BDu, 0x1B403DCCu },
+        { 0xA28FFB9Bu, 0x462120B1u, 0xD210CB16u, 0x1108269Fu },
+        { 0x0B33FA82u, 0xD7A968DEu, 0xC694FDDBu, 0x154A3047u },
+        { 0x8E00F923u, 0xCD93C315u, 0xB83A3D52u, 0x1A9CBC59u },
+        { 0x78C09BB6u, 0xC07C59EDu, 0x13246653u, 0x10A1F5B8u },
+        { 0xD6F0C2A3u, 0xB09B7068u, 0x17ED7FE8u, 0x14CA7326u },
+        { 0x0CACF34Cu, 0xDCC24C83u, 0x9DE8DFE2u, 0x19FD0FEFu },
+        { 0xE7EC180Fu, 0xC9F96FD1u, 0xC2B18BEDu, 0x103E29F5u },
+        { 0x61E71E13u, 0x3C77CBC6u, 0x335DEEE9u, 0x144DB473u },
+        { 0xFA60E598u, 0x8B95BEB7u, 0x00356AA3u, 0x19612190u },
+        { 0xF8F91EFEu, 0x6E7B2E65u, 0x0042C54Cu, 0x1FB969F4u },
+        { 0xBB9BB35Fu, 0xC50CFCFFu, 0x8029BB4Fu, 0x13D3E238u },
+        { 0xAA82A037u, 0xB6503C3Fu, 0xA0342A23u, 0x18C8DAC6u },
+        { 0x95234844u, 0xA3E44B4Fu, 0x484134ACu, 0x1EFB1178u },
+        { 0xBD360D2Bu, 0xE66EAF11u, 0x2D28C0EBu, 0x135CEAEBu },
+        { 0x2C839075u, 0xE00A5AD6u, 0xF872F126u, 0x183425A5u },
+        { 0xB7A47493u, 0x980CF18Bu, 0x768FAD70u, 0x1E412F0Fu },
+        { 0x52C6C8DCu, 0x5F0816F7u, 0xAA19CC66u, 0x12E8BD69u },
+        { 0x27787B13u, 0xF6CA1CB5u, 0x14A03F7Fu, 0x17A2ECC4u },
+        { 0x715699D7u, 0xF47CA3E2u, 0x19C84F5Fu, 0x1D8BA7F5u },
+        { 0x86D62026u, 0xF8CDE66Du, 0x301D319Bu, 0x127748F9u },
+        { 0xE88BA830u, 0xF7016008u, 0x7C247E02u, 0x17151B37u },
+        { 0x22AE923Cu, 0xB4C1B80Bu, 0x5B2D9D83u, 0x1CDA6205u },
+        { 0xF5AD1B65u, 0x50F91306u, 0x58FC8272u, 0x12087D43u },
+        { 0xB318623Fu, 0xE53757C8u, 0x2F3BA30Eu, 0x168A9C94u },
+        { 0xDFDE7ACFu, 0x9E852DBAu, 0x3B0A8BD2u, 0x1C2D43B9u },
+        { 0xCBEB0CC1u, 0xA3133C94u, 0xC4E69763u, 0x119C4A53u },
+        { 0xFEE5CFF1u, 0x8BD80BB9u, 0xB6203D3Cu, 0x16035CE8u },
+        { 0x7E9F43EEu, 0xAECE0EA8u, 0xE3A84C8Bu, 0x1B843422u },
+        { 0x4F238A75u, 0x4D40C929u, 0xCE492FD7u, 0x1132A095u },
+        { 0xA2EC6D12u, 0x2090FB73u, 0x41DB7BCDu, 0x157F48BBu },
+        { 0x8BA78856u, 0x68B53A50u, 0x12525AC0u, 0x1ADF1AEAu },
+        { 0x5748B536u, 0x41714472u, 0x4B7378B8u, 0x10CB70D2u },
+        { 0xED1AE283u, 0x51CD958Eu, 0xDE5056E6u, 0x14FE4D06u },
+        { 0xA8619B24u, 0xE640FAF2u, 0x95E46C9Fu, 0x1A3DE048u },
+        { 0xA93D00F7u, 0xEFE89CD7u, 0x5DAEC3E3u, 0x1066AC2Du },
+        { 0x938C4134u, 0xEBE2C40Du, 0xB51A74DCu, 0x14805738u },
+        { 0xF86F5181u, 0x26DB7510u, 0xE2611214u, 0x19A06D06u },
+        { 0x9B4592F1u, 0x9849292Au, 0x4D7CAB4Cu, 0x10044424u },
+        { 0x4216F7ADu, 0xBE5B7375u, 0x60DBD61Fu, 0x1405552Du },
+        { 0x929CB598u, 0xADF25052u, 0xB912CBA7u, 0x1906AA78u },
+        { 0x3743E2FFu, 0x996EE467u, 0xE7577E91u, 0x1F485516u },
+        { 0x828A6DDFu, 0xFFE54EC0u, 0x5096AF1Au, 0x138D352Eu },
+        { 0xA32D0957u, 0xBFDEA270u, 0xE4BC5AE1u, 0x18708279u },
+        { 0xCBF84BADu, 0x2FD64B0Cu, 0x5DEB719Au, 0x1E8CA318u },
+        { 0xFF7B2F4Cu, 0x5DE5EEE7u, 0x3AB32700u, 0x1317E5EFu },
+        { 0xFF59FB1Fu, 0x755F6AA1u, 0x095FF0C0u, 0x17DDDF6Bu },
+        { 0x7F3079E7u, 0x92B7454Au, 0xCBB7ECF0u, 0x1DD55745u },
+        { 0x8F7E4C30u, 0x5BB28B4Eu, 0x9F52F416u, 0x12A5568Bu },
+        { 0x335DDF3Cu, 0xF29F2E22u, 0x8727B11Bu, 0x174EAC2Eu },
+        { 0xC035570Bu, 0xEF46F9AAu, 0x28F19D62u, 0x1D22573Au },
+        { 0xB8215667u, 0xD58C5C0Au, 0x5997025Du, 0x12357684u },
+        { 0x6629AC01u, 0x4AEF730Du, 0x6FFCC2F5u, 0x16C2D425u },
+        { 0xBFB41701u, 0x9DAB4FD0u, 0xCBFBF3B2u, 0x1C73892Eu },
+        { 0x77D08E60u, 0xA28B11E2u, 0x3F7D784Fu, 0x11C835BDu },
+        { 0x15C4B1F9u, 0x8B2DD65Bu, 0x8F5CD663u, 0x163A432Cu },
+        { 0xDB35DE77u, 0x6DF94BF1u, 0xB3340BFCu, 0x1BC8D3F7u },
+        { 0x2901AB0Au, 0xC4BBCF77u, 0xD000877Du, 0x115D847Au },
+        { 0xF34215CDu, 0x35EAC354u, 0x8400A95Du, 0x15B4E599u },
+        { 0x30129B40u, 0x8365742Au, 0xE500D3B4u, 0x1B221EFFu },
+        { 0x5E0BA108u, 0xD21F689Au, 0xEF208450u, 0x10F5535Fu },
+        { 0xF58E894Au, 0x06A742C0u, 0xEAE8A565u, 0x1532A837u },
+        { 0x32F22B9Du, 0x48511371u, 0xE5A2CEBEu, 0x1A7F5245u },
+        { 0xBFD75B42u, 0xED32AC26u, 0xAF85C136u, 0x108F936Bu },
+        { 0x6FCD3212u, 0xA87F5730u, 0x9B673184u, 0x14B37846u },
+        { 0x8BC07E97u, 0xD29F2CFCu, 0x4240FDE5u, 0x19E05658u },
+        { 0xD7584F1Eu, 0xA3A37C1Du, 0x29689EAFu, 0x102C35F7u },
+        { 0x4D2E62E6u, 0x8C8C5B25u, 0xF3C2C65Bu, 0x14374374u },
+        { 0xA079FB9Fu, 0x6FAF71EEu, 0x30B377F2u, 0x19451452u },
+        { 0x48987A87u, 0x0B9B4E6Au, 0xBCE055EFu, 0x1F965966u },
+        { 0x6D5F4C94u, 0x67411102u, 0x360C35B5u, 0x13BDF7E0u },
+        { 0x08B71FBAu, 0xC1115543u, 0x438F4322u, 0x18AD75D8u },
+        { 0xCAE4E7A8u, 0x7155AA93u, 0x547313EBu, 0x1ED8D34Eu },
+        { 0x5ECF10C9u, 0x26D58A9Cu, 0xF4C7EC73u, 0x13478410u },
+        { 0x7682D4FBu, 0xF08AED43u, 0x31F9E78Fu, 0x18196515u },
+        { 0x54238A3Au, 0xECADA894u, 0x7E786173u, 0x1E1FBE5Au },
+        { 0xB4963664u, 0x73EC895Cu, 0x8F0B3CE8u, 0x12D3D6F8u },
+        { 0xE1BBC3FDu, 0x90E7ABB3u, 0xB2CE0C22u, 0x1788CCB6u },
+        { 0xDA2AB4FDu, 0x352196A0u, 0x5F818F2Bu, 0x1D6AFFE4u },
+        { 0x885AB11Eu, 0x0134FE24u, 0xBBB0F97Bu, 0x1262DFEEu },
+        { 0xAA715D65u, 0xC1823DADu, 0x6A9D37D9u, 0x16FB97EAu },
+        { 0x150DB4BFu, 0x31E2CD19u, 0x054485D0u, 0x1CBA7DE5u },
+        { 0xAD2890F7u, 0x1F2DC02Fu, 0x234AD3A2u, 0x11F48EAFu },
+        { 0x9872B535u, 0xA6F9303Bu, 0xEC1D888Au, 0x1671B25Au },
+        { 0x7E8F6282u, 0x50B77C4Au, 0xA724EAADu, 0x1C0E1EF1u },
+        { 0x8F199D91u, 0x5272ADAEu, 0x087712ACu, 0x1188D357u },
+        { 0x32E004F6u, 0x670F591Au, 0xCA94D757u, 0x15EB082Cu },
+        { 0xBF980633u, 0x40D32F60u, 0xFD3A0D2Du, 0x1B65CA37u },
+        { 0x77BF03E0u, 0x4883FD9Cu, 0xFE44483Cu, 0x111F9E62u },
+        { 0x95AEC4D8u, 0x5AA4FD03u, 0xBDD55A4Bu, 0x156785FBu },
+        { 0x7B1A760Eu, 0x314E3C44u, 0xAD4AB0DEu, 0x1AC1677Au },
+        { 0xCCF089C9u, 0xDED0E5AAu, 0xAC4EAE8Au, 0x10B8E0ACu },
+        { 0x802CAC3Bu, 0x96851F15u, 0xD7625A2Du, 0x14E718D7u },
+        { 0xE037D74Au, 0xFC2666DAu, 0xCD3AF0B8u, 0x1A20DF0Du },
+        { 0xCC22E68Eu, 0x9D980048u, 0xA044D673u, 0x10548B68u },
+        { 0xFF2BA032u, 0x84FE005Au, 0xC8560C10u, 0x1469AE42u },
+        { 0xBEF6883Eu, 0xA63D8071u, 0x7A6B8F14u, 0x198419D3u },
+        { 0x2EB42A4Eu, 0xCFCCE08Eu, 0x590672D9u, 0x1FE52048u },
+        { 0xDD309A70u, 0x21E00C58u, 0x37A407C8u, 0x13EF342Du },
+        { 0x147CC10Du, 0x2A580F6Fu, 0x858D09BAu, 0x18EB0138u },
+        { 0xD99BF150u, 0xB4EE134Au, 0xA6F04C28u, 0x1F25C186u },
+        { 0xC80176D2u, 0x7114CC0Eu, 0x28562F99u, 0x137798F4u },
+        { 0x7A01D486u, 0xCD59FF12u, 0x326BBB7Fu, 0x18557F31u },
+        { 0x188249A8u, 0xC0B07ED7u, 0x7F06AA5Fu, 0x1E6ADEFDu },
+        { 0x6F516E09u, 0xD86E4F46u, 0x6F642A7Bu, 0x1302CB5Eu },
+        { 0x0B25C98Bu, 0xCE89E318u, 0x0B3D351Au, 0x17C37E36u },
+        { 0x0DEF3BEEu, 0x822C5BDEu, 0x8E0C8261u, 0x1DB45DC3u },
+        { 0xC8B58575u, 0xF15BB96Au, 0x38C7D17Cu, 0x1290BA9Au },
+        { 0x7AE2E6D2u, 0x2DB2A7C5u, 0xC6F9C5DCu, 0x1734E940u },
+        { 0xD99BA086u, 0x391F51B6u, 0xF8B83753u, 0x1D022390u },
+        { 0x48014454u, 0x03B39312u, 0x9B732294u, 0x1221563Au },
+        { 0xDA019569u, 0x04A077D6u, 0x424FEB39u, 0x16A9ABC9u },
+        { 0x9081FAC3u, 0x45C895CCu, 0x92E3E607u, 0x1C5416BBu },
+        { 0xDA513CBAu, 0x8B9D5D9Fu, 0x3BCE6FC4u, 0x11B48E35u },
+        { 0xD0E58BE8u, 0xAE84B507u, 0x8AC20BB5u, 0x1621B1C2u },
+        { 0xC51EEEE3u, 0x1A25E249u, 0x2D728EA3u, 0x1BAA1E33u },
+        { 0x1B33554Du, 0xF057AD6Eu, 0xFC679925u, 0x114A52DFu },
+        { 0xA2002AA1u, 0x6C6D98C9u, 0xFB817F6Fu, 0x159CE797u },
+        { 0x0A803549u, 0x4788FEFCu, 0xFA61DF4Bu, 0x1B04217Du },
+        { 0x8690214Eu, 0x0CB59F5Du, 0xBC7D2B8Fu, 0x10E294EEu },
+        { 0xE83429A1u, 0xCFE30734u, 0x6B9C7672u, 0x151B3A2Au },
+        { 0x2241340Au, 0x83DBC902u, 0x0683940Fu, 0x1A6208B5u },
+        { 0x5568C086u, 0xB2695DA1u, 0x24123C89u, 0x107D4571u },
+        { 0xAAC2F0A7u, 0x1F03B509u, 0x6D16CBACu, 0x149C96CDu },
+        { 0x1573ACD1u, 0x26C4A24Cu, 0xC85C7E97u, 0x19C3BC80u },
+        { 0x8D684C03u, 0x783AE56Fu, 0x7D39CF1Eu, 0x101A55D0u },
+        { 0x70C25F03u, 0x16499ECBu, 0x9C8842E6u, 0x1420EB44u },
+        { 0x4CF2F6C4u, 0x9BDC067Eu, 0xC3AA539Fu, 0x19292615u },
+        { 0xE02FB476u, 0x82D3081Du, 0x3494E887u, 0x1F736F9Bu },
+        { 0xAC1DD0C9u, 0xB1C3E512u, 0x00DD1154u, 0x13A825C1u },
+        { 0x572544FCu, 0xDE34DE57u, 0x411455A9u, 0x18922F31u },
+        { 0x2CEE963Bu, 0x55C215EDu, 0x91596B14u, 0x1EB6BAFDu },
+        { 0x3C151DE5u, 0xB5994DB4u, 0x7AD7E2ECu, 0x133234DEu },
+        { 0x4B1A655Eu, 0xE2FFA121u, 0x198DDBA7u, 0x17FEC216u },
+        { 0x9DE0FEB6u, 0xDBBF8969u, 0x9FF15291u, 0x1DFE729Bu },
+        { 0x02AC9F31u, 0x2957B5E2u, 0x43F6D39Bu, 0x12BF07A1u },
+        { 0x8357C6FEu, 0xF3ADA35Au, 0x94F48881u, 0x176EC989u },
+        { 0x242DB8BDu, 0x70990C31u, 0xFA31AAA2u, 0x1D4A7BEBu },
+        { 0xB69C9376u, 0x865FA79Eu, 0x7C5F0AA5u, 0x124E8D73u },
+        { 0x6443B854u, 0xE7F79186u, 0x5B76CD4Eu, 0x16E230D0u },
+        { 0xFD54A669u, 0xA1F575E7u, 0x725480A2u, 0x1C9ABD04u },
+        { 0xFE54E801u, 0xA53969B0u, 0xC774D065u, 0x11E0B622u },
+        { 0x3DEA2202u, 0x0E87C41Du, 0x7952047Fu, 0x1658E3ABu },
+        { 0x8D64AA82u, 0xD229B524u, 0x57A6859Eu, 0x1BEF1C96u },
+        { 0xD85EEA91u, 0x435A1136u, 0xF6C81383u, 0x117571DDu },
+        { 0x8E76A536u, 0x14309584u, 0x747A1864u, 0x15D2CE55u },
+        { 0xB2144E83u, 0x193CBAE5u, 0xD1989E7Du, 0x1B4781EAu },
+        { 0x8F4CB112u, 0x2FC5F4CFu, 0xC2FF630Eu, 0x110CB132u },
+        { 0x731FDD56u, 0xBBB77203u, 0x73BF3BD1u, 0x154FDD7Fu },
+        { 0x4FE7D4ACu, 0x2AA54E84u, 0x50AF0AC6u, 0x1AA3D4DFu },
+        { 0xB1F0E4EBu, 0xDAA75112u, 0x926D66BBu, 0x10A6650Bu },
+        { 0x5E6D1E26u, 0xD1512557u, 0x7708C06Au, 0x14CFFE4Eu },
+        { 0x360865B0u, 0x85A56EADu, 0x14CAF085u, 0x1A03FDE2u },
+        { 0x41C53F8Eu, 0x7387652Cu, 0x4CFED653u, 0x10427EADu },
+        { 0x52368F71u, 0x50693E77u, 0xA03E8BE8u, 0x14531E58u },
+        { 0x26C4334Eu, 0x64838E15u, 0xC84E2EE2u, 0x1967E5EEu },
+        { 0x70754022u, 0xFDA4719Au, 0x7A61BA9Au, 0x1FC1DF6Au },
+        { 0x86494815u, 0xDE86C700u, 0x8C7D14A0u, 0x13D92BA2u },
+        { 0xA7DB9A1Au, 0x162878C0u, 0x2F9C59C9u, 0x18CF768Bu },
+        { 0xD1D280A1u, 0x5BB296F0u, 0xFB83703Bu, 0x1F03542Du },
+        { 0x83239064u, 0x194F9E56u, 0xBD322625u, 0x1362149Cu },
+        { 0x23EC747Eu, 0x5FA385ECu, 0xEC7EAFAEu, 0x183A99C3u },
+        { 0x2CE7919Du, 0xF78C6767u, 0xE79E5B99u, 0x1E494034u },
+        { 0x7C10BB02u, 0x3AB7C0A0u, 0x10C2F940u, 0x12EDC821u },
+        { 0x9B14E9C3u, 0x4965B0C8u, 0x54F3B790u, 0x17A93A29u },
+        { 0xC1DA2433u, 0x5BBF1CFAu, 0xAA30A574u, 0x1D9388B3u },
+        { 0xB92856A0u, 0xB957721Cu, 0x4A5E6768u, 0x127C3570u },
+        { 0xE7726C48u, 0xE7AD4EA3u, 0x5CF60142u, 0x171B42CCu },
+        { 0xE14F075Au, 0xA198A24Cu, 0x74338193u, 0x1CE2137Fu },
+        { 0x0CD16498u, 0x44FF6570u, 0xA8A030FCu, 0x120D4C2Fu },
+        { 0x1005BDBEu, 0x563F3ECCu, 0x92C83D3Bu, 0x16909F3Bu },
+        { 0x14072D2Eu, 0x2BCF0E7Fu, 0x777A4C8Au, 0x1C34C70Au },
+        { 0x6C847C3Du, 0x5B61690Fu, 0x8AAC6FD6u, 0x11A0FC66u },
+        { 0x47A59B4Cu, 0xF239C353u, 0x2D578BCBu, 0x16093B80u },
+        { 0x198F021Fu, 0xEEC83428u, 0x38AD6EBEu, 0x1B8B8A60u },
+        { 0x0FF96153u, 0x553D2099u, 0x236C6537u, 0x1137367Cu },
+        { 0x53F7B9A8u, 0x2A8C68BFu, 0x2C477E85u, 0x1585041Bu },
+        { 0x28F5A812u, 0x752F82EFu, 0xF7595E26u, 0x1AE64521u },
+        { 0x7999890Bu, 0x093DB1D5u, 0x3A97DAD8u, 0x10CFEB35u },
+        { 0xD7FFEB4Eu, 0x0B8D1E4Au, 0x893DD18Eu, 0x1503E602u },
+        { 0x8DFFE622u, 0x8E7065DDu, 0x2B8D45F1u, 0x1A44DF83u },
+        { 0x78BFEFD5u, 0xF9063FAAu, 0xFB384BB6u, 0x106B0BB1u },
+        { 0x16EFEBCAu, 0xB747CF95u, 0x7A065EA4u, 0x1485CE9Eu },
+        { 0x5CABE6BDu, 0xE519C37Au, 0x1887F64Du, 0x19A74246u },
+        { 0x79EB7036u, 0xAF301A2Cu, 0xCF54F9F0u, 0x1008896Bu },
+        { 0x98664C43u, 0xDAFC20B7u, 0xC32A386Cu, 0x140AABC6u },
+        { 0x7E7FDF54u, 0x11BB28E5u, 0x73F4C688u, 0x190D56B8u },
+        { 0xDE1FD72Au, 0x1629F31Eu, 0x90F1F82Au, 0x1F50AC66u },
+        { 0x4AD3E67Au, 0x4DDA37F3u, 0x1A973B1Au, 0x13926BC0u },
+        { 0x1D88E019u, 0xE150C5F0u, 0x213D09E0u, 0x187706B0u },
+        { 0x24EB181Fu, 0x19A4F76Cu, 0x298C4C59u, 0x1E94C85Cu },
+        { 0x9712EF13u, 0xB0071AA3u, 0x99F7AFB7u, 0x131CFD39u },
+        { 0x7CD7AAD8u, 0x9C08E14Cu, 0x00759BA5u, 0x17E43C88u },
+        { 0x9C0D958Eu, 0x030B199Fu, 0x0093028Fu, 0x1DDD4BAAu },
+        { 0xC1887D79u, 0x61E6F003u, 0x405BE199u, 0x12AA4F4Au },
+        { 0xB1EA9CD7u, 0xBA60AC04u, 0xD072D9FFu, 0x1754E31Cu },
+        { 0xDE65440Du, 0xA8F8D705u, 0x048F907Fu, 0x1D2A1BE4u },
+        { 0xAAFF4A88u, 0xC99B8663u, 0x82D9BA4Fu, 0x123A516Eu },
+        { 0x95BF1D2Au, 0xBC0267FCu, 0x239028E3u, 0x16C8E5CAu },
+        { 0xBB2EE474u, 0xAB0301FBu, 0xAC74331Cu, 0x1C7B1F3Cu },
+        { 0x54FD4EC9u, 0xEAE1E13Du, 0xEBC89FF1u, 0x11CCF385u },
+        { 0xAA3CA27Bu, 0x659A598Cu, 0x66BAC7EEu, 0x16403067u },
+        { 0xD4CBCB1Au, 0xFF00EFEFu, 0x406979E9u, 0x1BD03C81u },
+        { 0xE4FF5EF0u, 0x3F6095F5u, 0xC841EC32u, 0x116225D0u },
+        { 0x5E3F36ACu, 0xCF38BB73u, 0xFA52673Eu, 0x15BAAF44u },
+        { 0x35CF0457u, 0x8306EA50u, 0x38E7010Eu, 0x1B295B16u },
+        { 0x21A162B6u, 0x11E45272u, 0xE39060A9u, 0x10F9D8EDu },
+        { 0xAA09BB64u, 0x565D670Eu, 0x5C7478D3u, 0x15384F29u },
+        { 0x548C2A3Du, 0x2BF4C0D2u, 0xB3919708u, 0x1A8662F3u },
+        { 0x74D79A66u, 0x1B78F883u, 0x503AFE65u, 0x1093FDD8u },
+        { 0x520D8100u, 0x625736A4u, 0x6449BDFEu, 0x14B8FD4Eu },
+        { 0x6690E140u, 0xFAED044Du, 0xFD5C2D7Du, 0x19E73CA1u },
+        { 0x601A8CC8u, 0xBCD422B0u, 0x3E599C6Eu, 0x103085E5u },
+        { 0x78212FFAu, 0x6C092B5Cu, 0x8DF0038Au, 0x143CA75Eu },
+        { 0x96297BF8u, 0x070B7633u, 0x316C046Du, 0x194BD136u },
+        { 0x7BB3DAF6u, 0x48CE53C0u, 0xBDC70588u, 0x1F9EC583u },
+        { 0x4D5068DAu, 0x2D80F458u, 0x569C6375u, 0x13C33B72u },
+        { 0x60A48310u, 0x78E1316Eu, 0xEC437C52u, 0x18B40A4Eu }
+    };
+    const uint32_t* words = is_inverse ? inverse_powers_of_five[power] : powers_of_five[power];
+    uint64_t low = (uint64_t)words[0] | ((uint64_t)words[1] << 32);
+    uint64_t high = (uint64_t)words[2] | ((uint64_t)words[3] << 32);
+
+    /* The 192-bit product's bits above 64 are ((m * low) >> 64) + (m * high), the result is those shifted by the */
+    /* remaining (shift - 64) bits which is always in the (0, 64) range. */
+    #ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 uint128_t; /* Not standard C so -pedantic is told it's intended */
+        uint128_t sum = (((uint128_t)m * low) >> 64) + (uint128_t)m * high;
+        return (uint64_t)(sum >> (shift - 64));
+    #else
+        /* Without 128-bit integers, multiply using 32-bit halves */
+        uint64_t m_low = m & 0xFFFFFFFF, m_high = m >> 32;
+        uint64_t cross, low_high, product_high, product_low;
+
+        /* Upper 64 bits of m * low */
+        cross = (m_low * (low & 0xFFFFFFFF)) >> 32;
+        cross += m_high * (low & 0xFFFFFFFF);
+        low_high = (cross & 0xFFFFFFFF) + m_low * (low >> 32);
+        low_high = m_high * (low >> 32) + (cross >> 32) + (low_high >> 32);
+
+        /* All 128 bits of m * high */
+        uint64_t a = m_low * (high & 0xFFFFFFFF), b = m_low * (high >> 32);
+        uint64_t c = m_high * (high & 0xFFFFFFFF), d = m_high * (high >> 32);
+        uint64_t middle = (a >> 32) + (b & 0xFFFFFFFF) + (c & 0xFFFFFFFF);
+        product_low = (a & 0xFFFFFFFF) | (middle << 32);
+        product_high = d + (b >> 32) + (c >> 32) + (middle >> 32);
+
+        product_low += low_high;
+        if (product_low < low_high) /* Carry */
+            product_high++;
+        return (product_high << (64 - (shift - 64))) | (product_low >> (shift - 64));
+    #endif
+}
+
+uint32_t hojson_factors_of_five(uint64_t value) {
+    uint32_t count = 0;
+    while (value != 0 && value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count;
+}
+
+hojson_code_t hojson_splitter_error(hojson_splitter_t* splitter) {
+    switch (splitter->state) {
+    case HOJSON_STATE_ERROR_IO: return HOJSON_ERROR_IO;
+    case HOJSON_STATE_ERROR_SYNTAX: return HOJSON_ERROR_SYNTAX;
+    default: return HOJSON_ERROR_INTERNAL;
+    }
+}
+
+hojson_code_t hojson_validator_error(hojson_validator_t* validator) {
+    switch (validator->state) {
+    case HOJSON_STATE_ERROR_INSUFFICIENT_MEMORY: return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    case HOJSON_STATE_ERROR_TOKEN_MISMATCH: return HOJSON_ERROR_TOKEN_MISMATCH;
+    case HOJSON_STATE_ERROR_SYNTAX: return HOJSON_ERROR_SYNTAX;
+    default: return HOJSON_ERROR_INTERNAL;
+    }
+}
+
+hojson_code_t hojson_scan_write(hojson_validator_t* validator, const char** run, const char* at) {
+    /* Write the run of UTF-8 content that's been validated, but not yet written, up to the given position */
+    hojson_code_t code = HOJSON_NO_OP;
+    if (validator->encoding < HOJSON_ENCODING_UTF_16_LE && at > *run)
+        code = hojson_writer_put(validator->output, *run, (size_t)(at - *run));
+    *run = at;
+    return code;
+}
+
+hojson_code_t hojson_scan_indent(hojson_validator_t* validator, uint32_t depth) {
+    /* Write a line break followed by enough spaces to indent the given depth */
+    static const char spaces[] = "                                ";
+    size_t spaces_remaining = (size_t)depth * validator->indent;
+    hojson_code_t code = hojson_writer_put_ascii(validator->output, "\n", 1);
+    while (spaces_remaining > 0 && code >= HOJSON_NO_OP) {
+        size_t spaces_to_write = spaces_remaining < sizeof(spaces) - 1 ? spaces_remaining : sizeof(spaces) - 1;
+        code = hojson_writer_put_ascii(validator->output, spaces, spaces_to_write);
+        spaces_remaining -= spaces_to_write;
+    }
+    return code;
+}
+
+size_t hojson_string_length(const char* str, size_t str_length, uint8_t is_ascii) {
+    /* Find the length of the leading run of bytes, within a string, that don't end the string or begin an escape: */
+    /* anything but a double quote ("), a backslash (\), or a null terminator. If 'is_ascii' is set, the run also */
+    /* stops at the first byte of a multi-byte UTF-8 character, 0x80 or greater, so it can be decoded. */
+    size_t length = 0;
+    #ifdef HOJSON_SSE2
+        const __m128i quotes = _mm_set1_epi8('"');
+        const __m128i backslashes = _mm_set1_epi8('\\');
+        const __m128i zeroes = _mm_setzero_si128();
+        while (length + 16 <= str_length) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(str + length));
+            int special = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quotes),
+                _mm_cmpeq_epi8(bytes, backslashes)), _mm_cmpeq_epi8(bytes, zeroes)));
+            if (is_ascii) /* Each byte's most significant bit is set from 0x80 up */
+                special |= _mm_movemask_epi8(bytes);
+            if (special != 0) /* If any of these 16 bytes is special */
+                break; /* The loop below will find exactly which */
+            length += 16;
+        }
+    #endif
+    while (length < str_length && str[length] != '"' && str[length] != '\\' && str[length] != '\0' &&
+            (!is_ascii || (uint8_t)str[length] < 0x80))
+        length++;
+    return length;
+}
+
+size_t hojson_escape_free_length(const char* str, size_t str_length) {
+    /* Find the length of the leading run of characters that can be written as-is: anything but a double quote ("), */
+    /* a backslash (\), a control character, or UTF-8 that isn't well-formed */
+    size_t length = 0;
+    while (length < str_length) {
+        #ifdef HOJSON_SSE2
+            const __m128i quotes = _mm_set1_epi8('"');
+            const __m128i backslashes = _mm_set1_epi8('\\');
+            const __m128i spaces = _mm_set1_epi8(' ');
+            while (length + 16 <= str_length) {
+                __m128i bytes = _mm_loadu_si128((const __m128i*)(str + length));
+                /* A byte is at least a space (0x20) if the unsigned maximum of it and a space is the byte itself */
+                int printable = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(bytes, spaces), bytes));
+                int special = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, quotes),
+                    _mm_cmpeq_epi8(bytes, backslashes))) | _mm_movemask_epi8(bytes); /* The last is each top bit */
+                if (printable != 0xFFFF || special != 0) /* If any of these 16 bytes must be escaped or checked */
+                    break; /* The code below will find exactly which */
+                length += 16;
+            }
+            if (length == str_length)
+                break;
+        #endif
+        uint8_t byte = (uint8_t)str[length];
+        if (byte < 0x80) { /* ASCII */
+            if (byte < ' ' || byte == '"' || byte == '\\')
+                break;
+            length++;
+        } else { /* The first byte of a multi-byte UTF-8 character */
+            size_t bytes = hojson_utf8_length(str + length, str_length - length);
+            if (bytes == 0)
+                break;
+            length += bytes;
+        }
+    }
+    return length;
+}
+
+size_t hojson_utf8_length(const char* str, size_t str_length) {
+    /* Find the length of the well-formed UTF-8 character the string begins with, or zero if it's cut short or not */
+    /* well-formed. Every byte after the first must begin with 10, and the first byte's ranges rule out overlong */
+    /* encodings, surrogates (U+D800 to U+DFFF), and values past U+10FFFF. */
+    const uint8_t* bytes = (const uint8_t*)str;
+    uint8_t low = 0x80, high = 0xBF; /* The range of the second byte */
+    size_t length, i;
+    if (str_length == 0)
+        return 0;
+    else if (bytes[0] < 0x80)
+        return 1;
+    else if (bytes[0] >= 0xC2 && bytes[0] <= 0xDF)
+        length = 2;
+    else if (bytes[0] >= 0xE0 && bytes[0] <= 0xEF) {
+        length = 3;
+        if (bytes[0] == 0xE0) /* Anything less would fit in two bytes */
+            low = 0xA0;
+        else if (bytes[0] == 0xED) /* Anything more would be a surrogate */
+            high = 0x9F;
+    } else if (bytes[0] >= 0xF0 && bytes[0] <= 0xF4) {
+        length = 4;
+        if (bytes[0] == 0xF0) /* Anything less would fit in three bytes */
+            low = 0x90;
+        else if (bytes[0] == 0xF4) /* Anything more would be past U+10FFFF */
+            high = 0x8F;
+    } else
+        return 0;
+    if (length > str_length || bytes[1] < low || bytes[1] > high)
+        return 0;
+    for (i = 2; i < length; i++) {
+        if ((bytes[i] & 0xC0) != 0x80)
+            return 0;
+    }
+    return length;
+}
+
 #ifdef _MSC_VER
     #pragma warning(pop) /* Supress MSVC warning C6011 due to false positives */
 #endif /* _MSC_VER */
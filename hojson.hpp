@@ -0,0 +1,396 @@
+/*
+Copyright (c) 2024 Luke Philipsen
+
+Permission to use, copy, modify, and/or distribute this software for
+any purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Usage
+
+  This is a C++17 wrapper of hojson. hojson.h is included by this file and must be in the same directory. Do this:
+    #define HOJSON_IMPLEMENTATION
+  before you include this file, or hojson.h, in *one* C or C++ file to create the implementation.
+
+  A parser owns its context and buffer. It's fed content, as hojson_feed() is, and then iterated over for events:
+    hojson::parser parser;
+    parser.feed(content);
+    for (auto& event : parser) {
+        ...
+    }
+  Iteration stops at the end of the document, at the end of the content fed so far, or at an error, which code() then
+  tells apart. Events are only valid until the next is iterated to and their names and strings are views of the
+  parser's buffer, so nothing is copied to provide them.
+
+  The encoding a parser is built for and the options it's built with are template parameters, so the wrapper's own
+  work for each event, such as measuring names and strings or growing the buffer, is chosen at compile time. Parsing
+  itself is not: every parser calls the same hojson_next(), which still detects the encoding and tests the options
+  set on the context. Only compiling hojson with HOJSON_UTF8_ONLY removes UTF-16 from parsing, and parsers are then
+  built for UTF-8 by default.
+
+  With C++20 coroutines, HOJSON_COROUTINES is defined and parsing may be a coroutine of its own, with parse_async(),
+  that awaits content as it arrives and yields events to the coroutine awaiting them:
+    hojson::async_events events = hojson::parse_async(parser, [&] { return socket.read(); });
+    while (const hojson::event* event = co_await events.next()) {
+        ...
+    }
+*/
+
+#ifndef HOJSON_HPP
+    #define HOJSON_HPP
+
+#include <cstddef> /* std::ptrdiff_t, std::size_t */
+#include <cstdint> /* std::uint32_t */
+#include <iterator> /* std::input_iterator_tag */
+#include <memory_resource> /* std::pmr::polymorphic_allocator */
+#include <new> /* std::bad_alloc */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    #define HOJSON_COROUTINES
+    #include <coroutine> /* std::coroutine_handle, std::suspend_always */
+    #include <exception> /* std::current_exception(), std::exception_ptr, std::rethrow_exception() */
+    #include <utility> /* std::exchange() */
+#endif
+
+#include "hojson.h"
+
+namespace hojson {
+
+/**
+ * Character encodings a parser may be built for.
+ */
+enum class encoding {
+    detect, /**< UTF-8, or UTF-16 with a byte order marker, as hojson_parse() detects. Names and strings are provided
+                 in the document's encoding. */
+    utf8 /**< UTF-8 alone. Names and strings are measured as UTF-8, so a UTF-16 document fails with
+              HOJSON_ERROR_INVALID_INPUT rather than providing them. */
+};
+
+/**
+ * The encoding parsers are built for unless told otherwise.
+ */
+#ifdef HOJSON_UTF8_ONLY
+    inline constexpr encoding default_encoding = encoding::utf8;
+#else
+    inline constexpr encoding default_encoding = encoding::detect;
+#endif /* HOJSON_UTF8_ONLY */
+
+/**
+ * Optional features of a parser, combined with |.
+ */
+enum options : unsigned {
+    none = 0, /**< Nothing but events. */
+    raw_numbers = 1, /**< A number's text, as it appeared, is provided along with its value. */
+    grow_buffer = 2, /**< The buffer is doubled, up to a limit, when it's too short rather than parsing failing. */
+    multi_document = 4 /**< A stream of documents is parsed and the end of each is an event of its own. */
+};
+
+/**
+ * A code returned by the parser along with the name and value it made available.
+ */
+struct event {
+    hojson_code_t code; /**< HOJSON_NAME through HOJSON_ARRAY_END or, parsing multiple documents, the end of one. */
+    hojson_type_t type; /**< The type of the value with HOJSON_VALUE. */
+    std::uint32_t depth; /**< The nested level of objects/arrays in which the element was found. */
+    std::string_view name; /**< The name of a name-value pair, object, or array. Its data is null if it has none. */
+    std::string_view string; /**< A string value, in the document's encoding, or, with raw_numbers, a number's text. */
+    long integer; /**< The value with HOJSON_TYPE_INTEGER. */
+    double floating; /**< The value with HOJSON_TYPE_FLOAT. */
+    bool boolean; /**< The value with HOJSON_TYPE_BOOLEAN. */
+
+    /**
+     * @return True if the element has a name, even if the name is empty.
+     */
+    bool has_name() const noexcept { return name.data() != nullptr; }
+};
+
+/**
+ * A hojson context and the buffer it uses, allocated with the given allocator and freed with the parser.
+ *
+ * @tparam Encoding The encoding of the content the parser is fed.
+ * @tparam Options Optional features, combined with |.
+ * @tparam Allocator Allocator of the buffer.
+ */
+template <encoding Encoding = default_encoding, unsigned Options = none,
+    class Allocator = std::pmr::polymorphic_allocator<char>>
+class basic_parser {
+public:
+    /**
+     * Marks the end of iteration.
+     */
+    struct sentinel {};
+
+    /**
+     * Iterates over events, parsing as it's incremented.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = event;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const event*;
+        using reference = const event&;
+
+        explicit iterator(basic_parser* parser) noexcept : parser_(parser) {}
+        reference operator*() const noexcept { return parser_->event_; }
+        pointer operator->() const noexcept { return &parser_->event_; }
+        iterator& operator++() { parser_->next(); return *this; }
+        void operator++(int) { parser_->next(); }
+        friend bool operator==(const iterator& it, sentinel) noexcept { return it.is_end(); }
+        friend bool operator!=(const iterator& it, sentinel) noexcept { return !it.is_end(); }
+        friend bool operator==(sentinel, const iterator& it) noexcept { return it.is_end(); }
+        friend bool operator!=(sentinel, const iterator& it) noexcept { return !it.is_end(); }
+
+    private:
+        bool is_end() const noexcept { return !parser_->has_event(); }
+
+        basic_parser* parser_;
+    };
+
+    /**
+     * @param buffer_length The length, in bytes, of the buffer hojson uses. See hojson_init().
+     * @param max_buffer_length With grow_buffer, the length the buffer may be doubled up to.
+     * @param allocator Allocator of the buffer.
+     */
+    explicit basic_parser(std::size_t buffer_length = 4096, std::size_t max_buffer_length = std::size_t(1) << 26,
+            const Allocator& allocator = Allocator())
+            : buffer_(buffer_length > 0 ? buffer_length : 1, allocator), max_buffer_length_(max_buffer_length) {
+        hojson_init(&context_, buffer_.data(), buffer_.size());
+        if constexpr ((Options & multi_document) != 0)
+            hojson_set_multi_document(&context_, 1);
+    }
+
+    /* The context points into the buffer so the two stay where they are */
+    basic_parser(const basic_parser&) = delete;
+    basic_parser& operator=(const basic_parser&) = delete;
+
+    /**
+     * Hand the parser the next bytes of content, as hojson_feed() does. They're parsed where they are and must not be
+     * changed until iteration stops with HOJSON_ERROR_UNEXPECTED_EOF.
+     *
+     * @param json The next bytes of JSON content.
+     * @return HOJSON_NO_OP, or HOJSON_ERROR_INVALID_INPUT if the previous bytes have yet to be consumed.
+     */
+    hojson_code_t feed(std::string_view json) noexcept { return hojson_feed(&context_, json.data(), json.size()); }
+
+    /**
+     * Parse up to the first event. Each call continues where iteration last stopped.
+     *
+     * @return An iterator at the first event.
+     */
+    iterator begin() { next(); return iterator(this); }
+
+    /**
+     * @return The end of iteration.
+     */
+    sentinel end() const noexcept { return sentinel(); }
+
+    /**
+     * The code iteration stopped with, or the current event's.
+     *
+     * @return HOJSON_END_OF_DOCUMENT once the document has been parsed, HOJSON_ERROR_UNEXPECTED_EOF once the content
+     *         fed has been consumed, or an error.
+     */
+    hojson_code_t code() const noexcept { return code_; }
+
+    /**
+     * @return The context, for its line, column, and other details.
+     */
+    const hojson_context_t& context() const noexcept { return context_; }
+
+    /**
+     * @return The length, in bytes, of the buffer, which may have grown.
+     */
+    std::size_t buffer_length() const noexcept { return buffer_.size(); }
+
+private:
+    bool has_event() const noexcept {
+        if constexpr ((Options & multi_document) != 0)
+            return code_ >= HOJSON_END_OF_DOCUMENT;
+        else
+            return code_ > HOJSON_END_OF_DOCUMENT;
+    }
+
+    void next() {
+        hojson_code_t code = hojson_next(&context_);
+        if constexpr ((Options & grow_buffer) != 0) {
+            while (code == HOJSON_ERROR_INSUFFICIENT_MEMORY && grow())
+                code = hojson_next(&context_);
+        }
+        if constexpr (Encoding == encoding::utf8) {
+            /* Its names and strings can't be measured as UTF-8, so it fails rather than providing them cut short */
+            if (code >= HOJSON_END_OF_DOCUMENT && context_.encoding >= HOJSON_ENCODING_UTF_16_LE)
+                code = HOJSON_ERROR_INVALID_INPUT;
+        }
+        code_ = code;
+        event_.code = code;
+        if (code < HOJSON_END_OF_DOCUMENT) /* If iteration stops here, there's nothing more to provide */
+            return;
+
+        event_.type = context_.value_type;
+        event_.depth = context_.depth;
+        event_.name = view(context_.name);
+        event_.integer = context_.integer_value;
+        event_.floating = context_.float_value;
+        event_.boolean = context_.bool_value != 0;
+        if (context_.value_type == HOJSON_TYPE_STRING)
+            event_.string = view(context_.string_value);
+        else if constexpr ((Options & raw_numbers) != 0) {
+            /* A number's text is ASCII, a byte per character, in any encoding */
+            event_.string = (context_.value_type == HOJSON_TYPE_INTEGER || context_.value_type == HOJSON_TYPE_FLOAT)
+                && context_.string_value != nullptr ? std::string_view(context_.string_value) : std::string_view();
+        } else
+            event_.string = std::string_view();
+    }
+
+    std::string_view view(const char* str) const noexcept {
+        if (str == nullptr)
+            return std::string_view();
+        if constexpr (Encoding == encoding::detect) {
+            if (context_.encoding >= HOJSON_ENCODING_UTF_16_LE) { /* Terminated by a zero code unit, two bytes long */
+                std::size_t length = 0;
+                while (str[length] != '\0' || str[length + 1] != '\0')
+                    length += 2;
+                return std::string_view(str, length);
+            }
+        }
+        return std::string_view(str);
+    }
+
+    bool grow() {
+        if (buffer_.size() >= max_buffer_length_)
+            return false;
+        try {
+            std::vector<char, Allocator> buffer(buffer_.size() > max_buffer_length_ / 2 ? max_buffer_length_ :
+                buffer_.size() * 2, buffer_.get_allocator());
+            hojson_realloc(&context_, buffer.data(), buffer.size());
+            buffer_.swap(buffer); /* The old buffer is freed as this one goes out of scope */
+        } catch (const std::bad_alloc&) {
+            return false; /* Parsing fails with HOJSON_ERROR_INSUFFICIENT_MEMORY, as it would have */
+        }
+        return true;
+    }
+
+    hojson_context_t context_;
+    std::vector<char, Allocator> buffer_;
+    std::size_t max_buffer_length_;
+    hojson_code_t code_ = HOJSON_NO_OP;
+    event event_ = {};
+};
+
+/**
+ * A parser with everything left to its defaults.
+ */
+using parser = basic_parser<>;
+
+#ifdef HOJSON_COROUTINES
+/**
+ * Events parsed by a coroutine, made with parse_async(), for the coroutine awaiting them. Parsing only happens while
+ * an event is awaited and, if it has to wait for content, both coroutines are suspended until the content arrives.
+ * Destroying the events destroys the parsing coroutine, which mustn't be done while it's waiting for content.
+ */
+class async_events {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /* Hands control from the parsing coroutine to the one awaiting its events */
+    struct yield_awaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_type handle) const noexcept { return handle.promise().consumer; }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        const event* current = nullptr; /* The event yielded or null once parsing has stopped */
+        std::coroutine_handle<> consumer; /* The coroutine awaiting an event */
+        std::exception_ptr exception; /* Thrown while parsing, such as by a read, for the consumer */
+
+        async_events get_return_object() noexcept { return async_events(handle_type::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        yield_awaiter final_suspend() const noexcept { return {}; }
+        yield_awaiter yield_value(const event& yielded) noexcept { current = &yielded; return {}; }
+        void return_void() noexcept { current = nullptr; }
+        void unhandled_exception() noexcept { current = nullptr; exception = std::current_exception(); }
+    };
+
+    /* Hands control from the coroutine awaiting an event to the parsing coroutine */
+    struct next_awaiter {
+        handle_type handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) const noexcept {
+            handle.promise().consumer = consumer;
+            return handle;
+        }
+        const event* await_resume() const {
+            if (handle && handle.promise().exception)
+                std::rethrow_exception(handle.promise().exception);
+            return handle && !handle.done() ? handle.promise().current : nullptr;
+        }
+    };
+
+    async_events(async_events&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    async_events& operator=(async_events&& other) noexcept {
+        if (this != &other) {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~async_events() {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    /**
+     * Parse up to the next event, suspending the awaiting coroutine while content is waited for.
+     *
+     * @return An awaitable whose result points to the event, valid until the next is awaited, or is null once parsing
+     *         has stopped. The parser's code() then tells why. An exception thrown while reading is rethrown.
+     */
+    next_awaiter next() const noexcept { return next_awaiter{ handle_ }; }
+
+private:
+    explicit async_events(handle_type handle) noexcept : handle_(handle) {}
+
+    handle_type handle_;
+};
+
+/**
+ * Parse as a coroutine that, whenever the content fed so far has been consumed, reads more and awaits it, in place of
+ * the loop that would otherwise feed the parser as content arrives.
+ *
+ * @param parser A parser, which must outlive the events. Content already fed to it is parsed first.
+ * @param read A callable returning an awaitable whose result converts to std::string_view. It's the next bytes of
+ *             content, which must be left unchanged until read is called again, or none once there are no more.
+ * @return The events, which are parsed as they're awaited.
+ */
+template <encoding Encoding, unsigned Options, class Allocator, class Read>
+async_events parse_async(basic_parser<Encoding, Options, Allocator>& parser, Read read) {
+    while (true) {
+        for (auto& event : parser)
+            co_yield event;
+        if (parser.code() != HOJSON_ERROR_UNEXPECTED_EOF) /* If the document ended or parsing failed */
+            co_return;
+
+        std::string_view bytes = co_await read();
+        if (bytes.empty()) /* If there's no more content, the parser's code is left as unexpected EoF */
+            co_return;
+        parser.feed(bytes); /* The previous bytes were consumed so these are accepted */
+    }
+}
+#endif /* HOJSON_COROUTINES */
+
+} /* namespace hojson */
+
+#endif /* HOJSON_HPP */
@@ -0,0 +1,1285 @@
+/*
+Copyright (c) 2024 Luke Philipsen
+
+Permission to use, copy, modify, and/or distribute this software for
+any purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Usage
+
+  This is an extension of hojson that reads JSON content from files on hojson's behalf. Do this:
+    #define HOJSON_IMPLEMENTATION
+    #define HOJSON_IO_IMPLEMENTATION
+  before you include this file in *one* C or C++ file to create the implementation. hojson.h is included by this
+  file and must be in the same directory.
+
+  Files are mapped into memory with mmap() or, on Windows, MapViewOfFile(). With strict compiler flags, like -std=c89,
+  define _POSIX_C_SOURCE as 200112L or greater before including any system header so the kernel may be advised of how
+  mapped files will be read.
+
+  Prefetching reads on a thread of its own, with POSIX threads (link with -pthread) or the Win32 API, and allocates its
+  chunks with malloc().
+
+  Asynchronous file reads use io_uring on Linux if HOJSON_IO_URING is defined, which requires syscall() so, with strict
+  compiler flags, define _DEFAULT_SOURCE too. Elsewhere, or if io_uring is unavailable at run time, files are read
+  with pread() or ReadFile().
+*/
+
+#ifndef HOJSON_IO_H
+    #define HOJSON_IO_H
+
+#include "hojson.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif /* __cpluspus */
+
+/***************/
+/* Definitions */
+
+/**
+ * A file mapped into memory in its entirety. Some of this information is public and some is private and only makes
+ * sense to hojson.
+ */
+typedef struct {
+    /* Public */
+    const char* data; /**< The file's content. Valid until the source is closed. */
+    size_t length; /**< Length of the file's content in bytes. */
+
+    /* Private (for internal use) */
+    uint8_t is_mapped; /* Set by hojson_mmap_open() if 'data' points to a mapping that must be undone */
+#ifdef _WIN32
+    void* file; /* Handle of the open file */
+    void* mapping; /* Handle of the file mapping object */
+#endif /* _WIN32 */
+} hojson_mmap_source_t;
+
+/**
+ * Map a file into memory, read-only, and advise the kernel that it will be read once from beginning to end so pages
+ * are read ahead of the parser and dropped behind it.
+ *
+ * @param source Pointer to an allocated source object. This instance will be modified.
+ * @param path Path to the file.
+ * @return HOJSON_NO_OP on success, HOJSON_ERROR_IO if the file couldn't be opened or mapped, or
+ *         HOJSON_ERROR_INVALID_INPUT.
+ */
+HOJSON_DECL hojson_code_t hojson_mmap_open(hojson_mmap_source_t* source, const char* path);
+
+/**
+ * Unmap and close a file opened with hojson_mmap_open(). Any names or values taken from its content by the parser
+ * remain valid because they're copied into the context's buffer, but the content itself does not.
+ *
+ * @param source A source opened with hojson_mmap_open().
+ */
+HOJSON_DECL void hojson_mmap_close(hojson_mmap_source_t* source);
+
+/**
+ * Parse a mapped file as a single JSON content string, without copying it and without ever resuming from
+ * HOJSON_ERROR_UNEXPECTED_EOF partway through. Called repeatedly, like hojson_parse(), for each code in turn.
+ *
+ * @param context An initialized hojson context object.
+ * @param source A source opened with hojson_mmap_open().
+ * @return The same codes as hojson_parse(). An empty file is HOJSON_ERROR_UNEXPECTED_EOF. Once the file has run out,
+ *         HOJSON_ERROR_UNEXPECTED_EOF is returned again for every later call.
+ */
+HOJSON_DECL hojson_code_t hojson_parse_file(hojson_context_t* context, const hojson_mmap_source_t* source);
+
+/**
+ * A thread reading content ahead of the parser into a ring of chunks. All of it is private.
+ */
+typedef struct _hojson_prefetch_t hojson_prefetch_t;
+
+/**
+ * Start a thread that reads content into a ring of chunks while the parser works through those already read. Each
+ * chunk is filled completely, with as many reads as it takes, unless the content ends first. The ring itself is
+ * lock-free. The threads only wait on each other when the ring is full or empty.
+ *
+ * @param read Callback that reads content. It's called on the prefetching thread and zero bytes read means the content
+ *             has ended.
+ * @param user_data Pointer passed along to the read callback.
+ * @param chunk_length Length of each chunk in bytes, at least 4, or zero for 1 MiB.
+ * @param chunk_count Number of chunks in the ring, at least 2, or zero for 4.
+ * @return The prefetcher, or NULL if memory couldn't be allocated, the thread couldn't be created, or the parameters
+ *         were unacceptable.
+ */
+HOJSON_DECL hojson_prefetch_t* hojson_prefetch_start(hojson_read_t read, void* user_data, size_t chunk_length,
+    uint32_t chunk_count);
+
+/**
+ * Begin or continue parsing content read by a prefetcher. Chunks are handed to hojson_parse() where they are, without
+ * copies, and each is returned to the ring to be read into again once the parser has moved past it. Any name or
+ * string value that began in it was copied into the context's buffer by then.
+ *
+ * @param context An initialized hojson context object.
+ * @param prefetch A prefetcher from hojson_prefetch_start().
+ * @return The same codes as hojson_parse(). HOJSON_ERROR_UNEXPECTED_EOF means all content has been parsed.
+ *         HOJSON_ERROR_IO means the read callback failed.
+ */
+HOJSON_DECL hojson_code_t hojson_parse_prefetched(hojson_context_t* context, hojson_prefetch_t* prefetch);
+
+/**
+ * Stop a prefetcher, even if content remains, wait for its thread to end, and free it.
+ *
+ * @param prefetch A prefetcher from hojson_prefetch_start(), or NULL.
+ */
+HOJSON_DECL void hojson_prefetch_stop(hojson_prefetch_t* prefetch);
+
+/**
+ * A file being read with several reads in flight at once. All of it is private.
+ */
+typedef struct _hojson_async_file_t hojson_async_file_t;
+
+/**
+ * Open a regular file to be read, a chunk at a time, with io_uring. Reads of the next chunks are kept in flight while
+ * the parser works through the current one and their buffers are registered with the kernel, if allowed, to save it
+ * from mapping them for every read. If io_uring is unavailable, or not compiled in, chunks are read one at a time with
+ * pread(), or ReadFile() on Windows, when the parser needs them.
+ *
+ * @param path Path to the file.
+ * @param chunk_length Length of each read in bytes, at least 4, or zero for 1 MiB.
+ * @param queue_depth Number of reads in flight and chunks held in memory, or zero for 8. One means reading
+ *                    synchronously, as if io_uring were unavailable. Reading synchronously holds two chunks.
+ * @return The file, or NULL if it couldn't be opened, memory couldn't be allocated, or the parameters were
+ *         unacceptable.
+ */
+HOJSON_DECL hojson_async_file_t* hojson_async_open(const char* path, size_t chunk_length, uint32_t queue_depth);
+
+/**
+ * Whether or not a file is being read with io_uring, which depends on both the build and the kernel.
+ *
+ * @param file A file opened with hojson_async_open().
+ * @return Non-zero if reads are made with io_uring or zero if they're made synchronously.
+ */
+HOJSON_DECL uint8_t hojson_async_is_uring(const hojson_async_file_t* file);
+
+/**
+ * Begin or continue parsing a file opened with hojson_async_open(). Chunks are handed to hojson_parse() in order, where
+ * they were read to, and each chunk's buffer is reused for a later chunk once the parser has moved past it.
+ *
+ * @param context An initialized hojson context object.
+ * @param file A file opened with hojson_async_open().
+ * @return The same codes as hojson_parse(). HOJSON_ERROR_UNEXPECTED_EOF means the whole file has been parsed.
+ *         HOJSON_ERROR_IO means a read failed.
+ */
+HOJSON_DECL hojson_code_t hojson_parse_async(hojson_context_t* context, hojson_async_file_t* file);
+
+/**
+ * Close a file opened with hojson_async_open(), once any reads in flight finish, and free it.
+ *
+ * @param file A file opened with hojson_async_open(), or NULL.
+ */
+HOJSON_DECL void hojson_async_close(hojson_async_file_t* file);
+
+/**
+ * A sparse index of a file's elements, each entry a checkpoint from which parsing can resume. All of it is private.
+ */
+typedef struct _hojson_index_t hojson_index_t;
+
+/**
+ * Parse a mapped file once to build an index of its elements, the values beginning at a chosen depth, such as those
+ * of the root array at depth one. Elements are numbered from zero in the order they appear. A checkpoint is taken at
+ * the first element and then at the first element to begin once 'interval' more bytes have been parsed, or at every
+ * element if 'interval' is zero.
+ *
+ * @param index Assigned the index, to be freed with hojson_index_free(), or NULL if building it failed.
+ * @param source A source opened with hojson_mmap_open().
+ * @param depth Depth of the elements to index, as given by the context's 'depth' with their first codes.
+ * @param interval Minimum number of bytes between checkpoints, or zero for a checkpoint at every element.
+ * @return HOJSON_NO_OP, HOJSON_ERROR_INSUFFICIENT_MEMORY if memory couldn't be allocated, HOJSON_ERROR_INVALID_INPUT,
+ *         or the error that ended parsing.
+ */
+HOJSON_DECL hojson_code_t hojson_index_build(hojson_index_t** index, const hojson_mmap_source_t* source,
+    uint32_t depth, size_t interval);
+
+/**
+ * The number of elements found while building an index.
+ *
+ * @param index An index built with hojson_index_build() or loaded with hojson_index_load().
+ * @return The number of elements.
+ */
+HOJSON_DECL size_t hojson_index_element_count(const hojson_index_t* index);
+
+/**
+ * Set up a context at an element of an indexed file. The nearest checkpoint at or before the element is restored and
+ * parsing continues from there, rather than from the beginning of the file, until the element begins. Parsing the
+ * rest of the file continues with hojson_parse(), passing the content from the given offset onwards, each time.
+ *
+ * @param index An index of the file.
+ * @param source The same file, opened with hojson_mmap_open().
+ * @param element Number of the element, counted from zero.
+ * @param context Pointer to an allocated hojson context object. This instance will be modified.
+ * @param buffer A pointer to some contiguous block of memory for hojson to use.
+ * @param buffer_length The length, in bytes, of the buffer.
+ * @param offset Assigned the offset of the content to pass to hojson_parse() from now on.
+ * @return The element's first code, with its name and value in the context, HOJSON_ERROR_INSUFFICIENT_MEMORY if the
+ *         buffer is too short, an error from parsing, or HOJSON_ERROR_INVALID_INPUT if there's no such element or the
+ *         file isn't the one indexed.
+ */
+HOJSON_DECL hojson_code_t hojson_index_seek(const hojson_index_t* index, const hojson_mmap_source_t* source,
+    size_t element, hojson_context_t* context, char* buffer, const size_t buffer_length, size_t* offset);
+
+/**
+ * Write an index to a side file so it needn't be built again. The file is only meaningful to a build of hojson with
+ * the same pointer size and structure layout.
+ *
+ * @param index An index built with hojson_index_build() or loaded with hojson_index_load().
+ * @param path Path to the side file, which is replaced if it exists.
+ * @return HOJSON_NO_OP, HOJSON_ERROR_IO if the file couldn't be written, or HOJSON_ERROR_INVALID_INPUT.
+ */
+HOJSON_DECL hojson_code_t hojson_index_save(const hojson_index_t* index, const char* path);
+
+/**
+ * Read an index from a side file written by hojson_index_save().
+ *
+ * @param index Assigned the index, to be freed with hojson_index_free(), or NULL if loading it failed.
+ * @param path Path to the side file.
+ * @return HOJSON_NO_OP, HOJSON_ERROR_IO if the file couldn't be read, HOJSON_ERROR_INSUFFICIENT_MEMORY if memory
+ *         couldn't be allocated, or HOJSON_ERROR_INVALID_INPUT if the file isn't an index this build can use.
+ */
+HOJSON_DECL hojson_code_t hojson_index_load(hojson_index_t** index, const char* path);
+
+/**
+ * Free an index built with hojson_index_build() or loaded with hojson_index_load().
+ *
+ * @param index The index, or NULL.
+ */
+HOJSON_DECL void hojson_index_free(hojson_index_t* index);
+
+#ifdef __cplusplus
+    }
+#endif /* __cpluspus */
+
+/******************/
+/* Implementation */
+
+#ifdef HOJSON_IO_IMPLEMENTATION
+
+#include <stdio.h> /* fclose(), fopen(), fread(), fwrite() */
+#include <stdlib.h> /* free(), malloc(), realloc() */
+
+#if defined(HOJSON_IO_URING) && !defined(__linux__)
+    #undef HOJSON_IO_URING /* io_uring is particular to Linux */
+#endif
+
+#ifdef _WIN32
+    #include <windows.h> /* CreateFileA(), CreateFileMappingA(), MapViewOfFile(), CreateThread(), CRITICAL_SECTION */
+#else
+    #include <fcntl.h> /* open(), O_RDONLY */
+    #include <pthread.h> /* pthread_create(), pthread_join(), pthread_mutex_t, pthread_cond_t */
+    #include <sys/mman.h> /* mmap(), munmap(), madvise(), posix_madvise() */
+    #include <sys/stat.h> /* fstat(), struct stat */
+    #include <unistd.h> /* close(), pread() */
+#endif /* _WIN32 */
+
+#ifdef HOJSON_IO_URING
+    #include <linux/io_uring.h> /* struct io_uring_params, struct io_uring_sqe, struct io_uring_cqe, IORING_* */
+    #include <sys/syscall.h> /* __NR_io_uring_setup, __NR_io_uring_enter, __NR_io_uring_register */
+    #include <sys/uio.h> /* struct iovec */
+    #include <errno.h> /* EAGAIN, EINTR */
+#endif /* HOJSON_IO_URING */
+
+#ifndef HOJSON_MUTEX_INIT /* Also defined by hojson_parallel.h */
+#ifdef _WIN32
+    typedef HANDLE hojson_thread_t;
+    typedef CRITICAL_SECTION hojson_mutex_t;
+    #define HOJSON_MUTEX_INIT(mutex) InitializeCriticalSection(mutex)
+    #define HOJSON_MUTEX_LOCK(mutex) EnterCriticalSection(mutex)
+    #define HOJSON_MUTEX_UNLOCK(mutex) LeaveCriticalSection(mutex)
+    #define HOJSON_MUTEX_DESTROY(mutex) DeleteCriticalSection(mutex)
+#else
+    typedef pthread_t hojson_thread_t;
+    typedef pthread_mutex_t hojson_mutex_t;
+    #define HOJSON_MUTEX_INIT(mutex) pthread_mutex_init(mutex, NULL)
+    #define HOJSON_MUTEX_LOCK(mutex) pthread_mutex_lock(mutex)
+    #define HOJSON_MUTEX_UNLOCK(mutex) pthread_mutex_unlock(mutex)
+    #define HOJSON_MUTEX_DESTROY(mutex) pthread_mutex_destroy(mutex)
+#endif /* _WIN32 */
+#endif /* HOJSON_MUTEX_INIT */
+
+#ifdef _WIN32
+    typedef CONDITION_VARIABLE hojson_condition_t;
+    #define HOJSON_CONDITION_INIT(condition) InitializeConditionVariable(condition)
+    #define HOJSON_CONDITION_WAIT(condition, mutex) SleepConditionVariableCS(condition, mutex, INFINITE)
+    #define HOJSON_CONDITION_SIGNAL(condition) WakeConditionVariable(condition)
+    #define HOJSON_CONDITION_DESTROY(condition)
+    /* Interlocked functions are full barriers */
+    #define HOJSON_ATOMIC_LOAD(value) InterlockedCompareExchange(value, 0, 0)
+    #define HOJSON_ATOMIC_STORE(value, new_value) InterlockedExchange(value, new_value)
+#else
+    typedef pthread_cond_t hojson_condition_t;
+    #define HOJSON_CONDITION_INIT(condition) pthread_cond_init(condition, NULL)
+    #define HOJSON_CONDITION_WAIT(condition, mutex) pthread_cond_wait(condition, mutex)
+    #define HOJSON_CONDITION_SIGNAL(condition) pthread_cond_signal(condition)
+    #define HOJSON_CONDITION_DESTROY(condition) pthread_cond_destroy(condition)
+    /* Sequentially consistent so a thread about to wait and one about to wake it can't both miss the other */
+    #define HOJSON_ATOMIC_LOAD(value) __atomic_load_n(value, __ATOMIC_SEQ_CST)
+    #define HOJSON_ATOMIC_STORE(value, new_value) __atomic_store_n(value, new_value, __ATOMIC_SEQ_CST)
+#endif /* _WIN32 */
+
+#define HOJSON_PREFETCH_CHUNK_LENGTH 1048576 /* Default length of each chunk */
+#define HOJSON_PREFETCH_CHUNK_COUNT 4 /* Default number of chunks in the ring */
+
+struct _hojson_prefetch_t {
+    hojson_read_t read; /* Callback reading content, on the prefetching thread */
+    void* user_data; /* Passed to the read callback */
+    char* chunks; /* Every chunk, one after another */
+    size_t* chunk_lengths; /* Number of bytes read into each chunk */
+    size_t chunk_length;
+    long chunk_count;
+    /* The ring's two counters count chunks modulo twice the number of chunks so that they're equal when the ring is */
+    /* empty and differ by the number of chunks when it's full. The prefetching thread alone writes 'filled' and the */
+    /* parser alone writes 'released' so neither needs a lock. */
+    volatile long filled; /* Number of chunks read */
+    volatile long released; /* Number of chunks the parser has moved past */
+    volatile long is_ended; /* Set, after the last chunk is filled, once the content has ended or a read failed */
+    volatile long is_failed; /* Set if a read failed */
+    volatile long is_stopping; /* Set by hojson_prefetch_stop() to end the thread early */
+    volatile long is_parser_waiting; /* Set while the parser waits for a chunk to be filled */
+    volatile long is_reader_waiting; /* Set while the prefetching thread waits for a chunk to be released */
+    char* chunk; /* Chunk being parsed or NULL if the next one has yet to be taken */
+    hojson_mutex_t mutex; /* Only taken to wait or to wake the other thread */
+    hojson_condition_t chunk_filled;
+    hojson_condition_t chunk_released;
+    hojson_thread_t thread;
+};
+
+#define HOJSON_ASYNC_CHUNK_LENGTH 1048576 /* Default length of each read */
+#define HOJSON_ASYNC_QUEUE_DEPTH 8 /* Default number of reads in flight */
+
+struct _hojson_async_file_t {
+    size_t file_length;
+    size_t chunk_length;
+    size_t chunk_count; /* Number of chunks in the file, the last of which may be shorter */
+    size_t next_chunk; /* Index of the chunk being parsed, or to be parsed next */
+    uint32_t buffer_count; /* One buffer per read in flight or, reading synchronously, two to alternate between */
+    char* buffers; /* Every buffer, one after another */
+    size_t* buffer_chunks; /* Index of the chunk being read into each buffer */
+    size_t* buffer_lengths; /* Number of bytes read into each buffer so far */
+    uint8_t* is_buffer_ready; /* Set once a buffer's chunk has been read in full */
+    uint8_t is_failed; /* Set if a read failed */
+#ifdef _WIN32
+    HANDLE file;
+#else
+    int descriptor;
+#endif /* _WIN32 */
+#ifdef HOJSON_IO_URING
+    int ring; /* File descriptor of the io_uring instance, or -1 if there is none */
+    uint8_t is_registered; /* Set if the buffers were registered with the ring */
+    uint32_t in_flight; /* Number of reads submitted and not yet completed */
+    struct iovec* iovecs; /* One per buffer, to register them or to read into them */
+    void* submission_ring; /* Mapped rings and submission queue entries */
+    size_t submission_ring_length;
+    void* completion_ring;
+    size_t completion_ring_length;
+    struct io_uring_sqe* entries;
+    size_t entries_length;
+    unsigned* submission_tail; /* Pointers into the mapped submission ring */
+    unsigned* submission_mask;
+    unsigned* submission_array;
+    unsigned* completion_head; /* Pointers into the mapped completion ring */
+    unsigned* completion_tail;
+    unsigned* completion_mask;
+    struct io_uring_cqe* completions;
+#endif /* HOJSON_IO_URING */
+};
+
+#define HOJSON_INDEX_MAGIC (0x494a4f48) /* "HOJI" when stored little-endian */
+#define HOJSON_INDEX_VERSION 2 /* Changed whenever the side file's layout does */
+#define HOJSON_INDEX_BUFFER_LENGTH 4096 /* Initial length of the buffer used to build an index, doubled as needed */
+
+typedef struct {
+    size_t element; /* Number of the element at which the checkpoint was taken */
+    size_t blob_offset; /* Offset of the checkpoint among the index's blobs */
+    size_t blob_length; /* Length of the checkpoint */
+    int32_t code; /* The element's first code, returned by hojson_parse() just before the checkpoint */
+} hojson_index_entry_t;
+
+/* Begins an index's side file and is followed by its entries and then its blobs */
+typedef struct {
+    uint32_t magic; /* HOJSON_INDEX_MAGIC */
+    uint32_t version; /* HOJSON_INDEX_VERSION */
+    uint32_t entry_length; /* Length of an entry, which guards against another structure layout */
+    uint32_t depth; /* Depth of the indexed elements */
+    size_t source_length; /* Length of the indexed file */
+    size_t element_count;
+    size_t entry_count;
+    size_t blobs_length;
+} hojson_index_header_t;
+
+struct _hojson_index_t {
+    size_t source_length; /* Length of the indexed file, checked when seeking */
+    uint32_t depth; /* Depth of the indexed elements */
+    size_t element_count; /* Number of elements found */
+    hojson_index_entry_t* entries; /* One per checkpoint, in order */
+    size_t entry_count;
+    size_t entry_capacity;
+    char* blobs; /* Every checkpoint, one after another */
+    size_t blobs_length;
+    size_t blobs_capacity;
+};
+
+void hojson_prefetch_wake(hojson_prefetch_t* prefetch, volatile long* is_waiting, hojson_condition_t* condition);
+hojson_code_t hojson_async_read(hojson_async_file_t* file, uint32_t buffer);
+hojson_code_t hojson_index_append(hojson_index_t* index, const hojson_context_t* context, hojson_code_t code);
+#ifdef HOJSON_IO_URING
+    uint8_t hojson_uring_setup(hojson_async_file_t* file);
+    void hojson_uring_register(hojson_async_file_t* file);
+    void hojson_uring_teardown(hojson_async_file_t* file);
+    hojson_code_t hojson_uring_submit(hojson_async_file_t* file, uint32_t buffer);
+    hojson_code_t hojson_uring_wait(hojson_async_file_t* file);
+#endif /* HOJSON_IO_URING */
+#ifdef _WIN32
+    DWORD WINAPI hojson_prefetch_thread(LPVOID prefetch);
+#else
+    void* hojson_prefetch_thread(void* prefetch);
+#endif /* _WIN32 */
+
+HOJSON_DECL hojson_code_t hojson_mmap_open(hojson_mmap_source_t* source, const char* path) {
+    if (source == NULL || path == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    source->data = "";
+    source->length = 0;
+    source->is_mapped = 0;
+#ifdef _WIN32
+    {
+        LARGE_INTEGER size;
+        source->mapping = NULL;
+        source->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (source->file == INVALID_HANDLE_VALUE)
+            return HOJSON_ERROR_IO;
+        if (GetFileSizeEx((HANDLE)source->file, &size) == 0 || (ULONGLONG)size.QuadPart > (ULONGLONG)(size_t)-1) {
+            CloseHandle((HANDLE)source->file);
+            source->file = NULL;
+            return HOJSON_ERROR_IO;
+        }
+        if (size.QuadPart == 0) /* Empty files can't be mapped but there's nothing to map anyway */
+            return HOJSON_NO_OP;
+
+        source->mapping = CreateFileMappingA((HANDLE)source->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (source->mapping != NULL)
+            source->data = (const char*)MapViewOfFile((HANDLE)source->mapping, FILE_MAP_READ, 0, 0, 0);
+        if (source->mapping == NULL || source->data == NULL) {
+            if (source->mapping != NULL)
+                CloseHandle((HANDLE)source->mapping);
+            CloseHandle((HANDLE)source->file);
+            source->mapping = NULL;
+            source->file = NULL;
+            source->data = "";
+            return HOJSON_ERROR_IO;
+        }
+        source->length = (size_t)size.QuadPart;
+    }
+#else
+    {
+        struct stat status;
+        void* mapping;
+        int descriptor = open(path, O_RDONLY);
+        if (descriptor < 0)
+            return HOJSON_ERROR_IO;
+        if (fstat(descriptor, &status) != 0 || status.st_size < 0 ||
+                (off_t)(size_t)status.st_size != status.st_size) { /* If it's too large to map */
+            close(descriptor);
+            return HOJSON_ERROR_IO;
+        }
+        if (status.st_size == 0) { /* Empty files can't be mapped but there's nothing to map anyway */
+            close(descriptor);
+            return HOJSON_NO_OP;
+        }
+
+        mapping = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor); /* The mapping holds its own reference to the file */
+        if (mapping == MAP_FAILED)
+            return HOJSON_ERROR_IO;
+
+        /* Advice is only a hint so failures, or a lack of support, are of no consequence */
+    #if defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+        madvise(mapping, (size_t)status.st_size, MADV_SEQUENTIAL);
+        madvise(mapping, (size_t)status.st_size, MADV_WILLNEED);
+    #elif defined(POSIX_MADV_SEQUENTIAL) && defined(POSIX_MADV_WILLNEED)
+        posix_madvise(mapping, (size_t)status.st_size, POSIX_MADV_SEQUENTIAL);
+        posix_madvise(mapping, (size_t)status.st_size, POSIX_MADV_WILLNEED);
+    #endif
+        source->data = (const char*)mapping;
+        source->length = (size_t)status.st_size;
+    }
+#endif /* _WIN32 */
+    source->is_mapped = 1;
+    return HOJSON_NO_OP;
+}
+
+HOJSON_DECL void hojson_mmap_close(hojson_mmap_source_t* source) {
+    if (source == NULL)
+        return;
+
+#ifdef _WIN32
+    if (source->is_mapped)
+        UnmapViewOfFile(source->data);
+    if (source->mapping != NULL)
+        CloseHandle((HANDLE)source->mapping);
+    if (source->file != NULL && source->file != INVALID_HANDLE_VALUE)
+        CloseHandle((HANDLE)source->file);
+    source->mapping = NULL;
+    source->file = NULL;
+#else
+    if (source->is_mapped)
+        munmap((void*)source->data, source->length);
+#endif /* _WIN32 */
+    source->data = "";
+    source->length = 0;
+    source->is_mapped = 0;
+}
+
+HOJSON_DECL hojson_code_t hojson_parse_file(hojson_context_t* context, const hojson_mmap_source_t* source) {
+    if (source == NULL || source->data == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+    else if (source->length == 0) /* An empty file ends before the document begins */
+        return context == NULL || context->is_initialized == 0 ? HOJSON_ERROR_INVALID_INPUT :
+            HOJSON_ERROR_UNEXPECTED_EOF;
+    else if (context != NULL && context->state == HOJSON_STATE_ERROR_UNEXPECTED_EOF && context->json == source->data)
+        return HOJSON_ERROR_UNEXPECTED_EOF; /* Passing the file again would be taken as new content that follows it */
+
+    /* The whole file is one content string so, as long as the same pointer is passed each time, hojson_parse() */
+    /* continues from where it left off */
+    return hojson_parse(context, source->data, source->length);
+}
+
+HOJSON_DECL hojson_prefetch_t* hojson_prefetch_start(hojson_read_t read, void* user_data, size_t chunk_length,
+        uint32_t chunk_count) {
+    if (read == NULL || (chunk_length > 0 && chunk_length < 4) || chunk_count == 1 || chunk_count > 0x3FFFFFFFL)
+        return NULL;
+
+    hojson_prefetch_t* prefetch = (hojson_prefetch_t*)calloc(1, sizeof(hojson_prefetch_t));
+    if (prefetch == NULL)
+        return NULL;
+    prefetch->read = read;
+    prefetch->user_data = user_data;
+    prefetch->chunk_length = chunk_length > 0 ? chunk_length : HOJSON_PREFETCH_CHUNK_LENGTH;
+    prefetch->chunk_count = chunk_count > 0 ? (long)chunk_count : HOJSON_PREFETCH_CHUNK_COUNT;
+    prefetch->chunks = (char*)malloc(prefetch->chunk_length * (size_t)prefetch->chunk_count);
+    prefetch->chunk_lengths = (size_t*)malloc((size_t)prefetch->chunk_count * sizeof(size_t));
+    if (prefetch->chunks == NULL || prefetch->chunk_lengths == NULL) {
+        free(prefetch->chunks);
+        free(prefetch->chunk_lengths);
+        free(prefetch);
+        return NULL;
+    }
+    HOJSON_MUTEX_INIT(&(prefetch->mutex));
+    HOJSON_CONDITION_INIT(&(prefetch->chunk_filled));
+    HOJSON_CONDITION_INIT(&(prefetch->chunk_released));
+
+#ifdef _WIN32
+    prefetch->thread = CreateThread(NULL, 0, hojson_prefetch_thread, prefetch, 0, NULL);
+    if (prefetch->thread == NULL) {
+#else
+    if (pthread_create(&(prefetch->thread), NULL, hojson_prefetch_thread, prefetch) != 0) {
+#endif /* _WIN32 */
+        HOJSON_MUTEX_DESTROY(&(prefetch->mutex));
+        HOJSON_CONDITION_DESTROY(&(prefetch->chunk_filled));
+        HOJSON_CONDITION_DESTROY(&(prefetch->chunk_released));
+        free(prefetch->chunks);
+        free(prefetch->chunk_lengths);
+        free(prefetch);
+        return NULL;
+    }
+    return prefetch;
+}
+
+HOJSON_DECL hojson_code_t hojson_parse_prefetched(hojson_context_t* context, hojson_prefetch_t* prefetch) {
+    if (prefetch == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    while (1) {
+        long released = prefetch->released; /* Only this thread writes it */
+        if (prefetch->chunk == NULL) { /* If the next chunk has yet to be taken */
+            if (HOJSON_ATOMIC_LOAD(&(prefetch->filled)) == released) { /* If it has yet to be filled */
+                HOJSON_MUTEX_LOCK(&(prefetch->mutex));
+                HOJSON_ATOMIC_STORE(&(prefetch->is_parser_waiting), 1);
+                while (HOJSON_ATOMIC_LOAD(&(prefetch->filled)) == released &&
+                        HOJSON_ATOMIC_LOAD(&(prefetch->is_ended)) == 0)
+                    HOJSON_CONDITION_WAIT(&(prefetch->chunk_filled), &(prefetch->mutex));
+                HOJSON_ATOMIC_STORE(&(prefetch->is_parser_waiting), 0);
+                HOJSON_MUTEX_UNLOCK(&(prefetch->mutex));
+                /* The end is only marked after the last chunk is filled so, if none is left, there's no more */
+                if (HOJSON_ATOMIC_LOAD(&(prefetch->filled)) == released)
+                    return HOJSON_ATOMIC_LOAD(&(prefetch->is_failed)) ? HOJSON_ERROR_IO : HOJSON_ERROR_UNEXPECTED_EOF;
+            }
+            prefetch->chunk = prefetch->chunks + (size_t)(released % prefetch->chunk_count) * prefetch->chunk_length;
+        }
+
+        /* Every chunk but the last is full so only the last can end partway through a character and, if it does, */
+        /* the content ends there too. Any other code leaves the chunk in use. */
+        hojson_code_t code = hojson_parse(context, prefetch->chunk,
+            prefetch->chunk_lengths[released % prefetch->chunk_count]);
+        if (code != HOJSON_ERROR_UNEXPECTED_EOF)
+            return code;
+        prefetch->chunk = NULL;
+        HOJSON_ATOMIC_STORE(&(prefetch->released), (released + 1) % (2 * prefetch->chunk_count));
+        hojson_prefetch_wake(prefetch, &(prefetch->is_reader_waiting), &(prefetch->chunk_released));
+    }
+}
+
+HOJSON_DECL void hojson_prefetch_stop(hojson_prefetch_t* prefetch) {
+    if (prefetch == NULL)
+        return;
+
+    HOJSON_ATOMIC_STORE(&(prefetch->is_stopping), 1);
+    hojson_prefetch_wake(prefetch, &(prefetch->is_reader_waiting), &(prefetch->chunk_released));
+#ifdef _WIN32
+    WaitForSingleObject(prefetch->thread, INFINITE);
+    CloseHandle(prefetch->thread);
+#else
+    pthread_join(prefetch->thread, NULL);
+#endif /* _WIN32 */
+    HOJSON_MUTEX_DESTROY(&(prefetch->mutex));
+    HOJSON_CONDITION_DESTROY(&(prefetch->chunk_filled));
+    HOJSON_CONDITION_DESTROY(&(prefetch->chunk_released));
+    free(prefetch->chunks);
+    free(prefetch->chunk_lengths);
+    free(prefetch);
+}
+
+void hojson_prefetch_wake(hojson_prefetch_t* prefetch, volatile long* is_waiting, hojson_condition_t* condition) {
+    /* The other thread sets its flag before checking, once more, for what it's waiting for. Either it sees what */
+    /* changed or the flag is seen here. Taking the mutex ensures it's waiting, not about to, when signaled. */
+    if (HOJSON_ATOMIC_LOAD(is_waiting)) {
+        HOJSON_MUTEX_LOCK(&(prefetch->mutex));
+        HOJSON_CONDITION_SIGNAL(condition);
+        HOJSON_MUTEX_UNLOCK(&(prefetch->mutex));
+    }
+}
+
+#ifdef _WIN32
+DWORD WINAPI hojson_prefetch_thread(LPVOID prefetch_pointer) {
+#else
+void* hojson_prefetch_thread(void* prefetch_pointer) {
+#endif /* _WIN32 */
+    hojson_prefetch_t* prefetch = (hojson_prefetch_t*)prefetch_pointer;
+    uint8_t is_ended = 0;
+    while (is_ended == 0 && HOJSON_ATOMIC_LOAD(&(prefetch->is_stopping)) == 0) {
+        long filled = prefetch->filled; /* Only this thread writes it */
+        long full = (filled + prefetch->chunk_count) % (2 * prefetch->chunk_count); /* 'released' if the ring is full */
+        if (HOJSON_ATOMIC_LOAD(&(prefetch->released)) == full) {
+            HOJSON_MUTEX_LOCK(&(prefetch->mutex));
+            HOJSON_ATOMIC_STORE(&(prefetch->is_reader_waiting), 1);
+            while (HOJSON_ATOMIC_LOAD(&(prefetch->released)) == full &&
+                    HOJSON_ATOMIC_LOAD(&(prefetch->is_stopping)) == 0)
+                HOJSON_CONDITION_WAIT(&(prefetch->chunk_released), &(prefetch->mutex));
+            HOJSON_ATOMIC_STORE(&(prefetch->is_reader_waiting), 0);
+            HOJSON_MUTEX_UNLOCK(&(prefetch->mutex));
+            continue;
+        }
+
+        /* Fill the chunk completely, unless the content ends, so only the last chunk may end mid-character */
+        char* chunk = prefetch->chunks + (size_t)(filled % prefetch->chunk_count) * prefetch->chunk_length;
+        size_t chunk_length = 0;
+        while (chunk_length < prefetch->chunk_length) {
+            size_t bytes_read = 0;
+            if (prefetch->read(prefetch->user_data, chunk + chunk_length, prefetch->chunk_length - chunk_length,
+                    &bytes_read) != 0 || bytes_read > prefetch->chunk_length - chunk_length) {
+                HOJSON_ATOMIC_STORE(&(prefetch->is_failed), 1);
+                is_ended = 1;
+                break;
+            } else if (bytes_read == 0) {
+                is_ended = 1;
+                break;
+            }
+            chunk_length += bytes_read;
+        }
+        if (chunk_length > 0) { /* Publish the chunk */
+            prefetch->chunk_lengths[filled % prefetch->chunk_count] = chunk_length;
+            HOJSON_ATOMIC_STORE(&(prefetch->filled), (filled + 1) % (2 * prefetch->chunk_count));
+            hojson_prefetch_wake(prefetch, &(prefetch->is_parser_waiting), &(prefetch->chunk_filled));
+        }
+    }
+    HOJSON_ATOMIC_STORE(&(prefetch->is_ended), 1);
+    hojson_prefetch_wake(prefetch, &(prefetch->is_parser_waiting), &(prefetch->chunk_filled));
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif /* _WIN32 */
+}
+
+HOJSON_DECL hojson_async_file_t* hojson_async_open(const char* path, size_t chunk_length, uint32_t queue_depth) {
+    if (path == NULL || (chunk_length > 0 && chunk_length < 4) || queue_depth > 0xFFFF)
+        return NULL;
+
+    hojson_async_file_t* file = (hojson_async_file_t*)calloc(1, sizeof(hojson_async_file_t));
+    if (file == NULL)
+        return NULL;
+    file->chunk_length = chunk_length > 0 ? chunk_length : HOJSON_ASYNC_CHUNK_LENGTH;
+    if (queue_depth == 0)
+        queue_depth = HOJSON_ASYNC_QUEUE_DEPTH;
+#ifdef HOJSON_IO_URING
+    file->ring = -1;
+#endif /* HOJSON_IO_URING */
+
+#ifdef _WIN32
+    {
+        LARGE_INTEGER size;
+        file->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+            NULL);
+        if (file->file == INVALID_HANDLE_VALUE) {
+            free(file);
+            return NULL;
+        } else if (GetFileSizeEx(file->file, &size) == 0 || (ULONGLONG)size.QuadPart > (ULONGLONG)(size_t)-1) {
+            CloseHandle(file->file);
+            free(file);
+            return NULL;
+        }
+        file->file_length = (size_t)size.QuadPart;
+    }
+#else
+    {
+        struct stat status;
+        file->descriptor = open(path, O_RDONLY);
+        if (file->descriptor < 0) {
+            free(file);
+            return NULL;
+        } else if (fstat(file->descriptor, &status) != 0 || !S_ISREG(status.st_mode) ||
+                (off_t)(size_t)status.st_size != status.st_size) {
+            close(file->descriptor);
+            free(file);
+            return NULL;
+        }
+        file->file_length = (size_t)status.st_size;
+    }
+#endif /* _WIN32 */
+    file->chunk_count = file->file_length / file->chunk_length + (file->file_length % file->chunk_length != 0);
+
+    /* With io_uring, there's a buffer per read in flight. Reading synchronously, two buffers are enough for */
+    /* hojson_parse() to be handed a new pointer for each chunk so that's all that's allocated if io_uring is */
+    /* unavailable, whatever the queue depth. */
+    uint8_t is_uring = 0;
+#ifdef HOJSON_IO_URING
+    file->buffer_count = queue_depth;
+    is_uring = queue_depth > 1 && hojson_uring_setup(file);
+#endif /* HOJSON_IO_URING */
+    if (!is_uring)
+        file->buffer_count = 2;
+    file->buffers = (char*)malloc(file->chunk_length * file->buffer_count);
+    file->buffer_chunks = (size_t*)malloc(file->buffer_count * sizeof(size_t));
+    file->buffer_lengths = (size_t*)calloc(file->buffer_count, sizeof(size_t));
+    file->is_buffer_ready = (uint8_t*)calloc(file->buffer_count, sizeof(uint8_t));
+    if (file->buffers == NULL || file->buffer_chunks == NULL || file->buffer_lengths == NULL ||
+            file->is_buffer_ready == NULL) {
+        hojson_async_close(file);
+        return NULL;
+    }
+
+#ifdef HOJSON_IO_URING
+    if (is_uring) {
+        /* Put a read of each of the first chunks in flight */
+        uint32_t i;
+        hojson_uring_register(file);
+        for (i = 0; i < file->buffer_count && i < file->chunk_count; i++) {
+            file->buffer_chunks[i] = i;
+            if (hojson_uring_submit(file, i) != HOJSON_NO_OP) {
+                hojson_async_close(file);
+                return NULL;
+            }
+        }
+    }
+#endif /* HOJSON_IO_URING */
+    return file;
+}
+
+HOJSON_DECL uint8_t hojson_async_is_uring(const hojson_async_file_t* file) {
+#ifdef HOJSON_IO_URING
+    return file != NULL && file->ring >= 0;
+#else
+    (void)file;
+    return 0;
+#endif /* HOJSON_IO_URING */
+}
+
+HOJSON_DECL hojson_code_t hojson_parse_async(hojson_context_t* context, hojson_async_file_t* file) {
+    if (file == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    while (file->next_chunk < file->chunk_count) {
+        uint32_t buffer = (uint32_t)(file->next_chunk % file->buffer_count);
+        while (file->is_buffer_ready[buffer] == 0) { /* Wait for the chunk to be read */
+            hojson_code_t code;
+#ifdef HOJSON_IO_URING
+            if (file->ring >= 0)
+                code = file->is_failed ? HOJSON_ERROR_IO : hojson_uring_wait(file);
+            else
+#endif /* HOJSON_IO_URING */
+            {
+                file->buffer_chunks[buffer] = file->next_chunk;
+                code = hojson_async_read(file, buffer);
+            }
+            if (code != HOJSON_NO_OP)
+                return code;
+        }
+
+        /* Every chunk but the last is full so only the last can end partway through a character and, if it does, */
+        /* the file ends there too. Any other code leaves the chunk in use. */
+        hojson_code_t code = hojson_parse(context, file->buffers + buffer * file->chunk_length,
+            file->buffer_lengths[buffer]);
+        if (code != HOJSON_ERROR_UNEXPECTED_EOF)
+            return code;
+
+        /* Reuse the buffer for the first chunk that isn't already in flight */
+        file->is_buffer_ready[buffer] = 0;
+        file->buffer_lengths[buffer] = 0;
+        file->buffer_chunks[buffer] = file->next_chunk + file->buffer_count;
+        file->next_chunk++;
+#ifdef HOJSON_IO_URING
+        if (file->ring >= 0 && file->buffer_chunks[buffer] < file->chunk_count &&
+                hojson_uring_submit(file, buffer) != HOJSON_NO_OP)
+            return HOJSON_ERROR_IO;
+#endif /* HOJSON_IO_URING */
+    }
+    return file->is_failed ? HOJSON_ERROR_IO : HOJSON_ERROR_UNEXPECTED_EOF;
+}
+
+HOJSON_DECL void hojson_async_close(hojson_async_file_t* file) {
+    if (file == NULL)
+        return;
+
+#ifdef HOJSON_IO_URING
+    hojson_uring_teardown(file);
+#endif /* HOJSON_IO_URING */
+#ifdef _WIN32
+    CloseHandle(file->file);
+#else
+    close(file->descriptor);
+#endif /* _WIN32 */
+    free(file->buffers);
+    free(file->buffer_chunks);
+    free(file->buffer_lengths);
+    free(file->is_buffer_ready);
+    free(file);
+}
+
+hojson_code_t hojson_async_read(hojson_async_file_t* file, uint32_t buffer) {
+    size_t offset = file->buffer_chunks[buffer] * file->chunk_length;
+    size_t length = file->file_length - offset < file->chunk_length ? file->file_length - offset : file->chunk_length;
+    char* data = file->buffers + buffer * file->chunk_length;
+    while (file->buffer_lengths[buffer] < length) { /* Reads may come up short */
+        size_t bytes_read;
+#ifdef _WIN32
+        DWORD win_bytes_read = 0;
+        OVERLAPPED overlapped; /* Synchronous but with an offset, like pread() */
+        ULARGE_INTEGER position;
+        position.QuadPart = offset + file->buffer_lengths[buffer];
+        memset(&overlapped, 0, sizeof(OVERLAPPED));
+        overlapped.Offset = position.LowPart;
+        overlapped.OffsetHigh = position.HighPart;
+        if (ReadFile(file->file, data + file->buffer_lengths[buffer], (DWORD)(length - file->buffer_lengths[buffer]),
+                &win_bytes_read, &overlapped) == 0)
+            win_bytes_read = 0;
+        bytes_read = (size_t)win_bytes_read;
+#else
+        ssize_t result = pread(file->descriptor, data + file->buffer_lengths[buffer],
+            length - file->buffer_lengths[buffer], (off_t)(offset + file->buffer_lengths[buffer]));
+        bytes_read = result > 0 ? (size_t)result : 0;
+#endif /* _WIN32 */
+        if (bytes_read == 0) { /* If the read failed or the file has shrunk */
+            file->is_failed = 1;
+            return HOJSON_ERROR_IO;
+        }
+        file->buffer_lengths[buffer] += bytes_read;
+    }
+    file->is_buffer_ready[buffer] = 1;
+    return HOJSON_NO_OP;
+}
+
+#ifdef HOJSON_IO_URING
+uint8_t hojson_uring_setup(hojson_async_file_t* file) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(struct io_uring_params));
+    file->ring = (int)syscall(__NR_io_uring_setup, file->buffer_count, &params);
+    if (file->ring < 0) /* If the kernel is too old, io_uring is disabled, or a sandbox forbids it */
+        return 0;
+
+    /* Map the submission and completion rings, which may share a mapping, and the submission queue entries */
+    file->submission_ring_length = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    file->completion_ring_length = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) && file->completion_ring_length > file->submission_ring_length)
+        file->submission_ring_length = file->completion_ring_length;
+    file->entries_length = params.sq_entries * sizeof(struct io_uring_sqe);
+    file->submission_ring = mmap(NULL, file->submission_ring_length, PROT_READ | PROT_WRITE, MAP_SHARED, file->ring,
+        IORING_OFF_SQ_RING);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        file->completion_ring = file->submission_ring;
+    else
+        file->completion_ring = mmap(NULL, file->completion_ring_length, PROT_READ | PROT_WRITE, MAP_SHARED,
+            file->ring, IORING_OFF_CQ_RING);
+    file->entries = (struct io_uring_sqe*)mmap(NULL, file->entries_length, PROT_READ | PROT_WRITE, MAP_SHARED,
+        file->ring, IORING_OFF_SQES);
+    file->iovecs = (struct iovec*)malloc(file->buffer_count * sizeof(struct iovec));
+    if (file->submission_ring == MAP_FAILED || file->completion_ring == MAP_FAILED ||
+            file->entries == (struct io_uring_sqe*)MAP_FAILED || file->iovecs == NULL) {
+        hojson_uring_teardown(file);
+        return 0;
+    }
+    file->submission_tail = (unsigned*)((char*)file->submission_ring + params.sq_off.tail);
+    file->submission_mask = (unsigned*)((char*)file->submission_ring + params.sq_off.ring_mask);
+    file->submission_array = (unsigned*)((char*)file->submission_ring + params.sq_off.array);
+    file->completion_head = (unsigned*)((char*)file->completion_ring + params.cq_off.head);
+    file->completion_tail = (unsigned*)((char*)file->completion_ring + params.cq_off.tail);
+    file->completion_mask = (unsigned*)((char*)file->completion_ring + params.cq_off.ring_mask);
+    file->completions = (struct io_uring_cqe*)((char*)file->completion_ring + params.cq_off.cqes);
+    return 1;
+}
+
+void hojson_uring_register(hojson_async_file_t* file) {
+    /* Registered buffers stay mapped in the kernel but count against the locked memory limit. Without them, each */
+    /* read is given its own vector. */
+    uint32_t i;
+    for (i = 0; i < file->buffer_count; i++) {
+        file->iovecs[i].iov_base = file->buffers + i * file->chunk_length;
+        file->iovecs[i].iov_len = file->chunk_length;
+    }
+    file->is_registered = syscall(__NR_io_uring_register, file->ring, IORING_REGISTER_BUFFERS, file->iovecs,
+        file->buffer_count) == 0;
+}
+
+void hojson_uring_teardown(hojson_async_file_t* file) {
+    while (file->ring >= 0 && file->in_flight > 0) { /* The kernel may still be writing to the buffers */
+        unsigned head = *(file->completion_head);
+        if (head == __atomic_load_n(file->completion_tail, __ATOMIC_ACQUIRE)) {
+            if (syscall(__NR_io_uring_enter, file->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR)
+                break;
+        } else {
+            __atomic_store_n(file->completion_head, head + 1, __ATOMIC_RELEASE);
+            file->in_flight--;
+        }
+    }
+    if (file->entries != NULL && file->entries != (struct io_uring_sqe*)MAP_FAILED)
+        munmap(file->entries, file->entries_length);
+    if (file->completion_ring != NULL && file->completion_ring != MAP_FAILED &&
+            file->completion_ring != file->submission_ring)
+        munmap(file->completion_ring, file->completion_ring_length);
+    if (file->submission_ring != NULL && file->submission_ring != MAP_FAILED)
+        munmap(file->submission_ring, file->submission_ring_length);
+    if (file->ring >= 0)
+        close(file->ring); /* Also unregisters the buffers */
+    free(file->iovecs);
+    file->entries = NULL;
+    file->completion_ring = file->submission_ring = NULL;
+    file->iovecs = NULL;
+    file->ring = -1;
+}
+
+hojson_code_t hojson_uring_submit(hojson_async_file_t* file, uint32_t buffer) {
+    /* Read whatever remains of the buffer's chunk, which is all of it unless a previous read came up short */
+    size_t offset = file->buffer_chunks[buffer] * file->chunk_length + file->buffer_lengths[buffer];
+    size_t chunk_end = (file->buffer_chunks[buffer] + 1) * file->chunk_length;
+    size_t length = (chunk_end < file->file_length ? chunk_end : file->file_length) - offset;
+    char* data = file->buffers + buffer * file->chunk_length + file->buffer_lengths[buffer];
+
+    /* Only this thread submits so the tail is read plainly but it's written with release semantics so the kernel */
+    /* sees a complete entry */
+    unsigned tail = *(file->submission_tail);
+    unsigned index = tail & *(file->submission_mask);
+    struct io_uring_sqe* entry = &(file->entries[index]);
+    memset(entry, 0, sizeof(struct io_uring_sqe));
+    entry->fd = file->descriptor;
+    entry->off = (__u64)offset;
+    if (file->is_registered) {
+        entry->opcode = IORING_OP_READ_FIXED;
+        entry->addr = (__u64)(size_t)data;
+        entry->len = (unsigned)length;
+        entry->buf_index = (unsigned short)buffer;
+    } else {
+        file->iovecs[buffer].iov_base = data;
+        file->iovecs[buffer].iov_len = length;
+        entry->opcode = IORING_OP_READV;
+        entry->addr = (__u64)(size_t)&(file->iovecs[buffer]);
+        entry->len = 1;
+    }
+    entry->user_data = buffer;
+    file->submission_array[index] = index;
+    __atomic_store_n(file->submission_tail, tail + 1, __ATOMIC_RELEASE);
+
+    while (syscall(__NR_io_uring_enter, file->ring, 1, 0, 0, NULL, 0) < 0) {
+        if (errno != EINTR && errno != EAGAIN) {
+            file->is_failed = 1;
+            return HOJSON_ERROR_IO;
+        }
+    }
+    file->in_flight++;
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_uring_wait(hojson_async_file_t* file) {
+    unsigned head = *(file->completion_head);
+    if (head == __atomic_load_n(file->completion_tail, __ATOMIC_ACQUIRE) &&
+            syscall(__NR_io_uring_enter, file->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0)
+        return errno == EINTR ? HOJSON_NO_OP : HOJSON_ERROR_IO;
+
+    while (head != __atomic_load_n(file->completion_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe* completion = &(file->completions[head & *(file->completion_mask)]);
+        uint32_t buffer = (uint32_t)completion->user_data;
+        int result = completion->res;
+        __atomic_store_n(file->completion_head, ++head, __ATOMIC_RELEASE); /* The entry may be reused now */
+        file->in_flight--;
+
+        size_t chunk_end = (file->buffer_chunks[buffer] + 1) * file->chunk_length;
+        size_t length = (chunk_end < file->file_length ? chunk_end : file->file_length) -
+            file->buffer_chunks[buffer] * file->chunk_length;
+        if (result == -EAGAIN || result == -EINTR)
+            result = 0; /* Try again */
+        else if (result <= 0) { /* If the read failed or the file has shrunk */
+            file->is_failed = 1;
+            continue;
+        }
+        file->buffer_lengths[buffer] += (size_t)result;
+        if (file->buffer_lengths[buffer] >= length)
+            file->is_buffer_ready[buffer] = 1;
+        else if (hojson_uring_submit(file, buffer) != HOJSON_NO_OP) /* If the read came up short, read the rest */
+            return HOJSON_ERROR_IO;
+    }
+    return file->is_failed ? HOJSON_ERROR_IO : HOJSON_NO_OP;
+}
+#endif /* HOJSON_IO_URING */
+
+HOJSON_DECL hojson_code_t hojson_index_build(hojson_index_t** index, const hojson_mmap_source_t* source,
+        uint32_t depth, size_t interval) {
+    if (index == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+    *index = NULL;
+    if (source == NULL || source->data == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_index_t* built = (hojson_index_t*)malloc(sizeof(hojson_index_t));
+    size_t buffer_length = HOJSON_INDEX_BUFFER_LENGTH;
+    char* buffer = (char*)malloc(buffer_length);
+    if (built == NULL || buffer == NULL) {
+        free(built);
+        free(buffer);
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(built, 0, sizeof(hojson_index_t));
+    built->source_length = source->length;
+    built->depth = depth;
+
+    hojson_context_t context;
+    hojson_init(&context, buffer, buffer_length);
+    size_t last_offset = 0;
+    hojson_code_t code;
+    while (1) {
+        code = hojson_parse_file(&context, source);
+        if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) { /* Double the buffer and carry on */
+            char* larger = (char*)malloc(buffer_length * 2);
+            if (larger == NULL)
+                break;
+            hojson_realloc(&context, larger, buffer_length * 2);
+            free(buffer);
+            buffer = larger;
+            buffer_length *= 2;
+            continue;
+        } else if (code < HOJSON_NO_OP || code == HOJSON_END_OF_DOCUMENT)
+            break;
+        else if ((code != HOJSON_VALUE && code != HOJSON_OBJECT_BEGIN && code != HOJSON_ARRAY_BEGIN) ||
+                context.depth != depth)
+            continue; /* Not the beginning of an element */
+
+        /* Take a checkpoint at the first element and, from then on, at the first element past the interval. The */
+        /* offset is where parsing would resume, as the checkpoint would record it, without sizing a checkpoint. */
+        size_t input_offset = context.json_offset + (size_t)(context.iterator - context.json);
+        if (built->entry_count == 0 || input_offset - last_offset >= interval) {
+            if ((code = hojson_index_append(built, &context, code)) != HOJSON_NO_OP)
+                break;
+            last_offset = input_offset;
+        }
+        built->element_count++;
+    }
+    free(buffer);
+
+    if (code != HOJSON_END_OF_DOCUMENT) {
+        hojson_index_free(built);
+        return code;
+    }
+    *index = built;
+    return HOJSON_NO_OP;
+}
+
+HOJSON_DECL size_t hojson_index_element_count(const hojson_index_t* index) {
+    return index == NULL ? 0 : index->element_count;
+}
+
+HOJSON_DECL hojson_code_t hojson_index_seek(const hojson_index_t* index, const hojson_mmap_source_t* source,
+        size_t element, hojson_context_t* context, char* buffer, const size_t buffer_length, size_t* offset) {
+    if (index == NULL || source == NULL || source->data == NULL || context == NULL || offset == NULL ||
+            element >= index->element_count || source->length != index->source_length)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    /* Find the last checkpoint at or before the element. There's always one at the first element. */
+    size_t low = 0, high = index->entry_count;
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (index->entries[middle].element <= element)
+            low = middle;
+        else
+            high = middle;
+    }
+    const hojson_index_entry_t* entry = &(index->entries[low]);
+    hojson_code_t code = hojson_restore(context, buffer, buffer_length, index->blobs + entry->blob_offset,
+        entry->blob_length, offset);
+    if (code != HOJSON_NO_OP)
+        return code;
+
+    /* The checkpoint was taken just after its element's first code so parse on from there to the element wanted */
+    size_t current = entry->element;
+    code = (hojson_code_t)entry->code;
+    while (current < element) {
+        code = hojson_parse(context, source->data + *offset, source->length - *offset);
+        if (code < HOJSON_NO_OP || code == HOJSON_END_OF_DOCUMENT)
+            return code;
+        else if ((code == HOJSON_VALUE || code == HOJSON_OBJECT_BEGIN || code == HOJSON_ARRAY_BEGIN) &&
+                context->depth == index->depth)
+            current++;
+    }
+    return code;
+}
+
+HOJSON_DECL hojson_code_t hojson_index_save(const hojson_index_t* index, const char* path) {
+    if (index == NULL || path == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_index_header_t header;
+    memset(&header, 0, sizeof(hojson_index_header_t));
+    header.magic = HOJSON_INDEX_MAGIC;
+    header.version = HOJSON_INDEX_VERSION;
+    header.entry_length = (uint32_t)sizeof(hojson_index_entry_t);
+    header.depth = index->depth;
+    header.source_length = index->source_length;
+    header.element_count = index->element_count;
+    header.entry_count = index->entry_count;
+    header.blobs_length = index->blobs_length;
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+        return HOJSON_ERROR_IO;
+    uint8_t is_written = fwrite(&header, sizeof(hojson_index_header_t), 1, file) == 1 &&
+        fwrite(index->entries, sizeof(hojson_index_entry_t), index->entry_count, file) == index->entry_count &&
+        fwrite(index->blobs, 1, index->blobs_length, file) == index->blobs_length;
+    if (fclose(file) != 0)
+        is_written = 0;
+    return is_written ? HOJSON_NO_OP : HOJSON_ERROR_IO;
+}
+
+HOJSON_DECL hojson_code_t hojson_index_load(hojson_index_t** index, const char* path) {
+    if (index == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+    *index = NULL;
+    if (path == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return HOJSON_ERROR_IO;
+    hojson_index_header_t header;
+    if (fread(&header, sizeof(hojson_index_header_t), 1, file) != 1) {
+        fclose(file);
+        return HOJSON_ERROR_IO;
+    } else if (header.magic != HOJSON_INDEX_MAGIC || header.version != HOJSON_INDEX_VERSION ||
+            header.entry_length != sizeof(hojson_index_entry_t) || header.entry_count == 0 ||
+            header.entry_count > header.element_count ||
+            header.entry_count > ((size_t)-1) / sizeof(hojson_index_entry_t)) {
+        fclose(file);
+        return HOJSON_ERROR_INVALID_INPUT;
+    }
+
+    hojson_index_t* loaded = (hojson_index_t*)malloc(sizeof(hojson_index_t));
+    if (loaded != NULL) {
+        memset(loaded, 0, sizeof(hojson_index_t));
+        loaded->entries = (hojson_index_entry_t*)malloc(header.entry_count * sizeof(hojson_index_entry_t));
+        loaded->blobs = (char*)malloc(header.blobs_length > 0 ? header.blobs_length : 1);
+    }
+    if (loaded == NULL || loaded->entries == NULL || loaded->blobs == NULL) {
+        fclose(file);
+        hojson_index_free(loaded);
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    }
+    loaded->source_length = header.source_length;
+    loaded->depth = header.depth;
+    loaded->element_count = header.element_count;
+    loaded->entry_count = loaded->entry_capacity = header.entry_count;
+    loaded->blobs_length = loaded->blobs_capacity = header.blobs_length;
+    hojson_code_t code = HOJSON_NO_OP;
+    if (fread(loaded->entries, sizeof(hojson_index_entry_t), header.entry_count, file) != header.entry_count ||
+            fread(loaded->blobs, 1, header.blobs_length, file) != header.blobs_length)
+        code = HOJSON_ERROR_IO;
+    fclose(file);
+
+    /* The first checkpoint must be at the first element, the rest in order, and every checkpoint among the blobs */
+    size_t i;
+    for (i = 0; code == HOJSON_NO_OP && i < loaded->entry_count; i++) {
+        const hojson_index_entry_t* entry = &(loaded->entries[i]);
+        if ((i == 0 && entry->element != 0) || (i > 0 && entry->element <= loaded->entries[i - 1].element) ||
+                entry->element >= loaded->element_count || entry->blob_offset > loaded->blobs_length ||
+                entry->blob_length > loaded->blobs_length - entry->blob_offset)
+            code = HOJSON_ERROR_INVALID_INPUT;
+    }
+    if (code != HOJSON_NO_OP) {
+        hojson_index_free(loaded);
+        return code;
+    }
+    *index = loaded;
+    return HOJSON_NO_OP;
+}
+
+HOJSON_DECL void hojson_index_free(hojson_index_t* index) {
+    if (index == NULL)
+        return;
+
+    free(index->entries);
+    free(index->blobs);
+    free(index);
+}
+
+hojson_code_t hojson_index_append(hojson_index_t* index, const hojson_context_t* context, hojson_code_t code) {
+    size_t checkpoint_length;
+    hojson_checkpoint(context, NULL, 0, &checkpoint_length, NULL);
+
+    /* Grow the entries and the blobs, doubling their capacities, if either is full */
+    if (index->entry_count == index->entry_capacity) {
+        size_t capacity = index->entry_capacity > 0 ? index->entry_capacity * 2 : 16;
+        hojson_index_entry_t* entries = (hojson_index_entry_t*)realloc(index->entries,
+            capacity * sizeof(hojson_index_entry_t));
+        if (entries == NULL)
+            return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        index->entries = entries;
+        index->entry_capacity = capacity;
+    }
+    if (index->blobs_capacity - index->blobs_length < checkpoint_length) {
+        size_t capacity = index->blobs_capacity > 0 ? index->blobs_capacity * 2 : HOJSON_INDEX_BUFFER_LENGTH;
+        while (capacity - index->blobs_length < checkpoint_length)
+            capacity *= 2;
+        char* blobs = (char*)realloc(index->blobs, capacity);
+        if (blobs == NULL)
+            return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        index->blobs = blobs;
+        index->blobs_capacity = capacity;
+    }
+
+    hojson_index_entry_t* entry = &(index->entries[index->entry_count]);
+    hojson_checkpoint(context, index->blobs + index->blobs_length, checkpoint_length, &checkpoint_length, NULL);
+    entry->element = index->element_count;
+    entry->blob_offset = index->blobs_length;
+    entry->blob_length = checkpoint_length;
+    entry->code = (int32_t)code;
+    index->entry_count++;
+    index->blobs_length += checkpoint_length;
+    return HOJSON_NO_OP;
+}
+
+#endif /* HOJSON_IO_IMPLEMENTATION */
+
+#endif /* HOJSON_IO_H */
@@ -0,0 +1,914 @@
+/*
+Copyright (c) 2024 Luke Philipsen
+
+Permission to use, copy, modify, and/or distribute this software for
+any purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Usage
+
+  This is an extension of hojson that parses newline-delimited JSON (JSON Lines) on multiple threads. Do this:
+    #define HOJSON_IMPLEMENTATION
+    #define HOJSON_PARALLEL_IMPLEMENTATION
+  before you include this file in *one* C or C++ file to create the implementation. hojson.h is included by this
+  file and must be in the same directory.
+
+  Unlike hojson.h, this extension allocates memory with malloc() and requires threads: POSIX threads (link with
+  -pthread) or, on Windows, the Win32 API.
+*/
+
+#ifndef HOJSON_PARALLEL_H
+    #define HOJSON_PARALLEL_H
+
+#include "hojson.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif /* __cpluspus */
+
+/***************/
+/* Definitions */
+
+/**
+ * The result of parsing one record (line) of newline-delimited JSON.
+ */
+typedef struct {
+    size_t offset; /**< Offset, in bytes, of the record's first character from the start of the content. */
+    size_t length; /**< Length of the record in bytes, not including whitespace or the line break around it. */
+    hojson_code_t code; /**< HOJSON_END_OF_DOCUMENT if the record was parsed or the error that ended it. */
+    uint32_t worker; /**< Index of the worker thread that parsed the record. */
+} hojson_record_t;
+
+/**
+ * Called on a worker thread for each code returned while parsing a record. Workers run at the same time so anything
+ * shared between them must be synchronized. Anything kept per worker, by index, needs no synchronization.
+ *
+ * @param user_data The 'user_data' pointer from the options.
+ * @param worker Index of the worker thread, from zero to one less than the number of workers.
+ * @param record_offset Offset, in bytes, of the first character of the record being parsed.
+ * @param context The worker's context holding the name, value, depth, and so on.
+ * @param code The code returned by hojson_parse().
+ * @return Zero to continue or non-zero to halt all workers with HOJSON_ERROR_IO.
+ */
+typedef int (*hojson_event_callback_t)(void* user_data, uint32_t worker, size_t record_offset,
+    hojson_context_t* context, hojson_code_t code);
+
+/**
+ * Called once for each record after it has been parsed. If the options ask for records in order, these calls are
+ * made one at a time, in the order the records appear in the content. Otherwise, they're made by the workers as they
+ * finish each record and must be synchronized like events.
+ *
+ * @param user_data The 'user_data' pointer from the options.
+ * @param record The record's position, length, and result.
+ * @return Zero to continue or non-zero to halt all workers with HOJSON_ERROR_IO.
+ */
+typedef int (*hojson_record_callback_t)(void* user_data, const hojson_record_t* record);
+
+/**
+ * Options for hojson_parse_parallel(). Any zeroed value is replaced with its default.
+ */
+typedef struct {
+    uint32_t workers; /**< Number of worker threads. Defaults to the number of online processors. */
+    size_t chunk_length; /**< Bytes of content taken by a worker at a time, extended to a line break. Defaults to
+                              1 MiB. */
+    size_t buffer_length; /**< Initial length of each worker's buffer, which grows as needed. Defaults to 4 KiB. */
+    uint8_t is_ordered; /**< Non-zero to receive records in the order they appear in the content. */
+    hojson_event_callback_t on_event; /**< Optional, called for each code while parsing each record. */
+    hojson_record_callback_t on_record; /**< Optional, called for each record once it's parsed. */
+    void* user_data; /**< Passed to the callbacks. */
+} hojson_parallel_options_t;
+
+/**
+ * Parse newline-delimited JSON on multiple threads. The content is split into chunks at line breaks which workers
+ * take from their own queues, in order, and steal from the ends of other workers' queues once their own are empty.
+ * Each worker parses its chunks with its own context and buffer in multi-document mode. A record that fails to parse
+ * is reported with its error and parsing resumes on the next line. Blank lines are skipped.
+ * Records must be UTF-8 and the content must not contain null characters.
+ *
+ * @param json Newline-delimited JSON content, such as a file read into memory or mapped with mmap().
+ * @param json_length Length of the JSON content in bytes.
+ * @param options Workers, chunk and buffer lengths, ordering, and callbacks. May be null for defaults.
+ * @return HOJSON_END_OF_DOCUMENT once every record is parsed, even if some failed, HOJSON_ERROR_IO if a callback
+ *         halted parsing, HOJSON_ERROR_INSUFFICIENT_MEMORY if memory couldn't be allocated, or
+ *         HOJSON_ERROR_INVALID_INPUT.
+ */
+HOJSON_DECL hojson_code_t hojson_parse_parallel(const char* json, const size_t json_length,
+    const hojson_parallel_options_t* options);
+
+/**
+ * Parse a single document whose root is an array, such as one large array of records, on multiple threads. Each
+ * element of the root array is a record. The document is split into a segment per worker and each segment is
+ * scanned, at once, for the commas and brackets that separate the elements. Whether a segment begins in a string is
+ * guessed and, once the number of quotes in every segment is known, checked. A segment that was guessed wrong is
+ * scanned again. Groups of elements are then parsed by the workers the same way lines are by hojson_parse_parallel().
+ * Events have the depths they'd have if the document were parsed in one piece, less the root array's beginning and
+ * ending, and each element ends with HOJSON_END_OF_DOCUMENT.
+ * If the root isn't an array or the document is malformed outside of its elements, it's parsed in one piece on the
+ * calling thread and reported as a single record.
+ *
+ * @param json JSON content as a string, UTF-8 without null characters.
+ * @param json_length Length of the JSON content in bytes.
+ * @param options Workers, chunk and buffer lengths, ordering, and callbacks. May be null for defaults. Elements are
+ *                grouped such that each group is about 'chunk_length' bytes long.
+ * @return The same codes as hojson_parse_parallel().
+ */
+HOJSON_DECL hojson_code_t hojson_parse_parallel_array(const char* json, const size_t json_length,
+    const hojson_parallel_options_t* options);
+
+#ifdef __cplusplus
+    }
+#endif /* __cpluspus */
+
+/******************/
+/* Implementation */
+
+#ifdef HOJSON_PARALLEL_IMPLEMENTATION
+
+#ifdef _WIN32
+    #include <windows.h> /* CreateThread(), CRITICAL_SECTION, GetSystemInfo() */
+#else
+    #include <pthread.h> /* pthread_create(), pthread_join(), pthread_mutex_t */
+    #include <unistd.h> /* sysconf() */
+#endif /* _WIN32 */
+
+#ifndef HOJSON_MUTEX_INIT /* Also defined by hojson_io.h */
+#ifdef _WIN32
+    typedef HANDLE hojson_thread_t;
+    typedef CRITICAL_SECTION hojson_mutex_t;
+    #define HOJSON_MUTEX_INIT(mutex) InitializeCriticalSection(mutex)
+    #define HOJSON_MUTEX_LOCK(mutex) EnterCriticalSection(mutex)
+    #define HOJSON_MUTEX_UNLOCK(mutex) LeaveCriticalSection(mutex)
+    #define HOJSON_MUTEX_DESTROY(mutex) DeleteCriticalSection(mutex)
+#else
+    typedef pthread_t hojson_thread_t;
+    typedef pthread_mutex_t hojson_mutex_t;
+    #define HOJSON_MUTEX_INIT(mutex) pthread_mutex_init(mutex, NULL)
+    #define HOJSON_MUTEX_LOCK(mutex) pthread_mutex_lock(mutex)
+    #define HOJSON_MUTEX_UNLOCK(mutex) pthread_mutex_unlock(mutex)
+    #define HOJSON_MUTEX_DESTROY(mutex) pthread_mutex_destroy(mutex)
+#endif /* _WIN32 */
+#endif /* HOJSON_MUTEX_INIT */
+
+#define HOJSON_PARALLEL_CHUNK_LENGTH 1048576 /* Default number of bytes taken by a worker at a time */
+#define HOJSON_PARALLEL_BUFFER_LENGTH 4096 /* Default initial length of a worker's buffer */
+#define HOJSON_PARALLEL_GUESS_LENGTH 4096 /* Bytes examined for a quote when guessing if a segment begins in a string */
+#define HOJSON_PARALLEL_NO_DEPTH 0x7FFFFFFFL /* Depth of a segment's commas or closings when it has none */
+
+typedef struct {
+    size_t next; /* Index of the next chunk the owner will take */
+    size_t end; /* Chunks from 'next' up to, but not including, this index remain */
+    size_t stride; /* Distance between the indices of queued chunks */
+    hojson_mutex_t mutex;
+} hojson_queue_t;
+
+typedef struct {
+    hojson_record_t* records; /* Records parsed from the chunk, held until earlier chunks are delivered */
+    size_t record_count;
+    size_t record_capacity;
+    uint8_t is_done; /* Set once the chunk has been parsed and its records may be delivered */
+} hojson_chunk_t;
+
+/* What a scan of one segment of a single, large document found. Depths are relative to the segment's beginning. */
+typedef struct {
+    uint8_t is_in_string; /* Whether the segment begins in a string, guessed at first and corrected if wrong */
+    uint8_t must_scan; /* Set if the segment must be scanned (again) */
+    uint8_t quote_parity; /* One if the segment has an odd number of unescaped quotes, which holds either way */
+    long depth_change; /* Depth at the end of the segment */
+    long close_depth; /* Lowest depth following a '}' or ']' */
+    size_t close_offset; /* Offset of the first '}' or ']' to reach the lowest depth */
+    long comma_depth; /* Lowest depth of a comma */
+    size_t* commas; /* Offsets of every comma at the lowest depth */
+    size_t comma_count;
+    size_t comma_capacity;
+} hojson_segment_t;
+
+typedef struct _hojson_worker_t hojson_worker_t;
+
+typedef struct {
+    const char* json; /* Entirety of the content */
+    size_t json_length;
+    hojson_parallel_options_t options; /* Options with defaults applied */
+    hojson_code_t (*parse_chunk)(hojson_worker_t* worker, size_t chunk); /* What workers do with each chunk */
+    size_t* chunk_offsets; /* Beginning of each chunk, plus the end of the last, as byte offsets or element indices */
+    size_t chunk_count;
+    uint32_t worker_count;
+    hojson_queue_t* queues; /* One queue of chunks per worker */
+    hojson_chunk_t* chunks; /* If records are ordered, the records of each chunk */
+    size_t next_delivery; /* If records are ordered, index of the next chunk whose records are to be delivered */
+    hojson_mutex_t delivery_mutex;
+    hojson_code_t status; /* HOJSON_NO_OP until a worker fails and all workers must stop */
+    hojson_mutex_t status_mutex;
+    hojson_segment_t* segments; /* When splitting a single document, what was found in each segment */
+    size_t* elements; /* When splitting a single document, the beginning and end offsets of each array element */
+    size_t element_count;
+} hojson_parallel_t;
+
+typedef struct _hojson_worker_t {
+    hojson_parallel_t* parallel;
+    uint32_t index;
+    hojson_context_t context;
+    char* buffer;
+    size_t buffer_length;
+} hojson_worker_t;
+
+uint32_t hojson_processor_count(void);
+void hojson_parallel_setup(hojson_parallel_t* parallel, const char* json, const size_t json_length,
+    const hojson_parallel_options_t* options);
+hojson_code_t hojson_split_lines(hojson_parallel_t* parallel, size_t chunk_length);
+hojson_code_t hojson_run_workers(hojson_parallel_t* parallel, uint8_t is_ordered);
+hojson_code_t hojson_run_worker(hojson_worker_t* worker);
+uint8_t hojson_take_chunk(hojson_worker_t* worker, size_t* chunk);
+hojson_code_t hojson_parse_lines(hojson_worker_t* worker, size_t chunk);
+hojson_code_t hojson_scan_segment(hojson_worker_t* worker, size_t chunk);
+hojson_code_t hojson_split_elements(hojson_parallel_t* parallel);
+hojson_code_t hojson_add_element(hojson_parallel_t* parallel, size_t* element_capacity, size_t begin, size_t end);
+hojson_code_t hojson_parse_elements(hojson_worker_t* worker, size_t chunk);
+hojson_code_t hojson_parse_part(hojson_worker_t* worker, const char* json, size_t json_length, size_t record_offset,
+    uint8_t is_element);
+hojson_code_t hojson_parse_sequential(hojson_parallel_t* parallel);
+uint8_t hojson_guess_string_state(const char* json, size_t offset, size_t json_length);
+hojson_code_t hojson_add_record(hojson_worker_t* worker, size_t chunk, size_t offset, size_t length,
+    hojson_code_t code);
+hojson_code_t hojson_finish_chunk(hojson_parallel_t* parallel, size_t chunk);
+void hojson_parallel_fail(hojson_parallel_t* parallel, hojson_code_t code);
+#ifdef _WIN32
+    DWORD WINAPI hojson_worker_thread(LPVOID worker);
+#else
+    void* hojson_worker_thread(void* worker);
+#endif /* _WIN32 */
+
+HOJSON_DECL hojson_code_t hojson_parse_parallel(const char* json, const size_t json_length,
+        const hojson_parallel_options_t* options) {
+    if (json == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_parallel_t parallel;
+    hojson_parallel_setup(&parallel, json, json_length, options);
+    hojson_code_t code = hojson_split_lines(&parallel, parallel.options.chunk_length);
+    if (code == HOJSON_NO_OP) {
+        parallel.parse_chunk = hojson_parse_lines;
+        code = hojson_run_workers(&parallel, parallel.options.is_ordered);
+    }
+    free(parallel.chunk_offsets);
+    return code == HOJSON_NO_OP ? HOJSON_END_OF_DOCUMENT : code;
+}
+
+HOJSON_DECL hojson_code_t hojson_parse_parallel_array(const char* json, const size_t json_length,
+        const hojson_parallel_options_t* options) {
+    if (json == NULL)
+        return HOJSON_ERROR_INVALID_INPUT;
+
+    hojson_parallel_t parallel;
+    hojson_parallel_setup(&parallel, json, json_length, options);
+
+    /* Split the document into as many segments as there are workers, or fewer if they'd be shorter than a chunk */
+    size_t segment_length = json_length / parallel.options.workers + 1;
+    if (segment_length < parallel.options.chunk_length)
+        segment_length = parallel.options.chunk_length;
+    parallel.chunk_offsets = (size_t*)malloc((json_length / segment_length + 2) * sizeof(size_t));
+    if (parallel.chunk_offsets == NULL)
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    parallel.chunk_offsets[0] = 0;
+    while (parallel.chunk_offsets[parallel.chunk_count] < json_length) {
+        size_t offset = parallel.chunk_offsets[parallel.chunk_count] + segment_length;
+        parallel.chunk_offsets[++parallel.chunk_count] = offset < json_length ? offset : json_length;
+    }
+    parallel.segments = (hojson_segment_t*)calloc(parallel.chunk_count + 1, sizeof(hojson_segment_t));
+    if (parallel.segments == NULL) {
+        free(parallel.chunk_offsets);
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    }
+    size_t segment_count = parallel.chunk_count;
+
+    /* Scan every segment at once, each from a guess of whether it begins in a string. The number of unescaped */
+    /* quotes in each segment is the same either way so, with them, the guesses can be checked in order and any */
+    /* segment guessed wrong is scanned again. */
+    size_t i;
+    for (i = 0; i < parallel.chunk_count; i++) {
+        parallel.segments[i].must_scan = 1;
+        parallel.segments[i].is_in_string = i == 0 ? 0 : hojson_guess_string_state(json,
+            parallel.chunk_offsets[i], json_length);
+    }
+    parallel.parse_chunk = hojson_scan_segment;
+    hojson_code_t code = hojson_run_workers(&parallel, 0);
+    if (code == HOJSON_NO_OP) {
+        uint8_t is_in_string = 0, is_guess_wrong = 0;
+        for (i = 0; i < parallel.chunk_count; i++) {
+            parallel.segments[i].must_scan = parallel.segments[i].is_in_string != is_in_string;
+            parallel.segments[i].is_in_string = is_in_string;
+            is_guess_wrong |= parallel.segments[i].must_scan;
+            is_in_string ^= parallel.segments[i].quote_parity;
+        }
+        if (is_guess_wrong)
+            code = hojson_run_workers(&parallel, 0);
+    }
+
+    /* Find the elements from the commas and closings at the depth of the root array then parse groups of them at */
+    /* once. If the document doesn't fit that shape, it's parsed in one piece. */
+    if (code == HOJSON_NO_OP)
+        code = hojson_split_elements(&parallel);
+    free(parallel.chunk_offsets);
+    parallel.chunk_offsets = NULL;
+    parallel.chunk_count = 0;
+    if (code == HOJSON_NO_OP) {
+        /* Group elements such that each group is about as long as a chunk */
+        parallel.chunk_offsets = (size_t*)malloc((parallel.element_count + 1) * sizeof(size_t));
+        if (parallel.chunk_offsets == NULL)
+            code = HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        else {
+            size_t group_begin = 0;
+            parallel.chunk_offsets[0] = 0;
+            for (i = 0; i < parallel.element_count; i++) {
+                if (i + 1 == parallel.element_count || parallel.elements[(i + 1) * 2] -
+                        parallel.elements[group_begin * 2] >= parallel.options.chunk_length) {
+                    parallel.chunk_offsets[++parallel.chunk_count] = i + 1;
+                    group_begin = i + 1;
+                }
+            }
+            parallel.parse_chunk = hojson_parse_elements;
+            code = hojson_run_workers(&parallel, parallel.options.is_ordered);
+        }
+    } else if (code == HOJSON_ERROR_SYNTAX) /* If the document can't be split */
+        code = hojson_parse_sequential(&parallel);
+
+    for (i = 0; i < segment_count; i++)
+        free(parallel.segments[i].commas);
+    free(parallel.segments);
+    free(parallel.elements);
+    free(parallel.chunk_offsets);
+    return code == HOJSON_NO_OP ? HOJSON_END_OF_DOCUMENT : code;
+}
+
+uint32_t hojson_processor_count(void) {
+    #ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors : 1;
+    #else
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+        return count > 0 ? (uint32_t)count : 1;
+    #endif /* _WIN32 */
+}
+
+void hojson_parallel_setup(hojson_parallel_t* parallel, const char* json, const size_t json_length,
+        const hojson_parallel_options_t* options) {
+    memset(parallel, 0, sizeof(hojson_parallel_t));
+    parallel->json = json;
+    parallel->json_length = json_length;
+    if (options != NULL)
+        parallel->options = *options;
+    if (parallel->options.workers == 0)
+        parallel->options.workers = hojson_processor_count();
+    if (parallel->options.chunk_length == 0)
+        parallel->options.chunk_length = HOJSON_PARALLEL_CHUNK_LENGTH;
+    if (parallel->options.buffer_length == 0)
+        parallel->options.buffer_length = HOJSON_PARALLEL_BUFFER_LENGTH;
+}
+
+hojson_code_t hojson_split_lines(hojson_parallel_t* parallel, size_t chunk_length) {
+    /* Split the content into chunks of roughly the requested length, each extended to the next line break */
+    const char* json = parallel->json;
+    size_t json_length = parallel->json_length;
+    parallel->chunk_offsets = (size_t*)malloc((json_length / chunk_length + 2) * sizeof(size_t));
+    if (parallel->chunk_offsets == NULL)
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    parallel->chunk_offsets[0] = 0;
+    while (parallel->chunk_offsets[parallel->chunk_count] < json_length) {
+        size_t offset = parallel->chunk_offsets[parallel->chunk_count] + chunk_length;
+        if (offset < json_length) {
+            const char* line_break = (const char*)memchr(json + offset, '\n', json_length - offset);
+            offset = line_break != NULL ? (size_t)(line_break - json) + 1 : json_length;
+        } else
+            offset = json_length;
+        parallel->chunk_offsets[++parallel->chunk_count] = offset;
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_run_workers(hojson_parallel_t* parallel, uint8_t is_ordered) {
+    /* There's no use for more workers than chunks */
+    uint32_t worker_count = parallel->options.workers;
+    if (worker_count > parallel->chunk_count)
+        worker_count = parallel->chunk_count > 0 ? (uint32_t)parallel->chunk_count : 1;
+    parallel->worker_count = worker_count;
+    parallel->next_delivery = 0;
+
+    hojson_worker_t* workers = (hojson_worker_t*)calloc(worker_count, sizeof(hojson_worker_t));
+    hojson_thread_t* threads = (hojson_thread_t*)calloc(worker_count, sizeof(hojson_thread_t));
+    uint8_t* is_running = (uint8_t*)calloc(worker_count, sizeof(uint8_t));
+    parallel->queues = (hojson_queue_t*)calloc(worker_count, sizeof(hojson_queue_t));
+    parallel->chunks = is_ordered ? (hojson_chunk_t*)calloc(parallel->chunk_count + 1, sizeof(hojson_chunk_t)) :
+        NULL;
+    if (workers == NULL || threads == NULL || is_running == NULL || parallel->queues == NULL ||
+            (is_ordered && parallel->chunks == NULL)) {
+        free(workers);
+        free(threads);
+        free(is_running);
+        free(parallel->queues);
+        free(parallel->chunks);
+        parallel->queues = NULL;
+        parallel->chunks = NULL;
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    /* When records are ordered, chunks are dealt out in turn so that they finish in roughly the same order they */
+    /* began and few are held waiting for an earlier one. Otherwise, each worker gets a contiguous run of chunks. */
+    uint32_t i;
+    for (i = 0; i < worker_count; i++) {
+        if (is_ordered) {
+            parallel->queues[i].next = i;
+            parallel->queues[i].end = parallel->chunk_count;
+            parallel->queues[i].stride = worker_count;
+        } else {
+            parallel->queues[i].next = parallel->chunk_count * i / worker_count;
+            parallel->queues[i].end = parallel->chunk_count * (i + 1) / worker_count;
+            parallel->queues[i].stride = 1;
+        }
+        HOJSON_MUTEX_INIT(&(parallel->queues[i].mutex));
+        workers[i].parallel = parallel;
+        workers[i].index = i;
+        workers[i].buffer_length = parallel->options.buffer_length;
+    }
+    HOJSON_MUTEX_INIT(&(parallel->delivery_mutex));
+    HOJSON_MUTEX_INIT(&(parallel->status_mutex));
+
+    /* The calling thread is the first worker. If a thread can't be created, its chunks will be stolen by others. */
+    for (i = 1; i < worker_count; i++) {
+        #ifdef _WIN32
+            threads[i] = CreateThread(NULL, 0, hojson_worker_thread, &(workers[i]), 0, NULL);
+            is_running[i] = threads[i] != NULL;
+        #else
+            is_running[i] = pthread_create(&(threads[i]), NULL, hojson_worker_thread, &(workers[i])) == 0;
+        #endif /* _WIN32 */
+    }
+    hojson_worker_thread(&(workers[0]));
+    for (i = 1; i < worker_count; i++) {
+        if (is_running[i] == 0)
+            continue;
+        #ifdef _WIN32
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+        #else
+            pthread_join(threads[i], NULL);
+        #endif /* _WIN32 */
+    }
+
+    for (i = 0; i < worker_count; i++) {
+        free(workers[i].buffer);
+        HOJSON_MUTEX_DESTROY(&(parallel->queues[i].mutex));
+    }
+    if (parallel->chunks != NULL) {
+        size_t chunk;
+        for (chunk = 0; chunk < parallel->chunk_count; chunk++)
+            free(parallel->chunks[chunk].records);
+    }
+    HOJSON_MUTEX_DESTROY(&(parallel->delivery_mutex));
+    HOJSON_MUTEX_DESTROY(&(parallel->status_mutex));
+    free(workers);
+    free(threads);
+    free(is_running);
+    free(parallel->queues);
+    free(parallel->chunks);
+    parallel->queues = NULL;
+    parallel->chunks = NULL;
+    return parallel->status;
+}
+
+#ifdef _WIN32
+DWORD WINAPI hojson_worker_thread(LPVOID worker) {
+    hojson_run_worker((hojson_worker_t*)worker);
+    return 0;
+}
+#else
+void* hojson_worker_thread(void* worker) {
+    hojson_run_worker((hojson_worker_t*)worker);
+    return NULL;
+}
+#endif /* _WIN32 */
+
+hojson_code_t hojson_run_worker(hojson_worker_t* worker) {
+    hojson_code_t code = HOJSON_NO_OP;
+    worker->buffer = (char*)malloc(worker->buffer_length);
+    if (worker->buffer == NULL)
+        code = HOJSON_ERROR_INSUFFICIENT_MEMORY;
+
+    size_t chunk;
+    while (code == HOJSON_NO_OP && hojson_take_chunk(worker, &chunk)) {
+        code = worker->parallel->parse_chunk(worker, chunk);
+        if (code == HOJSON_NO_OP && worker->parallel->chunks != NULL)
+            code = hojson_finish_chunk(worker->parallel, chunk);
+    }
+
+    if (code != HOJSON_NO_OP) /* If this worker failed, all must stop */
+        hojson_parallel_fail(worker->parallel, code);
+    return code;
+}
+
+uint8_t hojson_take_chunk(hojson_worker_t* worker, size_t* chunk) {
+    hojson_parallel_t* parallel = worker->parallel;
+    HOJSON_MUTEX_LOCK(&(parallel->status_mutex));
+    hojson_code_t status = parallel->status;
+    HOJSON_MUTEX_UNLOCK(&(parallel->status_mutex));
+    if (status != HOJSON_NO_OP) /* If another worker failed */
+        return 0;
+
+    /* Take the next chunk from the front of this worker's own queue */
+    hojson_queue_t* queue = &(parallel->queues[worker->index]);
+    uint8_t is_taken = 0;
+    HOJSON_MUTEX_LOCK(&(queue->mutex));
+    if (queue->next < queue->end) {
+        *chunk = queue->next;
+        queue->next += queue->stride;
+        is_taken = 1;
+    }
+    HOJSON_MUTEX_UNLOCK(&(queue->mutex));
+
+    /* If its queue is empty, steal the last chunk from another worker's queue, starting with the worker after it */
+    uint32_t i;
+    for (i = 1; is_taken == 0 && i < parallel->worker_count; i++) {
+        queue = &(parallel->queues[(worker->index + i) % parallel->worker_count]);
+        HOJSON_MUTEX_LOCK(&(queue->mutex));
+        if (queue->next < queue->end) {
+            *chunk = queue->next + (queue->end - 1 - queue->next) / queue->stride * queue->stride;
+            queue->end = *chunk;
+            is_taken = 1;
+        }
+        HOJSON_MUTEX_UNLOCK(&(queue->mutex));
+    }
+    return is_taken;
+}
+
+hojson_code_t hojson_parse_lines(hojson_worker_t* worker, size_t chunk) {
+    hojson_parallel_t* parallel = worker->parallel;
+    const char* json = parallel->json + parallel->chunk_offsets[chunk];
+    const char* end = parallel->json + parallel->chunk_offsets[chunk + 1];
+    const char* record = json; /* Where the current record begins, or whitespace before it */
+    uint8_t is_record_found = 0; /* Whether or not 'record' has been moved past any whitespace */
+
+    hojson_init(&(worker->context), worker->buffer, worker->buffer_length);
+    hojson_set_multi_document(&(worker->context), 1);
+    while (json < end) {
+        hojson_code_t code = hojson_parse(&(worker->context), json, (size_t)(end - json));
+        if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) { /* Recover by doubling the buffer */
+            char* buffer = (char*)malloc(worker->buffer_length * 2);
+            if (buffer == NULL)
+                return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+            hojson_realloc(&(worker->context), buffer, worker->buffer_length * 2);
+            free(worker->buffer);
+            worker->buffer = buffer;
+            worker->buffer_length *= 2;
+            continue;
+        }
+
+        if (is_record_found == 0) {
+            while (record < end && HOJSON_IS_WHITESPACE(*record))
+                record++;
+            is_record_found = 1;
+        }
+        size_t record_offset = (size_t)(record - parallel->json);
+        if (code > HOJSON_NO_OP) {
+            if (parallel->options.on_event != NULL && parallel->options.on_event(parallel->options.user_data,
+                    worker->index, record_offset, &(worker->context), code) != 0)
+                return HOJSON_ERROR_IO;
+            if (code == HOJSON_END_OF_DOCUMENT) { /* The record ended and another may follow */
+                const char* record_end = json + worker->context.document_offset;
+                if ((code = hojson_add_record(worker, chunk, record_offset, (size_t)(record_end - record), code)) !=
+                        HOJSON_NO_OP)
+                    return code;
+                record = record_end;
+                is_record_found = 0;
+            }
+        } else if (code == HOJSON_ERROR_UNEXPECTED_EOF) { /* The end of the chunk */
+            const char* record_end = end;
+            while (record_end > record && HOJSON_IS_WHITESPACE(*(record_end - 1)))
+                record_end--;
+            if (record_end > record)
+                return hojson_add_record(worker, chunk, record_offset, (size_t)(record_end - record), code);
+            break;
+        } else { /* The record is invalid, skip the rest of its line and begin again with the next */
+            const char* line_end = (const char*)memchr(record, '\n', (size_t)(end - record));
+            const char* record_end = line_end != NULL ? line_end : end;
+            while (record_end > record && HOJSON_IS_WHITESPACE(*(record_end - 1)))
+                record_end--;
+            if ((code = hojson_add_record(worker, chunk, record_offset, (size_t)(record_end - record), code)) !=
+                    HOJSON_NO_OP)
+                return code;
+            json = record = line_end != NULL ? line_end + 1 : end;
+            is_record_found = 0;
+            hojson_init(&(worker->context), worker->buffer, worker->buffer_length);
+            hojson_set_multi_document(&(worker->context), 1);
+        }
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_scan_segment(hojson_worker_t* worker, size_t chunk) {
+    hojson_parallel_t* parallel = worker->parallel;
+    hojson_segment_t* segment = &(parallel->segments[chunk]);
+    if (segment->must_scan == 0)
+        return HOJSON_NO_OP;
+
+    /* An odd number of backslashes before the segment means its first character is escaped. Escapes are followed */
+    /* in and out of strings so that the number of unescaped quotes is the same no matter where the segment began. */
+    const char* begin = parallel->json + parallel->chunk_offsets[chunk];
+    const char* iterator = begin, *end = parallel->json + parallel->chunk_offsets[chunk + 1];
+    uint8_t is_escaped = 0, is_in_string = segment->is_in_string, quote_parity = 0;
+    while (iterator > parallel->json && *(iterator - 1) == '\\') {
+        iterator--;
+        is_escaped = !is_escaped;
+    }
+    iterator = begin;
+
+    long depth = 0, close_depth = HOJSON_PARALLEL_NO_DEPTH, comma_depth = HOJSON_PARALLEL_NO_DEPTH;
+    size_t close_offset = 0;
+    segment->comma_count = 0;
+    for (; iterator < end; iterator++) {
+        char c = *iterator;
+        if (is_escaped)
+            is_escaped = 0;
+        else if (c == '\\')
+            is_escaped = 1;
+        else if (c == '"') {
+            is_in_string = !is_in_string;
+            quote_parity ^= 1;
+        } else if (is_in_string == 0) {
+            if (c == '{' || c == '[')
+                depth++;
+            else if (c == '}' || c == ']') {
+                depth--;
+                if (depth < close_depth) {
+                    close_depth = depth;
+                    close_offset = (size_t)(iterator - parallel->json);
+                }
+            } else if (c == ',' && depth <= comma_depth) {
+                if (depth < comma_depth) { /* Commas at any greater depth belonged to nested objects or arrays */
+                    comma_depth = depth;
+                    segment->comma_count = 0;
+                }
+                if (segment->comma_count == segment->comma_capacity) {
+                    size_t capacity = segment->comma_capacity > 0 ? segment->comma_capacity * 2 : 256;
+                    size_t* commas = (size_t*)realloc(segment->commas, capacity * sizeof(size_t));
+                    if (commas == NULL)
+                        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+                    segment->commas = commas;
+                    segment->comma_capacity = capacity;
+                }
+                segment->commas[segment->comma_count++] = (size_t)(iterator - parallel->json);
+            }
+        }
+    }
+
+    segment->quote_parity = quote_parity;
+    segment->depth_change = depth;
+    segment->close_depth = close_depth;
+    segment->close_offset = close_offset;
+    segment->comma_depth = comma_depth;
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_split_elements(hojson_parallel_t* parallel) {
+    /* The document must be an array with nothing but whitespace before or after it */
+    const char* json = parallel->json;
+    size_t json_length = parallel->json_length, offset = 0, i;
+    if (json_length >= 3 && (uint8_t)json[0] == 0xEF && (uint8_t)json[1] == 0xBB && (uint8_t)json[2] == 0xBF)
+        offset = 3; /* The UTF-8 byte order marker */
+    while (offset < json_length && HOJSON_IS_WHITESPACE(json[offset]))
+        offset++;
+    if (offset >= json_length || json[offset] != '[')
+        return HOJSON_ERROR_SYNTAX;
+
+    /* Walk the segments with the depth at which each began. Commas in the root array are at depth one and it */
+    /* closes at depth zero. Anything shallower means the document isn't what it seems. */
+    size_t element_capacity = 0, element_begin = offset + 1, root_end = json_length;
+    long depth = 0;
+    for (i = 0; i < parallel->chunk_count && root_end == json_length; i++) {
+        hojson_segment_t* segment = &(parallel->segments[i]);
+        uint8_t is_root_closed = depth + segment->close_depth == 0; /* If the root array closes in this segment */
+        if (depth + segment->close_depth < 0 || depth + segment->comma_depth < 1)
+            return HOJSON_ERROR_SYNTAX;
+        size_t comma;
+        for (comma = 0; depth + segment->comma_depth == 1 && comma < segment->comma_count; comma++) {
+            if (is_root_closed && segment->commas[comma] > segment->close_offset)
+                return HOJSON_ERROR_SYNTAX;
+            if (hojson_add_element(parallel, &element_capacity, element_begin, segment->commas[comma]) !=
+                    HOJSON_NO_OP)
+                return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+            element_begin = segment->commas[comma] + 1;
+        }
+        if (is_root_closed) {
+            root_end = segment->close_offset;
+            if (hojson_add_element(parallel, &element_capacity, element_begin, root_end) != HOJSON_NO_OP)
+                return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        }
+        depth += segment->depth_change;
+    }
+    if (root_end == json_length)
+        return HOJSON_ERROR_SYNTAX;
+    for (offset = root_end + 1; offset < json_length; offset++) {
+        if (!HOJSON_IS_WHITESPACE(json[offset]))
+            return HOJSON_ERROR_SYNTAX;
+    }
+
+    /* Trim the whitespace around each element. Only an empty array may have an empty element. */
+    for (i = 0; i < parallel->element_count; i++) {
+        size_t* element = &(parallel->elements[i * 2]);
+        while (element[0] < element[1] && HOJSON_IS_WHITESPACE(json[element[0]]))
+            element[0]++;
+        while (element[1] > element[0] && HOJSON_IS_WHITESPACE(json[element[1] - 1]))
+            element[1]--;
+        if (element[0] == element[1]) {
+            if (parallel->element_count > 1)
+                return HOJSON_ERROR_SYNTAX;
+            parallel->element_count = 0;
+        }
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_add_element(hojson_parallel_t* parallel, size_t* element_capacity, size_t begin, size_t end) {
+    if (parallel->element_count == *element_capacity) {
+        size_t capacity = *element_capacity > 0 ? *element_capacity * 2 : 1024;
+        size_t* elements = (size_t*)realloc(parallel->elements, capacity * 2 * sizeof(size_t));
+        if (elements == NULL)
+            return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        parallel->elements = elements;
+        *element_capacity = capacity;
+    }
+    parallel->elements[parallel->element_count * 2] = begin;
+    parallel->elements[parallel->element_count * 2 + 1] = end;
+    parallel->element_count++;
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_parse_elements(hojson_worker_t* worker, size_t chunk) {
+    /* Each element is parsed as an array of one element, each a document of its own in the same context, so that */
+    /* names and values are found at the same depths they are in the whole document */
+    hojson_parallel_t* parallel = worker->parallel;
+    size_t element;
+    hojson_init(&(worker->context), worker->buffer, worker->buffer_length);
+    hojson_set_multi_document(&(worker->context), 1);
+    for (element = parallel->chunk_offsets[chunk]; element < parallel->chunk_offsets[chunk + 1]; element++) {
+        size_t begin = parallel->elements[element * 2], end = parallel->elements[element * 2 + 1];
+        hojson_code_t code = hojson_parse_part(worker, "[", 1, begin, 1);
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF)
+            code = hojson_parse_part(worker, parallel->json + begin, end - begin, begin, 1);
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF)
+            code = hojson_parse_part(worker, "]", 1, begin, 1);
+        if (code == HOJSON_ERROR_IO || code == HOJSON_ERROR_INSUFFICIENT_MEMORY)
+            return code;
+        if (code != HOJSON_END_OF_DOCUMENT) { /* If the element was invalid, begin again with the next */
+            hojson_init(&(worker->context), worker->buffer, worker->buffer_length);
+            hojson_set_multi_document(&(worker->context), 1);
+        }
+        if ((code = hojson_add_record(worker, chunk, begin, end - begin, code)) != HOJSON_NO_OP)
+            return code;
+    }
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_parse_part(hojson_worker_t* worker, const char* json, size_t json_length, size_t record_offset,
+        uint8_t is_element) {
+    /* Parse until the content runs out, the document ends, or an error. When parsing an element wrapped in an */
+    /* array, the array's beginning and ending are left out of the events. */
+    hojson_parallel_t* parallel = worker->parallel;
+    while (1) {
+        hojson_code_t code = hojson_parse(&(worker->context), json, json_length);
+        if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) { /* Recover by doubling the buffer */
+            char* buffer = (char*)malloc(worker->buffer_length * 2);
+            if (buffer == NULL)
+                return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+            hojson_realloc(&(worker->context), buffer, worker->buffer_length * 2);
+            free(worker->buffer);
+            worker->buffer = buffer;
+            worker->buffer_length *= 2;
+            continue;
+        } else if (code <= HOJSON_NO_OP)
+            return code;
+
+        if (is_element && ((code == HOJSON_ARRAY_BEGIN && worker->context.depth == 0) ||
+                (code == HOJSON_ARRAY_END && worker->context.depth == 1)))
+            continue;
+        if (parallel->options.on_event != NULL && parallel->options.on_event(parallel->options.user_data,
+                worker->index, record_offset, &(worker->context), code) != 0)
+            return HOJSON_ERROR_IO;
+        if (code == HOJSON_END_OF_DOCUMENT)
+            return code;
+    }
+}
+
+hojson_code_t hojson_parse_sequential(hojson_parallel_t* parallel) {
+    /* Parse the document in one piece, on the calling thread, as if it were a single record */
+    hojson_worker_t worker;
+    memset(&worker, 0, sizeof(hojson_worker_t));
+    worker.parallel = parallel;
+    worker.buffer_length = parallel->options.buffer_length;
+    worker.buffer = (char*)malloc(worker.buffer_length);
+    if (worker.buffer == NULL)
+        return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+
+    hojson_init(&(worker.context), worker.buffer, worker.buffer_length);
+    hojson_code_t code = parallel->json_length > 0 ? hojson_parse_part(&worker, parallel->json,
+        parallel->json_length, 0, 0) : HOJSON_ERROR_UNEXPECTED_EOF;
+    if (code != HOJSON_ERROR_IO && code != HOJSON_ERROR_INSUFFICIENT_MEMORY)
+        code = hojson_add_record(&worker, 0, 0, parallel->json_length, code);
+    free(worker.buffer);
+    return code;
+}
+
+uint8_t hojson_guess_string_state(const char* json, size_t offset, size_t json_length) {
+    /* Judge the first unescaped quote after the offset that can be judged. A quote following a '{', '[', ',', or */
+    /* ':' likely opens a string and one followed by a ':', ',', '}', or ']' likely closes one. Every quote in */
+    /* between flips the state. */
+    size_t end = json_length - offset > HOJSON_PARALLEL_GUESS_LENGTH ? offset + HOJSON_PARALLEL_GUESS_LENGTH :
+        json_length, i, j;
+    uint8_t is_flipped = 0;
+    for (i = offset; i < end; i++) {
+        if (json[i] != '"')
+            continue;
+        for (j = i; j > 0 && json[j - 1] == '\\'; j--);
+        if ((i - j) % 2 == 1) /* If the quote is escaped */
+            continue;
+
+        for (j = i; j > 0 && HOJSON_IS_WHITESPACE(json[j - 1]); j--);
+        if (j > 0 && (json[j - 1] == '{' || json[j - 1] == '[' || json[j - 1] == ',' || json[j - 1] == ':'))
+            return is_flipped; /* It opens a string so, before it, was outside of one */
+        for (j = i + 1; j < json_length && HOJSON_IS_WHITESPACE(json[j]); j++);
+        if (j < json_length && (json[j] == ':' || json[j] == ',' || json[j] == '}' || json[j] == ']'))
+            return !is_flipped; /* It closes a string so, before it, was in one */
+        is_flipped = !is_flipped;
+    }
+    return 0;
+}
+
+hojson_code_t hojson_add_record(hojson_worker_t* worker, size_t chunk, size_t offset, size_t length,
+        hojson_code_t code) {
+    hojson_parallel_t* parallel = worker->parallel;
+    hojson_record_t result;
+    result.offset = offset;
+    result.length = length;
+    result.code = code;
+    result.worker = worker->index;
+
+    if (parallel->chunks == NULL) { /* If records are unordered, deliver it now */
+        if (parallel->options.on_record != NULL && parallel->options.on_record(parallel->options.user_data,
+                &result) != 0)
+            return HOJSON_ERROR_IO;
+        return HOJSON_NO_OP;
+    } else if (parallel->options.on_record == NULL) /* If records are ordered but no one's listening */
+        return HOJSON_NO_OP;
+
+    /* Hold the record until all records before it are delivered */
+    hojson_chunk_t* held = &(parallel->chunks[chunk]);
+    if (held->record_count == held->record_capacity) {
+        size_t capacity = held->record_capacity > 0 ? held->record_capacity * 2 : 64;
+        hojson_record_t* records = (hojson_record_t*)realloc(held->records, capacity * sizeof(hojson_record_t));
+        if (records == NULL)
+            return HOJSON_ERROR_INSUFFICIENT_MEMORY;
+        held->records = records;
+        held->record_capacity = capacity;
+    }
+    held->records[held->record_count++] = result;
+    return HOJSON_NO_OP;
+}
+
+hojson_code_t hojson_finish_chunk(hojson_parallel_t* parallel, size_t chunk) {
+    /* Mark the chunk as done then deliver the records of it and any following chunks that are also done */
+    hojson_code_t code = HOJSON_NO_OP;
+    HOJSON_MUTEX_LOCK(&(parallel->delivery_mutex));
+    parallel->chunks[chunk].is_done = 1;
+    while (code == HOJSON_NO_OP && parallel->next_delivery < parallel->chunk_count &&
+            parallel->chunks[parallel->next_delivery].is_done) {
+        hojson_chunk_t* held = &(parallel->chunks[parallel->next_delivery]);
+        size_t i;
+        for (i = 0; i < held->record_count && code == HOJSON_NO_OP; i++) {
+            if (parallel->options.on_record(parallel->options.user_data, &(held->records[i])) != 0)
+                code = HOJSON_ERROR_IO;
+        }
+        free(held->records);
+        held->records = NULL;
+        held->record_count = held->record_capacity = 0;
+        parallel->next_delivery++;
+    }
+    HOJSON_MUTEX_UNLOCK(&(parallel->delivery_mutex));
+    return code;
+}
+
+void hojson_parallel_fail(hojson_parallel_t* parallel, hojson_code_t code) {
+    /* Remember the first failure. Workers check for it before taking another chunk. */
+    HOJSON_MUTEX_LOCK(&(parallel->status_mutex));
+    if (parallel->status == HOJSON_NO_OP)
+        parallel->status = code;
+    HOJSON_MUTEX_UNLOCK(&(parallel->status_mutex));
+}
+
+#endif /* HOJSON_PARALLEL_IMPLEMENTATION */
+
+#endif /* HOJSON_PARALLEL_H */
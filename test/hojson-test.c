@@ -1,16 +1,1448 @@
 #include <stdio.h> /* FILE, fclose() fopen(), fprintf(), fread(), fseek(), ftell(), printf(), SEEK_END, SEEK_SET, */
-                   /* stderr */
-#include <stdlib.h> /* atoi(), EXIT_FAILURE, EXIT_SUCCESS, free(), malloc(), NULL */
+                   /* sprintf(), stderr */
+#include <stdlib.h> /* atoi(), EXIT_FAILURE, EXIT_SUCCESS, free(), malloc(), NULL, strtod() */
 
 #define HOJSON_IMPLEMENTATION
-/* #define HOJSON_DEBUG */
-#include "hojson.h"
+#define HOJSON_PARALLEL_IMPLEMENTATION
+#define HOJSON_IO_IMPLEMENTATION
+#define HOJSON_IO_URING /* Only on Linux */
+#define HOJSON_INSTRUMENT
+#define HOJSON_TRACE
+#include "hojson_parallel.h"
+#include "hojson_io.h"
 
 #define NUM_DOCUMENTS 19
 #define NUM_INVALID_DOCUMENTS 6
+#define NUM_RECORDS 3000
+#define NUM_ELEMENTS 2000
+#define NUM_WORKERS 4
 #define CONTENT_BUFFER_LENGTH 75 /* Small, odd number to force reallocation and to trigger "unexpected EoF" errors */
                                  /* halfway through UTF-16 characters */
 
+static char* test_writer_output;
+
+/* Reads a whole document into memory that the caller frees, or returns NULL if it couldn't be read */
+char* read_document(const char* path, size_t* content_length) {
+    FILE* file;
+    if ((file = fopen(path, "rb")) == NULL) {
+        fprintf(stderr, "Couldn't open document: %s\n", path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END); /* Seek to the end of the file */
+    long length = ftell(file); /* Take the position in the file, the end, as the length */
+    fseek(file, 0, SEEK_SET); /* Seek back to the beginning of the file to read it */
+    char* content = length < 0 ? NULL : (char*)malloc((size_t)length + 1); /* Never zero bytes */
+    if (content == NULL || fread(content, 1, (size_t)length, file) != (size_t)length) {
+        fprintf(stderr, "Couldn't read document: %s\n", path);
+        free(content);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *content_length = (size_t)length;
+    return content;
+}
+
+int test_writer_flush(void* user_data, const char* data, size_t length) {
+    size_t* output_length = (size_t*)user_data;
+    memcpy(test_writer_output + *output_length, data, length);
+    *output_length += length;
+    return 0;
+}
+
+/* Validates every document, whole and in three-byte parts, and checks that only the valid ones are accepted */
+int test_validator(char** documents) {
+    int document_index;
+    for (document_index = 0; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        uint32_t max_depth;
+        hojson_code_t code = hojson_validate(content, content_length, &max_depth);
+
+        char stack[8]; /* 64 levels */
+        hojson_validator_t validator[1];
+        hojson_validator_init(validator, stack, sizeof(stack));
+        hojson_code_t chunked_code = HOJSON_ERROR_UNEXPECTED_EOF;
+        size_t offset;
+        for (offset = 0; offset < content_length && chunked_code == HOJSON_ERROR_UNEXPECTED_EOF; offset += 3)
+            chunked_code = hojson_validate_chunk(validator, content + offset,
+                content_length - offset < 3 ? content_length - offset : 3);
+
+        hojson_code_t expected_code = document_index == 0 ? HOJSON_ERROR_UNEXPECTED_EOF :
+            (document_index < NUM_INVALID_DOCUMENTS ? code : HOJSON_END_OF_DOCUMENT);
+        if (code != expected_code || chunked_code != code || (code > HOJSON_NO_OP && document_index <
+                NUM_INVALID_DOCUMENTS) || validator->max_depth != max_depth) {
+            fprintf(stderr, "\n\n Validating %s returned %d whole and %d in parts\n", documents[document_index],
+                code, chunked_code);
+            free(content);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Validated %s with code %d, depth %u, and offset %lu. Pass.\n", documents[document_index], code,
+            (unsigned)max_depth, (unsigned long)validator->offset);
+        free(content);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Validates UTF-8 that's invalid, truncated, or split between parts and checks it ends just as parsing it does, */
+/* whole and a byte at a time. Like a null terminator, a byte that can't be decoded ends only the part it's in. */
+int test_validator_utf8(void) {
+    const char* contents[] = {
+        "\xEF\xBB\xBF[\"\x80\"]", /* A continuation byte without a first byte */
+        "\xEF\xBB\xBF[\"\xE0\"]", /* A three-byte character that takes the closing quote and bracket with it */
+        "\xEF\xBB\xBF[\"\xE0", /* A three-byte character cut short by the end of the content */
+        "\xEF\xBB\xBF[\"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\"]", /* Two, three, and four-byte characters */
+        "\xEF\xBB\xBF[\xC3\xA9]" /* A character that isn't ASCII outside of a string */
+    };
+    const hojson_code_t expected_codes[] = { HOJSON_ERROR_UNEXPECTED_EOF, HOJSON_ERROR_UNEXPECTED_EOF,
+        HOJSON_ERROR_UNEXPECTED_EOF, HOJSON_END_OF_DOCUMENT, HOJSON_ERROR_SYNTAX };
+    size_t i, offset;
+    for (i = 0; i < sizeof(contents) / sizeof(contents[0]); i++) {
+        size_t content_length = strlen(contents[i]);
+        char buffer[256];
+        hojson_context_t context[1];
+        hojson_code_t parsed_code, chunked_parsed_code = HOJSON_ERROR_UNEXPECTED_EOF;
+        hojson_init(context, buffer, sizeof(buffer));
+        while ((parsed_code = hojson_parse(context, contents[i], content_length)) > HOJSON_END_OF_DOCUMENT) ;
+        hojson_init(context, buffer, sizeof(buffer));
+        for (offset = 0; offset < content_length && chunked_parsed_code == HOJSON_ERROR_UNEXPECTED_EOF; offset++)
+            while ((chunked_parsed_code = hojson_parse(context, contents[i] + offset, 1)) > HOJSON_END_OF_DOCUMENT) ;
+
+        hojson_code_t code = hojson_validate(contents[i], content_length, NULL);
+
+        char stack[8]; /* 64 levels */
+        hojson_validator_t validator[1];
+        hojson_validator_init(validator, stack, sizeof(stack));
+        hojson_code_t chunked_code = HOJSON_ERROR_UNEXPECTED_EOF;
+        for (offset = 0; offset < content_length && chunked_code == HOJSON_ERROR_UNEXPECTED_EOF; offset++)
+            chunked_code = hojson_validate_chunk(validator, contents[i] + offset, 1);
+
+        if (parsed_code != expected_codes[i] || code != parsed_code || chunked_code != chunked_parsed_code) {
+            fprintf(stderr, "\n\n UTF-8 content %lu parsed to %d and %d but validated to %d and %d, whole and a byte "
+                "at a time\n", (unsigned long)i, parsed_code, chunked_parsed_code, code, chunked_code);
+            return EXIT_FAILURE;
+        }
+    }
+    printf(" --- Validated %lu UTF-8 contents, whole and a byte at a time, as they parse. Pass.\n",
+        (unsigned long)(sizeof(contents) / sizeof(contents[0])));
+    return EXIT_SUCCESS;
+}
+
+/* Parses or validates content in two parts, split at the given offset, and returns the last code */
+hojson_code_t test_split(const char* content, size_t content_length, size_t split, uint8_t is_validating) {
+    char buffer[256], stack[8];
+    hojson_context_t context[1];
+    hojson_validator_t validator[1];
+    hojson_code_t code = HOJSON_ERROR_UNEXPECTED_EOF;
+    size_t offsets[3];
+    int part;
+    offsets[0] = 0;
+    offsets[1] = split;
+    offsets[2] = content_length;
+    hojson_init(context, buffer, sizeof(buffer));
+    hojson_validator_init(validator, stack, sizeof(stack));
+    for (part = 0; part < 2 && code == HOJSON_ERROR_UNEXPECTED_EOF; part++) {
+        if (offsets[part] == offsets[part + 1])
+            continue;
+        else if (is_validating)
+            code = hojson_validate_chunk(validator, content + offsets[part], offsets[part + 1] - offsets[part]);
+        else
+            while ((code = hojson_parse(context, content + offsets[part], offsets[part + 1] - offsets[part])) >
+                HOJSON_END_OF_DOCUMENT) ;
+    }
+    return code;
+}
+
+/* Splits escapes, numbers, and literals between two parts at every offset and checks that validating them ends */
+/* just as parsing them does, so the validator's states can't drift from the parser's without this failing */
+int test_validator_split(void) {
+    const char* contents[] = {
+        "[\"quote\\\" backslash\\\\ slash\\/ \\b\\f\\n\\r\\t\"]", /* Every single-character escape */
+        "[\"\\u00e9\\u20AC\\uD83D\\uDE00\"]", /* Unicode escapes, including a surrogate pair */
+        "{\"\\u0041\\\"name\":\"\\u12G4\"}", /* Escapes in a name, and a value with a non-hex digit */
+        "[\"\\x\"]", /* An escape that doesn't exist */
+        "[0, -0, 12345, -6.25e+10, 1E-3, 0.5, 9007199254740993]", /* Numbers of every form */
+        "[1e]", "[-]", "[1.]", "[.5]", "[+1]", "[1.5e+]", /* Numbers cut short or begun wrong */
+        "[true, false, null]", "[tru]", "[nul1]", "{\"a\" : 1 , \"b\" :[ ] }" /* Literals and whitespace */
+    };
+    size_t i, split;
+    for (i = 0; i < sizeof(contents) / sizeof(contents[0]); i++) {
+        size_t content_length = strlen(contents[i]);
+        for (split = 0; split <= content_length; split++) {
+            hojson_code_t parsed_code = test_split(contents[i], content_length, split, 0);
+            hojson_code_t code = test_split(contents[i], content_length, split, 1);
+            if (code != parsed_code) {
+                fprintf(stderr, "\n\n Content %s split at %lu parsed to %d but validated to %d\n", contents[i],
+                    (unsigned long)split, parsed_code, code);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    printf(" --- Validated %lu contents, split at every offset, as they parse. Pass.\n",
+        (unsigned long)(sizeof(contents) / sizeof(contents[0])));
+    return EXIT_SUCCESS;
+}
+
+/* Reformats content in parts of the given size and returns the length of the output or zero on failure */
+size_t test_reformat(const char* content, size_t content_length, size_t part_length, uint8_t indent, char* output) {
+    char write_buffer[16], stack[8];
+    size_t output_length = 0, offset;
+    hojson_writer_t writer[1];
+    hojson_validator_t validator[1];
+    hojson_writer_init(writer, write_buffer, sizeof(write_buffer), HOJSON_ENCODING_UTF_8, test_writer_flush,
+        &output_length);
+    hojson_reformatter_init(validator, stack, sizeof(stack), writer, indent);
+    test_writer_output = output;
+    hojson_code_t code = HOJSON_ERROR_UNEXPECTED_EOF;
+    for (offset = 0; offset < content_length && code == HOJSON_ERROR_UNEXPECTED_EOF; offset += part_length)
+        code = hojson_reformat_chunk(validator, content + offset,
+            content_length - offset < part_length ? content_length - offset : part_length);
+    if (code != HOJSON_END_OF_DOCUMENT || hojson_write_flush(writer) != HOJSON_NO_OP)
+        return 0;
+    return output_length;
+}
+
+/* Minifies and pretty-prints every valid document and checks that both are valid and minify to the same content */
+int test_reformatter(char** documents) {
+    int document_index;
+    for (document_index = NUM_INVALID_DOCUMENTS; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        /* Minifying never lengthens content. Pretty-printing adds, at most, a line break and indentation or a */
+        /* space for each character. */
+        uint32_t max_depth = 0;
+        hojson_validate(content, content_length, &max_depth);
+        char* minified = (char*)malloc(content_length * (4 + 4 * (size_t)max_depth));
+        if (minified == NULL) {
+            free(content);
+            return EXIT_FAILURE;
+        }
+        char* reminified = minified + content_length, *pretty = reminified + content_length;
+
+        size_t minified_length = test_reformat(content, content_length, 5, 0, minified);
+        size_t pretty_length = test_reformat(content, content_length, 3, 4, pretty);
+        size_t reminified_length = test_reformat(pretty, pretty_length, 2, 0, reminified);
+        if (minified_length == 0 || pretty_length == 0 || minified_length != reminified_length ||
+                memcmp(minified, reminified, minified_length) != 0 ||
+                hojson_validate(minified, minified_length, NULL) != HOJSON_END_OF_DOCUMENT) {
+            fprintf(stderr, "\n\n Reformatting %s failed\n", documents[document_index]);
+            free(minified);
+            free(content);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Reformatted %s from %lu bytes to %lu minified and %lu pretty. Pass.\n",
+            documents[document_index], (unsigned long)content_length, (unsigned long)minified_length,
+            (unsigned long)pretty_length);
+        free(minified);
+        free(content);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Parses every document from a read buffer and from a mapped file and checks that both return the same codes */
+int test_mmap(char** documents) {
+    int document_index;
+    for (document_index = 0; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        hojson_mmap_source_t source[1];
+        if (hojson_mmap_open(source, documents[document_index]) != HOJSON_NO_OP || source->length != content_length ||
+                memcmp(source->data, content, content_length) != 0) {
+            fprintf(stderr, "\n\n Mapping %s failed\n", documents[document_index]);
+            free(content);
+            return EXIT_FAILURE;
+        }
+
+        char buffer[4096], mapped_buffer[4096];
+        hojson_context_t context[1], mapped_context[1];
+        hojson_init(context, buffer, sizeof(buffer));
+        hojson_init(mapped_context, mapped_buffer, sizeof(mapped_buffer));
+        hojson_code_t code, mapped_code;
+        unsigned long code_count = 0;
+        do {
+            code = hojson_parse(context, content, content_length);
+            mapped_code = hojson_parse_file(mapped_context, source);
+            code_count++;
+            if (mapped_code != code || mapped_context->depth != context->depth ||
+                    mapped_context->value_type != context->value_type) {
+                fprintf(stderr, "\n\n Parsing mapped %s returned %d instead of %d\n", documents[document_index],
+                    mapped_code, code);
+                hojson_mmap_close(source);
+                free(content);
+                return EXIT_FAILURE;
+            }
+        } while (code > HOJSON_END_OF_DOCUMENT);
+        /* Called again once the file has run out, the file isn't parsed over from its beginning */
+        mapped_code = hojson_parse_file(mapped_context, source);
+        hojson_mmap_close(source);
+
+        if (mapped_code != code) {
+            fprintf(stderr, "\n\n Parsing mapped %s again returned %d after %d\n", documents[document_index],
+                mapped_code, code);
+            free(content);
+            return EXIT_FAILURE;
+        } else if ((document_index < NUM_INVALID_DOCUMENTS) == (code == HOJSON_END_OF_DOCUMENT)) {
+            fprintf(stderr, "\n\n Parsing mapped %s ended with %d\n", documents[document_index], code);
+            free(content);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Parsed mapped %s with %lu codes, the last %d. Pass.\n", documents[document_index], code_count,
+            code);
+        free(content);
+    }
+
+    hojson_mmap_source_t source[1];
+    if (hojson_mmap_open(source, "does_not_exist.json") != HOJSON_ERROR_IO) {
+        fprintf(stderr, "\n\n Mapping a missing file didn't fail\n");
+        return EXIT_FAILURE;
+    }
+    printf(" --- Mapping a missing file failed. Pass.\n");
+    return EXIT_SUCCESS;
+}
+
+/* Checks that a context returned the same code as another and that everything the code tells about it matches */
+int test_same_event(const hojson_context_t* expected, hojson_code_t expected_code, const hojson_context_t* actual,
+        hojson_code_t actual_code) {
+    if (actual_code != expected_code || actual->depth != expected->depth || actual->line != expected->line ||
+            actual->value_type != expected->value_type)
+        return 0;
+    else if (expected_code == HOJSON_NAME)
+        return strcmp(actual->name, expected->name) == 0;
+    else if (expected_code == HOJSON_VALUE)
+        return actual->integer_value == expected->integer_value && actual->float_value == expected->float_value &&
+            (expected->value_type != HOJSON_TYPE_STRING || strcmp(actual->string_value, expected->string_value) == 0);
+    return 1;
+}
+
+typedef struct {
+    const char* content;
+    size_t content_length;
+    size_t offset;
+    size_t read_count;
+} test_reader_t;
+
+/* Reads between one and seven bytes at a time, or fewer if asked, and fails once the content is gone */
+int test_reader_read(void* user_data, char* buffer, size_t buffer_length, size_t* bytes_read) {
+    test_reader_t* reader = (test_reader_t*)user_data;
+    size_t length = 1 + reader->read_count++ % 7;
+    if (reader->offset >= reader->content_length)
+        return -1;
+    if (length > buffer_length)
+        length = buffer_length;
+    if (length > reader->content_length - reader->offset)
+        length = reader->content_length - reader->offset;
+    memcpy(buffer, reader->content + reader->offset, length);
+    reader->offset += length;
+    *bytes_read = length;
+    return 0;
+}
+
+/* Parses every document whole and pulled through a reader, in tiny reads, and checks that both return the same codes */
+int test_reader(char** documents) {
+    int document_index;
+    for (document_index = 0; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        char buffer[4096], pulled_buffer[4096], read_buffer[8];
+        hojson_context_t context[1], pulled_context[1];
+        hojson_init(context, buffer, sizeof(buffer));
+        hojson_init(pulled_context, pulled_buffer, sizeof(pulled_buffer));
+        test_reader_t reader = { 0 };
+        reader.content = content;
+        reader.content_length = content_length;
+        hojson_set_reader(pulled_context, test_reader_read, &reader, read_buffer, sizeof(read_buffer));
+        hojson_code_t code, pulled_code;
+        do {
+            code = hojson_parse(context, content, content_length);
+            pulled_code = hojson_pull(pulled_context);
+            /* The reader fails, rather than reporting no more content, to be sure that it isn't asked for more */
+            if (code == HOJSON_ERROR_UNEXPECTED_EOF && pulled_code == HOJSON_ERROR_IO)
+                pulled_code = code;
+            if (!test_same_event(context, code, pulled_context, pulled_code)) {
+                fprintf(stderr, "\n\n Pulling %s returned %d instead of %d\n", documents[document_index],
+                    pulled_code, code);
+                free(content);
+                return EXIT_FAILURE;
+            }
+        } while (code > HOJSON_END_OF_DOCUMENT);
+        printf(" --- Pulled %s in %lu reads with the last code %d. Pass.\n", documents[document_index],
+            (unsigned long)reader.read_count, code);
+        free(content);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Parses every document whole and prefetched, in tiny chunks, and checks that both return the same codes */
+int test_prefetch(char** documents) {
+    int document_index;
+    for (document_index = 0; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        char buffer[4096], prefetched_buffer[4096];
+        hojson_context_t context[1], prefetched_context[1];
+        hojson_init(context, buffer, sizeof(buffer));
+        hojson_init(prefetched_context, prefetched_buffer, sizeof(prefetched_buffer));
+        test_reader_t reader = { 0 };
+        reader.content = content;
+        reader.content_length = content_length;
+        hojson_prefetch_t* prefetch = hojson_prefetch_start(test_reader_read, &reader, 5, 2);
+        if (prefetch == NULL) {
+            fprintf(stderr, "\n\n Couldn't start prefetching\n");
+            free(content);
+            return EXIT_FAILURE;
+        }
+        hojson_code_t code, prefetched_code;
+        do {
+            code = hojson_parse(context, content, content_length);
+            prefetched_code = hojson_parse_prefetched(prefetched_context, prefetch);
+            /* The reader fails, rather than reporting no more content, once the content is gone */
+            if (code == HOJSON_ERROR_UNEXPECTED_EOF && prefetched_code == HOJSON_ERROR_IO)
+                prefetched_code = code;
+            if (!test_same_event(context, code, prefetched_context, prefetched_code)) {
+                fprintf(stderr, "\n\n Prefetching %s returned %d instead of %d\n", documents[document_index],
+                    prefetched_code, code);
+                hojson_prefetch_stop(prefetch);
+                free(content);
+                return EXIT_FAILURE;
+            }
+        } while (code > HOJSON_END_OF_DOCUMENT);
+        hojson_prefetch_stop(prefetch); /* The reader may be stopped before it's done */
+        printf(" --- Prefetched %s with the last code %d. Pass.\n", documents[document_index], code);
+        free(content);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Parses every document whole and read asynchronously, in tiny chunks, and checks that both return the same codes */
+int test_async(char** documents) {
+    int document_index;
+    uint32_t queue_depth;
+    for (document_index = 0; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        for (queue_depth = 1; queue_depth <= 3; queue_depth += 2) { /* Synchronously and with three reads in flight */
+            char buffer[4096], async_buffer[4096];
+            hojson_context_t context[1], async_context[1];
+            hojson_init(context, buffer, sizeof(buffer));
+            hojson_init(async_context, async_buffer, sizeof(async_buffer));
+            hojson_async_file_t* async_file = hojson_async_open(documents[document_index], 5, queue_depth);
+            if (async_file == NULL) {
+                fprintf(stderr, "\n\n Couldn't open %s to read asynchronously\n", documents[document_index]);
+                free(content);
+                return EXIT_FAILURE;
+            }
+            hojson_code_t code, async_code;
+            do {
+                code = hojson_parse(context, content, content_length);
+                async_code = hojson_parse_async(async_context, async_file);
+                if (!test_same_event(context, code, async_context, async_code)) {
+                    fprintf(stderr, "\n\n Reading %s asynchronously returned %d instead of %d\n",
+                        documents[document_index], async_code, code);
+                    hojson_async_close(async_file);
+                    free(content);
+                    return EXIT_FAILURE;
+                }
+            } while (code > HOJSON_END_OF_DOCUMENT);
+            printf(" --- Read %s %s with the last code %d. Pass.\n", documents[document_index],
+                hojson_async_is_uring(async_file) ? "with io_uring" : "synchronously", code);
+            hojson_async_close(async_file); /* Reads may still be in flight */
+        }
+        free(content);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Feeds every document, and a UTF-16 document of numbers, through one reused receive buffer in feeds of every length */
+/* up to eight bytes and checks that the codes match those of parsing the document whole */
+int test_feed(char** documents) {
+    char numbers[128];
+    const char* ascii_numbers = "[1, -2.5, 3e2, 45, 0.125, [6], {\"n\": 78}]";
+    size_t numbers_length = 2, i;
+    numbers[0] = (char)0xFF; /* UTF-16LE byte order marker */
+    numbers[1] = (char)0xFE;
+    for (i = 0; ascii_numbers[i] != '\0'; i++) {
+        numbers[numbers_length++] = ascii_numbers[i];
+        numbers[numbers_length++] = '\0';
+    }
+
+    int document_index;
+    for (document_index = 0; document_index <= NUM_DOCUMENTS; document_index++) {
+        char* content;
+        size_t content_length;
+        if (document_index < NUM_DOCUMENTS) {
+            if ((content = read_document(documents[document_index], &content_length)) == NULL)
+                return EXIT_FAILURE;
+        } else {
+            if ((content = (char*)malloc(numbers_length)) == NULL)
+                return EXIT_FAILURE;
+            memcpy(content, numbers, numbers_length);
+            content_length = numbers_length;
+        }
+
+        size_t feed_length;
+        for (feed_length = 1; feed_length <= 8; feed_length++) {
+            char buffer[4096], fed_buffer[4096], receive_buffer[8];
+            hojson_context_t context[1], fed_context[1];
+            hojson_init(context, buffer, sizeof(buffer));
+            hojson_init(fed_context, fed_buffer, sizeof(fed_buffer));
+            size_t offset = 0;
+            hojson_code_t code, fed_code;
+            do {
+                code = hojson_parse(context, content, content_length);
+                while ((fed_code = hojson_next(fed_context)) == HOJSON_ERROR_UNEXPECTED_EOF &&
+                        offset < content_length) {
+                    /* The receive buffer is overwritten for every feed, which is fine once the last was consumed */
+                    size_t length = content_length - offset < feed_length ? content_length - offset : feed_length;
+                    memcpy(receive_buffer, content + offset, length);
+                    offset += length;
+                    if (hojson_feed(fed_context, receive_buffer, length) != HOJSON_NO_OP) {
+                        fprintf(stderr, "\n\n Feeding %s was refused\n", documents[document_index]);
+                        free(content);
+                        return EXIT_FAILURE;
+                    }
+                }
+                if (!test_same_event(context, code, fed_context, fed_code)) {
+                    fprintf(stderr, "\n\n Feeding %s in %lu-byte feeds returned %d instead of %d\n",
+                        document_index < NUM_DOCUMENTS ? documents[document_index] : "numbers",
+                        (unsigned long)feed_length, fed_code, code);
+                    free(content);
+                    return EXIT_FAILURE;
+                }
+            } while (code > HOJSON_END_OF_DOCUMENT);
+        }
+        printf(" --- Fed %s in feeds of 1 to 8 bytes. Pass.\n",
+            document_index < NUM_DOCUMENTS ? documents[document_index] : "UTF-16LE numbers");
+        free(content);
+    }
+
+    hojson_context_t context[1];
+    char buffer[64];
+    hojson_init(context, buffer, sizeof(buffer));
+    if (hojson_feed(context, "{\"a\"", 4) != HOJSON_NO_OP || hojson_feed(context, ": 1}", 4) !=
+            HOJSON_ERROR_INVALID_INPUT) {
+        fprintf(stderr, "\n\n A feed replaced one that hadn't been consumed\n");
+        return EXIT_FAILURE;
+    }
+    printf(" --- Feeding before the last feed was consumed was refused. Pass.\n");
+    return EXIT_SUCCESS;
+}
+
+int test_checkpoint(char** documents) {
+    int document_index;
+    for (document_index = 0; document_index < NUM_DOCUMENTS; document_index++) {
+        size_t content_length;
+        char* content = read_document(documents[document_index], &content_length);
+        if (content == NULL)
+            return EXIT_FAILURE;
+
+        size_t part_length;
+        for (part_length = 1; part_length <= 7; part_length += 3) {
+            char buffer[4096], restored_buffers[2][4096], blob[8192];
+            hojson_context_t context[1], restored_context[1];
+            hojson_init(context, buffer, sizeof(buffer));
+            hojson_init(restored_context, restored_buffers[0], sizeof(restored_buffers[0]));
+            size_t offset = 0, checkpoint_length, restore_count = 0;
+            hojson_code_t code, restored_code;
+            do {
+                code = hojson_parse(context, content, content_length);
+                do {
+                    /* Every part begins at the input offset of the last checkpoint. If there's nothing left, a */
+                    /* terminator collects the codes still pending. */
+                    size_t length = content_length - offset < part_length ? content_length - offset : part_length;
+                    restored_code = hojson_parse(restored_context, offset < content_length ? content + offset : "",
+                        offset < content_length ? length : 1);
+
+                    /* Every code is followed by a checkpoint, restored into the other buffer */
+                    restore_count++;
+                    if (hojson_checkpoint(restored_context, blob, sizeof(blob), &checkpoint_length, NULL) !=
+                            HOJSON_NO_OP || hojson_restore(restored_context, restored_buffers[restore_count % 2],
+                            sizeof(restored_buffers[0]), blob, checkpoint_length, &offset) != HOJSON_NO_OP) {
+                        fprintf(stderr, "\n\n Checkpointing %s failed\n", documents[document_index]);
+                        free(content);
+                        return EXIT_FAILURE;
+                    }
+                } while (restored_code == HOJSON_ERROR_UNEXPECTED_EOF && offset < content_length);
+                if (!test_same_event(context, code, restored_context, restored_code)) {
+                    fprintf(stderr, "\n\n Restoring %s in %lu-byte parts returned %d instead of %d\n",
+                        documents[document_index], (unsigned long)part_length, restored_code, code);
+                    free(content);
+                    return EXIT_FAILURE;
+                }
+            } while (code > HOJSON_END_OF_DOCUMENT);
+            if (part_length == 1)
+                printf(" --- Restored %s from %lu checkpoints. Pass.\n", documents[document_index],
+                    (unsigned long)restore_count);
+        }
+        free(content);
+    }
+
+    hojson_context_t context[1];
+    char buffer[256], blob[512];
+    size_t checkpoint_length, input_offset;
+    hojson_init(context, buffer, sizeof(buffer));
+    if (hojson_parse(context, "{\"name\": [\"value\"", 18) != HOJSON_OBJECT_BEGIN ||
+            hojson_parse(context, "{\"name\": [\"value\"", 18) != HOJSON_NAME || hojson_checkpoint(context, NULL, 0,
+            &checkpoint_length, &input_offset) != HOJSON_ERROR_INSUFFICIENT_MEMORY || checkpoint_length >
+            sizeof(blob) || input_offset != 7 || hojson_checkpoint(context, blob, checkpoint_length,
+            &checkpoint_length, NULL) != HOJSON_NO_OP) {
+        fprintf(stderr, "\n\n Checkpointing a name failed\n");
+        return EXIT_FAILURE;
+    }
+    if (hojson_restore(context, buffer, 8, blob, checkpoint_length, NULL) != HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+        fprintf(stderr, "\n\n A checkpoint was restored to a buffer too short for it\n");
+        return EXIT_FAILURE;
+    }
+    blob[0] ^= 1;
+    if (hojson_restore(context, buffer, sizeof(buffer), blob, checkpoint_length, NULL) !=
+            HOJSON_ERROR_INVALID_INPUT) {
+        fprintf(stderr, "\n\n A corrupted checkpoint was restored\n");
+        return EXIT_FAILURE;
+    }
+    printf(" --- Restoring to a short buffer or from a corrupted checkpoint failed. Pass.\n");
+
+    /* The name survives the restore and parsing resumes at the colon that follows it */
+    char restored_buffer[64];
+    blob[0] ^= 1;
+    if (hojson_restore(context, restored_buffer, sizeof(restored_buffer), blob, checkpoint_length, &input_offset) !=
+            HOJSON_NO_OP || strcmp(context->name, "name") != 0 || hojson_parse(context, "{\"name\": [\"value\"]}" +
+            input_offset, 12) != HOJSON_ARRAY_BEGIN || strcmp(context->name, "name") != 0 ||
+            hojson_parse(context, "{\"name\": [\"value\"]}" + input_offset, 12) != HOJSON_VALUE ||
+            strcmp(context->string_value, "value") != 0) {
+        fprintf(stderr, "\n\n Parsing didn't resume from a restored name\n");
+        return EXIT_FAILURE;
+    }
+    printf(" --- Parsing resumed from a restored name. Pass.\n");
+    return EXIT_SUCCESS;
+}
+
+int test_index(char** documents) {
+    int document_index;
+    for (document_index = NUM_INVALID_DOCUMENTS; document_index < NUM_DOCUMENTS; document_index++) {
+        hojson_mmap_source_t source[1];
+        if (hojson_mmap_open(source, documents[document_index]) != HOJSON_NO_OP) {
+            fprintf(stderr, "\n\n Mapping %s failed\n", documents[document_index]);
+            return EXIT_FAILURE;
+        }
+
+        size_t interval;
+        for (interval = 0; interval <= 128; interval += 128) {
+            /* Every element gets a checkpoint, or just a few of them do and the index makes a trip to a side file */
+            hojson_index_t* index;
+            if (hojson_index_build(&index, source, 1, interval) != HOJSON_NO_OP || (interval > 0 &&
+                    (hojson_index_save(index, "hojson-test.index") != HOJSON_NO_OP || (hojson_index_free(index),
+                    hojson_index_load(&index, "hojson-test.index")) != HOJSON_NO_OP))) {
+                fprintf(stderr, "\n\n Indexing %s failed\n", documents[document_index]);
+                hojson_mmap_close(source);
+                return EXIT_FAILURE;
+            }
+
+            size_t element, element_count = hojson_index_element_count(index);
+            for (element = 0; element < element_count; element++) {
+                /* Parse from the beginning up to the element's first code */
+                char buffer[4096], seek_buffer[4096];
+                hojson_context_t context[1], seek_context[1];
+                hojson_init(context, buffer, sizeof(buffer));
+                size_t count = 0, offset;
+                hojson_code_t code;
+                do {
+                    code = hojson_parse(context, source->data, source->length);
+                } while (code > HOJSON_END_OF_DOCUMENT && ((code != HOJSON_VALUE && code != HOJSON_OBJECT_BEGIN &&
+                    code != HOJSON_ARRAY_BEGIN) || context->depth != 1 || count++ < element));
+
+                /* Seeking there must give the same code and the rest of the document must follow */
+                hojson_code_t seek_code = hojson_index_seek(index, source, element, seek_context, seek_buffer,
+                    sizeof(seek_buffer), &offset);
+                while (1) {
+                    if (!test_same_event(context, code, seek_context, seek_code)) {
+                        fprintf(stderr, "\n\n Seeking element %lu of %s returned %d instead of %d\n",
+                            (unsigned long)element, documents[document_index], seek_code, code);
+                        hojson_index_free(index);
+                        hojson_mmap_close(source);
+                        return EXIT_FAILURE;
+                    } else if (code <= HOJSON_END_OF_DOCUMENT)
+                        break;
+                    code = hojson_parse(context, source->data, source->length);
+                    seek_code = hojson_parse(seek_context, source->data + offset, source->length - offset);
+                }
+            }
+
+            char buffer[64];
+            hojson_context_t context[1];
+            size_t offset;
+            if (hojson_index_seek(index, source, element_count, context, buffer, sizeof(buffer), &offset) !=
+                    HOJSON_ERROR_INVALID_INPUT) {
+                fprintf(stderr, "\n\n Seeking past the last element of %s didn't fail\n", documents[document_index]);
+                hojson_index_free(index);
+                hojson_mmap_close(source);
+                return EXIT_FAILURE;
+            }
+            hojson_index_free(index);
+            if (interval == 0)
+                printf(" --- Sought each of the %lu elements of %s. Pass.\n", (unsigned long)element_count,
+                    documents[document_index]);
+        }
+        hojson_mmap_close(source);
+    }
+
+    /* The last side file written is changed to claim the first version of the format, which had another layout */
+    hojson_index_t* index;
+    uint32_t version = 1;
+    FILE* file = fopen("hojson-test.index", "r+b");
+    int is_changed = file != NULL && fseek(file, sizeof(uint32_t), SEEK_SET) == 0 &&
+        fwrite(&version, sizeof(version), 1, file) == 1;
+    if (file != NULL && fclose(file) != 0)
+        is_changed = 0;
+    if (!is_changed || hojson_index_load(&index, "hojson-test.index") != HOJSON_ERROR_INVALID_INPUT || index != NULL) {
+        fprintf(stderr, "\n\n Loading an index of another version didn't fail\n");
+        remove("hojson-test.index");
+        return EXIT_FAILURE;
+    }
+    remove("hojson-test.index");
+    if (hojson_index_load(&index, "does_not_exist.index") != HOJSON_ERROR_IO || index != NULL) {
+        fprintf(stderr, "\n\n Loading a missing index didn't fail\n");
+        return EXIT_FAILURE;
+    }
+    printf(" --- Loading a missing index or one of another version failed. Pass.\n");
+    return EXIT_SUCCESS;
+}
+
+int test_instrument(void) {
+    const char* json = "{\"ab\": [true, 12, \"c\\n\"]}";
+    char buffer[256];
+    hojson_context_t context[1];
+    hojson_stats_t stats;
+    hojson_init(context, buffer, sizeof(buffer));
+    if (hojson_set_stats(context, &stats) != HOJSON_NO_OP) {
+        fprintf(stderr, "\n\n Counting wasn't compiled in\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Parse in two parts, split within the name, so parsing resumes once */
+    hojson_code_t code;
+    size_t offset = 0, part_length = 3, codes = 0;
+    while ((code = hojson_parse(context, json + offset, part_length)) != HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF) {
+            offset += part_length;
+            part_length = strlen(json) - offset;
+        } else if (code < HOJSON_NO_OP)
+            break;
+        else
+            codes++;
+    }
+
+    uint64_t characters = 0;
+    uint32_t state;
+    for (state = 0; state < HOJSON_STATE_COUNT; state++)
+        characters += stats.characters[state];
+    /* Every character is processed once, and the comma that ends the number is processed again. The name, */
+    /* the number, and the string are appended with their terminators. */
+    if (code != HOJSON_END_OF_DOCUMENT || characters != strlen(json) + stats.stays || stats.stays != 1 ||
+            stats.resumes != 1 || stats.parses != codes + 2 || stats.characters[HOJSON_STATE_NAME] != 3 ||
+            stats.transitions[HOJSON_STATE_NAME_EXPECTED][HOJSON_STATE_NAME] != 1 ||
+            stats.transitions[HOJSON_STATE_VALUE_EXPECTED][HOJSON_STATE_TRUE_VALUE_T] != 1 ||
+            stats.appends != 9 || stats.bytes_appended != 9 || strcmp(hojson_state_name(HOJSON_STATE_DONE),
+            "DONE") != 0 || strcmp(hojson_state_name(HOJSON_STATE_COUNT), "UNKNOWN") != 0) {
+        fprintf(stderr, "\n\n Counted %lu characters, %lu stays, %lu resumes, %lu parses, and %lu appends\n",
+            (unsigned long)characters, (unsigned long)stats.stays, (unsigned long)stats.resumes,
+            (unsigned long)stats.parses, (unsigned long)stats.appends);
+        return EXIT_FAILURE;
+    }
+    printf(" --- Counted %lu characters, %lu in %s, across %lu parses. Pass.\n", (unsigned long)characters,
+        (unsigned long)stats.characters[HOJSON_STATE_NAME_EXPECTED], hojson_state_name(HOJSON_STATE_NAME_EXPECTED),
+        (unsigned long)stats.parses);
+    return EXIT_SUCCESS;
+}
+
+/* Parses inputs like those that fuzzing found mistakes with: UTF-16 characters from U+0080 up arriving a byte at a */
+/* time, a Unicode escape that runs out of memory on its last digit, and values that end at the end of the buffer */
+int test_fuzz_regressions(void) {
+    /* ["é"] in UTF-16LE, with a BOM, one byte at a time */
+    const char utf16[] = { (char)0xFF, (char)0xFE, '[', 0, '"', 0, (char)0xE9, 0, '"', 0, ']', 0 };
+    char buffer[256];
+    hojson_context_t context[1];
+    hojson_code_t code;
+    size_t i, length;
+    hojson_init(context, buffer, sizeof(buffer));
+    for (i = 0; i < sizeof(utf16); i++) {
+        while ((code = hojson_parse(context, utf16 + i, 1)) != HOJSON_ERROR_UNEXPECTED_EOF) {
+            if (code == HOJSON_VALUE && (context->string_value[0] != (char)0xE9 || context->string_value[1] != 0)) {
+                fprintf(stderr, "\n\n U+00E9 was decoded as 0x%02X%02X\n", (unsigned)(uint8_t)context->string_value[1],
+                    (unsigned)(uint8_t)context->string_value[0]);
+                return EXIT_FAILURE;
+            } else if (code < HOJSON_NO_OP || code == HOJSON_END_OF_DOCUMENT)
+                break;
+        }
+        if (code != HOJSON_ERROR_UNEXPECTED_EOF)
+            break;
+    }
+    if (code != HOJSON_END_OF_DOCUMENT) {
+        fprintf(stderr, "\n\n Parsing UTF-16LE a byte at a time returned %d\n", code);
+        return EXIT_FAILURE;
+    }
+
+    /* Every buffer length, doubled when it's too short, runs out of memory somewhere else */
+    const char* json = "{\"n\": 12345, \"s\": \"\\u0054x\"}";
+    for (length = sizeof(hojson_node_t) + 1; length <= 64; length++) {
+        char* memory = (char*)malloc(length);
+        size_t memory_length = length;
+        int integer_value = 0;
+        char string_value[8] = { 0 };
+        hojson_init(context, memory, memory_length);
+        while ((code = hojson_parse(context, json, strlen(json))) != HOJSON_END_OF_DOCUMENT) {
+            if (code == HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+                char* new_memory = (char*)malloc(memory_length * 2);
+                hojson_realloc(context, new_memory, memory_length * 2);
+                free(memory);
+                memory = new_memory;
+                memory_length *= 2;
+            } else if (code < HOJSON_NO_OP)
+                break;
+            else if (code == HOJSON_VALUE && context->value_type == HOJSON_TYPE_INTEGER)
+                integer_value = context->integer_value;
+            else if (code == HOJSON_VALUE && context->value_type == HOJSON_TYPE_STRING) {
+                /* The value's terminator is within the buffer, so it can be read as a C string */
+                if (context->string_value + strlen(context->string_value) < memory + memory_length)
+                    strncpy(string_value, context->string_value, sizeof(string_value) - 1);
+            }
+        }
+        free(memory);
+        if (code != HOJSON_END_OF_DOCUMENT || integer_value != 12345 || strcmp(string_value, "Tx") != 0) {
+            fprintf(stderr, "\n\n With a %lu byte buffer, parsed %d and \"%s\"\n", (unsigned long)length,
+                integer_value, string_value);
+            return EXIT_FAILURE;
+        }
+    }
+    printf(" --- Parsed UTF-16LE a byte at a time and escapes with buffers of %lu to 64 bytes. Pass.\n",
+        (unsigned long)(sizeof(hojson_node_t) + 1));
+    return EXIT_SUCCESS;
+}
+
+int test_number_text(void) {
+    const char* content = "[12345678901234567890, -0.1e-5, 7]";
+    const char* texts[] = { "12345678901234567890", "-0.1e-5", "7" };
+    char buffer[256];
+    hojson_context_t context[1];
+    hojson_code_t code;
+    int values = 0;
+
+    /* A number's text is kept, as it appeared, along with its value */
+    hojson_init(context, buffer, sizeof(buffer));
+    while ((code = hojson_parse(context, content, strlen(content))) > HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_VALUE && (values >= 3 || context->string_value == NULL ||
+                strcmp(context->string_value, texts[values++]) != 0)) {
+            fprintf(stderr, "\n\n Number %d's text was \"%s\"\n", values, context->string_value == NULL ? "" :
+                context->string_value);
+            return EXIT_FAILURE;
+        }
+    }
+    if (code != HOJSON_END_OF_DOCUMENT || values != 3) {
+        fprintf(stderr, "\n\n Parsing numbers returned %d after %d values\n", code, values);
+        return EXIT_FAILURE;
+    }
+    printf(" Numbers were kept as text\n");
+    return EXIT_SUCCESS;
+}
+
+int test_empty_names(void) {
+    const char* content = "{\"\": [1], \"a\": null, \"\": null, \"b\": 2}";
+    const char* names[] = { "", "a", "", "b" };
+    char buffer[256];
+    hojson_context_t context[1];
+    hojson_code_t code;
+    int name_count = 0;
+
+    /* An empty name is cleaned up, once its value ends, like any other so the next name doesn't follow it */
+    hojson_init(context, buffer, sizeof(buffer));
+    while ((code = hojson_parse(context, content, strlen(content))) > HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_NAME && (name_count >= 4 || strcmp(context->name, names[name_count++]) != 0)) {
+            fprintf(stderr, "\n\n Name %d was \"%s\"\n", name_count, context->name);
+            return EXIT_FAILURE;
+        }
+    }
+    if (code != HOJSON_END_OF_DOCUMENT || name_count != 4) {
+        fprintf(stderr, "\n\n Parsing empty names returned %d after %d names\n", code, name_count);
+        return EXIT_FAILURE;
+    }
+    printf(" Names following empty names were intact\n");
+    return EXIT_SUCCESS;
+}
+
+int test_differential_regressions(void) {
+    /* {"ab": 12, "c": "\u00e9"} in UTF-16LE, with a BOM */
+    const char utf16[] = { (char)0xFF, (char)0xFE, '{', 0, '"', 0, 'a', 0, 'b', 0, '"', 0, ':', 0, '1', 0, '2', 0,
+        ',', 0, '"', 0, 'c', 0, '"', 0, ':', 0, '"', 0, '\\', 0, 'u', 0, '0', 0, '0', 0, 'e', 0, '9', 0, '"', 0,
+        '}', 0 };
+    const char* utf8 = "[\"\\u00e9\\u07ff\"]";
+    char buffer[256];
+    hojson_context_t context[1];
+    hojson_code_t code;
+    int values = 0;
+
+    /* Both bytes of a UTF-16 terminator end a name, and numbers are parsed whatever the encoding */
+    hojson_init(context, buffer, sizeof(buffer));
+    while ((code = hojson_parse(context, utf16, sizeof(utf16))) > HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_VALUE && context->value_type == HOJSON_TYPE_INTEGER) {
+            if (context->name[4] != 0 || context->name[5] != 0 || context->integer_value != 12) {
+                fprintf(stderr, "\n\n Member \"ab\" of UTF-16LE parsed as %ld\n", context->integer_value);
+                return EXIT_FAILURE;
+            }
+            values++;
+        } else if (code == HOJSON_VALUE && context->value_type == HOJSON_TYPE_STRING) {
+            if (context->string_value[0] != (char)0xE9 || context->string_value[1] != 0) {
+                fprintf(stderr, "\n\n An escaped U+00E9 in UTF-16LE was decoded as 0x%02X%02X\n",
+                    (unsigned)(uint8_t)context->string_value[1], (unsigned)(uint8_t)context->string_value[0]);
+                return EXIT_FAILURE;
+            }
+            values++;
+        }
+    }
+    if (code != HOJSON_END_OF_DOCUMENT || values != 2) {
+        fprintf(stderr, "\n\n Parsing UTF-16LE returned %d after %d values\n", code, values);
+        return EXIT_FAILURE;
+    }
+
+    /* Two-byte escapes are encoded to UTF-8 with their continuation byte's marker intact */
+    hojson_init(context, buffer, sizeof(buffer));
+    while ((code = hojson_parse(context, utf8, strlen(utf8))) > HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_VALUE && strcmp(context->string_value, "\xC3\xA9\xDF\xBF") != 0) {
+            fprintf(stderr, "\n\n Escaped U+00E9 and U+07FF were encoded as %02X %02X %02X %02X\n",
+                (unsigned)(uint8_t)context->string_value[0], (unsigned)(uint8_t)context->string_value[1],
+                (unsigned)(uint8_t)context->string_value[2], (unsigned)(uint8_t)context->string_value[3]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (code != HOJSON_END_OF_DOCUMENT) {
+        fprintf(stderr, "\n\n Parsing two-byte escapes returned %d\n", code);
+        return EXIT_FAILURE;
+    }
+    printf(" --- Parsed UTF-16LE names and numbers and two-byte escapes as the reference parser does. Pass.\n");
+    return EXIT_SUCCESS;
+}
+
+/* Events recorded by trace_event() */
+typedef struct {
+    hojson_trace_event_t events[64];
+    uint32_t states[64];
+    uint32_t values[64];
+    size_t offsets[64];
+    size_t count;
+} trace_t;
+
+void trace_event(void* user_data, hojson_trace_event_t event, uint32_t state, uint32_t value, size_t offset,
+        uint32_t line, uint32_t column) {
+    trace_t* trace = (trace_t*)user_data;
+    (void)line;
+    (void)column;
+    if (trace->count < 64) {
+        trace->events[trace->count] = event;
+        trace->states[trace->count] = state;
+        trace->values[trace->count] = value;
+        trace->offsets[trace->count] = offset;
+    }
+    trace->count++;
+}
+
+/* Traces a document parsed in two parts, split within a name, and checks the events and their offsets */
+int test_trace(void) {
+    const char* json = "{\"ab\": 12}";
+    char buffer[256];
+    hojson_context_t context[1];
+    trace_t trace;
+    memset(&trace, 0, sizeof(trace));
+    hojson_init(context, buffer, sizeof(buffer));
+    if (hojson_set_trace(context, trace_event, &trace) != HOJSON_NO_OP) {
+        fprintf(stderr, "\n\n Tracing wasn't compiled in\n");
+        return EXIT_FAILURE;
+    }
+
+    hojson_code_t code;
+    size_t offset = 0, part_length = 3;
+    while ((code = hojson_parse(context, json + offset, part_length)) != HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_ERROR_UNEXPECTED_EOF) {
+            offset += part_length;
+            part_length = strlen(json) - offset;
+        } else if (code < HOJSON_NO_OP)
+            break;
+    }
+
+    /* Each character is traced where it begins. The first part runs out within the name, and parsing resumes there */
+    /* with the second. The '}' ends the number so it's processed a second time. */
+    size_t i, characters = 0, stays = 0;
+    for (i = 0; i < trace.count && i < 64; i++) {
+        if (trace.events[i] == HOJSON_TRACE_CHARACTER) {
+            if (trace.values[i] != (uint32_t)json[trace.offsets[i]]) {
+                fprintf(stderr, "\n\n Traced '%c' at offset %lu\n", (char)trace.values[i],
+                    (unsigned long)trace.offsets[i]);
+                return EXIT_FAILURE;
+            }
+            characters++;
+        } else if (trace.events[i] == HOJSON_TRACE_STAY)
+            stays++;
+    }
+    if (code != HOJSON_END_OF_DOCUMENT || trace.count >= 64 || characters != strlen(json) + 1 || stays != 1 ||
+            trace.events[3] != HOJSON_TRACE_SUSPEND || trace.offsets[3] != 3 || trace.states[3] != HOJSON_STATE_NAME ||
+            trace.events[4] != HOJSON_TRACE_RESUME || trace.offsets[4] != 3 || trace.states[4] != HOJSON_STATE_NAME) {
+        fprintf(stderr, "\n\n Traced %lu events, %lu characters, and %lu stays\n", (unsigned long)trace.count,
+            (unsigned long)characters, (unsigned long)stays);
+        return EXIT_FAILURE;
+    }
+
+    /* With the callback taken away, nothing more is traced */
+    size_t count = trace.count;
+    hojson_set_trace(context, NULL, NULL);
+    hojson_init(context, buffer, sizeof(buffer));
+    while ((code = hojson_parse(context, json, strlen(json))) > HOJSON_NO_OP && code != HOJSON_END_OF_DOCUMENT) ;
+    if (trace.count != count) {
+        fprintf(stderr, "\n\n Traced after the callback was taken away\n");
+        return EXIT_FAILURE;
+    }
+    printf(" --- Traced %lu events, %lu of them characters. Pass.\n", (unsigned long)count, (unsigned long)characters);
+    return EXIT_SUCCESS;
+}
+
+/* Parses a stream of newline-delimited and concatenated documents in small parts and checks each boundary */
+int test_multi_document(void) {
+    const char* stream = "{\"id\": 1, \"tags\": [\"a\", \"b\"]}\n"
+        "{\"id\": 2, \"nested\": {\"deep\": [[1.5], {}]}}\r\n"
+        "\n"
+        "[1, 2, 3]{\"id\": 4}\n"
+        "  {\"id\": 5, \"text\": \"line\\nbreak\"}\n";
+    const size_t expected_offsets[] = { 29, 72, 84, 93, 128 };
+    size_t stream_length = strlen(stream), part_length;
+    for (part_length = 1; part_length <= 16; part_length += 5) {
+        char buffer[256];
+        hojson_context_t hojson_context[1];
+        hojson_init(hojson_context, buffer, sizeof(buffer));
+        hojson_set_multi_document(hojson_context, 1);
+        size_t offset = 0, document_count = 0, value_count = 0;
+        hojson_code_t code;
+        while (offset < stream_length) {
+            size_t length = stream_length - offset < part_length ? stream_length - offset : part_length;
+            while ((code = hojson_parse(hojson_context, stream + offset, length)) > HOJSON_NO_OP) {
+                if (code == HOJSON_VALUE)
+                    value_count++;
+                else if (code == HOJSON_END_OF_DOCUMENT && (document_count >= 5 ||
+                        hojson_context->document_offset != expected_offsets[document_count++])) {
+                    fprintf(stderr, "\n\n Document %lu ended at offset %lu\n", (unsigned long)document_count,
+                        (unsigned long)hojson_context->document_offset);
+                    return EXIT_FAILURE;
+                }
+            }
+            if (code != HOJSON_ERROR_UNEXPECTED_EOF) {
+                fprintf(stderr, "\n\n Parsing multiple documents returned %d\n", code);
+                return EXIT_FAILURE;
+            }
+            offset += length;
+        }
+        if (document_count != 5 || value_count != 11 || hojson_context->depth != 0) {
+            fprintf(stderr, "\n\n Parsed %lu documents and %lu values\n", (unsigned long)document_count,
+                (unsigned long)value_count);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Parsed %lu documents in %lu-byte parts. Pass.\n", (unsigned long)document_count,
+            (unsigned long)part_length);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Counts kept per worker while parsing records in parallel, which needs no synchronization */
+typedef struct {
+    size_t records[NUM_WORKERS], errors[NUM_WORKERS], values[NUM_WORKERS], depths[NUM_WORKERS];
+    size_t last_offset;
+    int is_ordered, is_out_of_order;
+} test_parallel_t;
+
+int test_parallel_event(void* user_data, uint32_t worker, size_t record_offset, hojson_context_t* context,
+        hojson_code_t code) {
+    (void)record_offset;
+    if (code == HOJSON_VALUE) {
+        ((test_parallel_t*)user_data)->values[worker]++;
+        ((test_parallel_t*)user_data)->depths[worker] += context->depth;
+    }
+    return 0;
+}
+
+int test_parallel_record(void* user_data, const hojson_record_t* record) {
+    test_parallel_t* test = (test_parallel_t*)user_data;
+    test->records[record->worker]++;
+    if (record->code != HOJSON_END_OF_DOCUMENT)
+        test->errors[record->worker]++;
+    if (test->is_ordered) { /* Only when ordered are these calls made one at a time */
+        if (record->offset < test->last_offset)
+            test->is_out_of_order = 1;
+        test->last_offset = record->offset;
+    }
+    return 0;
+}
+
+/* Parses generated JSON Lines, some of them invalid, on several threads with records in order and out of order */
+int test_parallel(void) {
+    char* content = (char*)malloc(NUM_RECORDS * 64);
+    size_t content_length = 0, expected_errors = 0;
+    int i;
+    for (i = 0; i < NUM_RECORDS; i++) {
+        if (i % 97 == 0) { /* Every so often, a record is invalid */
+            content_length += sprintf(content + content_length, "{\"id\": %d,, \"values\": [1]}\n", i);
+            expected_errors++;
+        } else
+            content_length += sprintf(content + content_length, "{\"id\": %d, \"values\": [%d, \"s\"]}\n", i,
+                -i);
+        if (i % 50 == 0) /* Every so often, a blank line */
+            content_length += sprintf(content + content_length, " \r\n");
+    }
+
+    int is_ordered;
+    for (is_ordered = 0; is_ordered <= 1; is_ordered++) {
+        test_parallel_t test;
+        memset(&test, 0, sizeof(test_parallel_t));
+        test.is_ordered = is_ordered;
+        hojson_parallel_options_t options;
+        memset(&options, 0, sizeof(hojson_parallel_options_t));
+        options.workers = NUM_WORKERS;
+        options.chunk_length = 512;
+        options.buffer_length = 16; /* Small enough that every worker must grow its buffer */
+        options.is_ordered = (uint8_t)is_ordered;
+        options.on_event = test_parallel_event;
+        options.on_record = test_parallel_record;
+        options.user_data = &test;
+        hojson_code_t code = hojson_parse_parallel(content, content_length, &options);
+
+        size_t records = 0, errors = 0, values = 0;
+        for (i = 0; i < NUM_WORKERS; i++) {
+            records += test.records[i];
+            errors += test.errors[i];
+            values += test.values[i];
+        }
+        /* Valid records have three values, invalid ones return an error before their second */
+        if (code != HOJSON_END_OF_DOCUMENT || records != NUM_RECORDS || errors != expected_errors ||
+                values != (NUM_RECORDS - expected_errors) * 3 + expected_errors || test.is_out_of_order) {
+            fprintf(stderr, "\n\n Parsing records in parallel returned %d with %lu records, %lu errors, and %lu "
+                "values\n", code, (unsigned long)records, (unsigned long)errors, (unsigned long)values);
+            free(content);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Parsed %lu records, %lu invalid, on %d threads %s. Pass.\n", (unsigned long)records,
+            (unsigned long)errors, NUM_WORKERS, is_ordered ? "in order" : "out of order");
+    }
+    free(content);
+    return EXIT_SUCCESS;
+}
+
+/* Parses a large array, one element at a time, in parallel and checks it against parsing it in one piece */
+int test_parallel_array(void) {
+    char* content = (char*)malloc(NUM_ELEMENTS * 128);
+    size_t content_length = sprintf(content, "[\n");
+    int i;
+    for (i = 0; i < NUM_ELEMENTS; i++) { /* Strings full of quotes, commas, and brackets make for wrong guesses */
+        const char* separator = i + 1 < NUM_ELEMENTS ? ",\n" : "\n]\n";
+        if (i % 4 == 0)
+            content_length += sprintf(content + content_length, "  {\"id\": %d, \"text\": \"a \\\"quote\\\", [b] {c} "
+                "\\\\\", \"list\": [%d, [%d], {\"x\": \"]\"}]}%s", i, i, -i, separator);
+        else if (i % 4 == 1)
+            content_length += sprintf(content + content_length, "\"\\\", %d\\\", ], \"%s", i, separator);
+        else if (i % 4 == 2)
+            content_length += sprintf(content + content_length, "%d%s", i, separator);
+        else
+            content_length += sprintf(content + content_length, "[true, null, \"\\\\\", {\"k\": \"v\"}]%s",
+                separator);
+    }
+
+    /* Count the values, and add up their depths, parsing the whole document in one piece */
+    size_t expected_values = 0, expected_depths = 0;
+    char buffer[256];
+    hojson_context_t hojson_context[1];
+    hojson_code_t code;
+    hojson_init(hojson_context, buffer, sizeof(buffer));
+    while ((code = hojson_parse(hojson_context, content, content_length)) > HOJSON_END_OF_DOCUMENT) {
+        if (code == HOJSON_VALUE) {
+            expected_values++;
+            expected_depths += hojson_context->depth;
+        }
+    }
+
+    int is_ordered;
+    for (is_ordered = 0; is_ordered <= 1; is_ordered++) {
+        test_parallel_t test;
+        memset(&test, 0, sizeof(test_parallel_t));
+        test.is_ordered = is_ordered;
+        hojson_parallel_options_t options;
+        memset(&options, 0, sizeof(hojson_parallel_options_t));
+        options.workers = NUM_WORKERS;
+        options.chunk_length = content_length / 61; /* Segments begin anywhere, including in strings */
+        options.buffer_length = 16;
+        options.is_ordered = (uint8_t)is_ordered;
+        options.on_event = test_parallel_event;
+        options.on_record = test_parallel_record;
+        options.user_data = &test;
+        code = hojson_parse_parallel_array(content, content_length, &options);
+
+        size_t records = 0, errors = 0, values = 0, depths = 0;
+        for (i = 0; i < NUM_WORKERS; i++) {
+            records += test.records[i];
+            errors += test.errors[i];
+            values += test.values[i];
+            depths += test.depths[i];
+        }
+        if (code != HOJSON_END_OF_DOCUMENT || records != NUM_ELEMENTS || errors != 0 || values != expected_values ||
+                depths != expected_depths || test.is_out_of_order) {
+            fprintf(stderr, "\n\n Parsing an array in parallel returned %d with %lu records, %lu errors, and %lu "
+                "values\n", code, (unsigned long)records, (unsigned long)errors, (unsigned long)values);
+            free(content);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Parsed %lu elements and %lu values on %d threads %s. Pass.\n", (unsigned long)records,
+            (unsigned long)values, NUM_WORKERS, is_ordered ? "in order" : "out of order");
+    }
+    free(content);
+
+    /* Documents that can't be split are parsed in one piece as a single record */
+    const char* unsplittable[] = { "{\"array\": [1, 2, 3]}", "[1, , 2]", "[[1, 2], 3" };
+    const hojson_code_t expected_codes[] = { HOJSON_END_OF_DOCUMENT, HOJSON_ERROR_SYNTAX, HOJSON_ERROR_UNEXPECTED_EOF };
+    for (i = 0; i < 3; i++) {
+        test_parallel_t test;
+        memset(&test, 0, sizeof(test_parallel_t));
+        hojson_parallel_options_t options;
+        memset(&options, 0, sizeof(hojson_parallel_options_t));
+        options.workers = 2;
+        options.chunk_length = 4;
+        options.on_record = test_parallel_record;
+        options.user_data = &test;
+        code = hojson_parse_parallel_array(unsplittable[i], strlen(unsplittable[i]), &options);
+        if (code != HOJSON_END_OF_DOCUMENT || test.records[0] != 1 || (test.errors[0] == 1) !=
+                (expected_codes[i] != HOJSON_END_OF_DOCUMENT)) {
+            fprintf(stderr, "\n\n Parsing %s in parallel returned %d\n", unsplittable[i], code);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Parsed %s in one piece. Pass.\n", unsplittable[i]);
+    }
+    return EXIT_SUCCESS;
+}
+
+int test_splitter_element(void* user_data, size_t begin, size_t end) {
+    size_t* ranges = (size_t*)user_data;
+    ranges[ranges[0] * 2 + 1] = begin;
+    ranges[ranges[0] * 2 + 2] = end;
+    ranges[0]++;
+    return 0;
+}
+
+/* Splits arrays, in parts of every length, and checks the elements found */
+int test_splitter(void) {
+    const char* json = "\xEF\xBB\xBF [ {\"a\": [1, \"]\"], \"b\": {}} ,\"x,\\\"y\\\\\" ,3, [ ] ,null\n]";
+    const char* expected[] = { "{\"a\": [1, \"]\"], \"b\": {}}", "\"x,\\\"y\\\\\"", "3", "[ ]", "null" };
+    const char* invalid[] = { "{\"a\": 1}", "[1,,2]", "[1, 2,]", "[,]", "[1}" };
+    size_t json_length = strlen(json), part_length, i;
+    for (part_length = 1; part_length <= json_length; part_length++) {
+        size_t ranges[1 + 2 * 8] = { 0 }, offset;
+        hojson_splitter_t splitter[1];
+        hojson_splitter_init(splitter);
+        hojson_code_t code = HOJSON_ERROR_UNEXPECTED_EOF;
+        for (offset = 0; offset < json_length && code == HOJSON_ERROR_UNEXPECTED_EOF; offset += part_length)
+            code = hojson_split_array(splitter, json + offset, json_length - offset < part_length ?
+                json_length - offset : part_length, test_splitter_element, ranges);
+        if (code != HOJSON_END_OF_DOCUMENT || ranges[0] != 5 || splitter->element_count != 5 ||
+                splitter->offset != json_length) {
+            fprintf(stderr, "\n\n Splitting in %lu-byte parts returned %d with %lu elements\n",
+                (unsigned long)part_length, code, (unsigned long)ranges[0]);
+            return EXIT_FAILURE;
+        }
+        for (i = 0; i < 5; i++) {
+            if (ranges[i * 2 + 2] - ranges[i * 2 + 1] != strlen(expected[i]) ||
+                    memcmp(json + ranges[i * 2 + 1], expected[i], strlen(expected[i])) != 0) {
+                fprintf(stderr, "\n\n Element %lu was split incorrectly\n", (unsigned long)i);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    printf(" --- Split an array into 5 elements in parts of every length. Pass.\n");
+
+    size_t ranges[1 + 2 * 8] = { 0 };
+    hojson_splitter_t empty_splitter[1];
+    hojson_splitter_init(empty_splitter);
+    if (hojson_split_array(empty_splitter, "[ ]", 3, test_splitter_element, ranges) != HOJSON_END_OF_DOCUMENT ||
+            ranges[0] != 0) {
+        fprintf(stderr, "\n\n Splitting an empty array failed\n");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < 5; i++) {
+        size_t ranges[1 + 2 * 8] = { 0 };
+        hojson_splitter_t splitter[1];
+        hojson_splitter_init(splitter);
+        hojson_code_t code = hojson_split_array(splitter, invalid[i], strlen(invalid[i]), test_splitter_element,
+            ranges);
+        if (code != HOJSON_ERROR_SYNTAX) {
+            fprintf(stderr, "\n\n Splitting %s returned %d\n", invalid[i], code);
+            return EXIT_FAILURE;
+        }
+        printf(" --- Splitting %s returned error code %d at offset %lu as expected. Pass.\n", invalid[i], code,
+            (unsigned long)splitter->offset);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Formats doubles whose shortest representations are known and checks that others read back exactly */
+int test_format_double(void) {
+    const double values[] = { 0.1, 0.3, 1.0, -2.5, 100.0, 1e21, 1e20, 1e-7, 1.5e-6, 123.456, 5e-324,
+        1.7976931348623157e308, 2.2250738585072014e-308, 9007199254740993.0, 0.0 };
+    const char* expected[] = { "0.1", "0.3", "1", "-2.5", "100", "1e+21", "100000000000000000000", "1e-7",
+        "0.0000015", "123.456", "5e-324", "1.7976931348623157e+308", "2.2250738585072014e-308",
+        "9007199254740992", "0" };
+    char str[HOJSON_FORMAT_DOUBLE_LENGTH];
+    size_t i;
+
+    for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        size_t length = hojson_format_double(values[i], str);
+        if (strcmp(str, expected[i]) != 0 || length != strlen(expected[i])) {
+            fprintf(stderr, "\n\n Formatted %.17g as \"%s\" but expected \"%s\"\n", values[i], str, expected[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Walk through a wide range of magnitudes with values that have no short representation */
+    double value = 1.0 / 3.0;
+    for (i = 0; i < 2000; i++) {
+        value *= i % 2 ? -1.37 : 1.41;
+        hojson_format_double(value, str);
+        if (strtod(str, NULL) != value) {
+            fprintf(stderr, "\n\n Formatted %.17g as \"%s\" which does not read back\n", value, str);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf(" --- Formatted doubles as their shortest representations. Pass.\n");
+    return EXIT_SUCCESS;
+}
+
+/* Writes malformed UTF-8 names and values in each encoding and checks that the writer fails and stays failed */
+int test_writer_malformed(void) {
+    const char* strings[] = {
+        "ok\x80zz", /* A continuation byte without a first byte */
+        "\xC0\xA2", /* An overlong encoding of a double quote */
+        "\xED\xA0\x80", /* A surrogate */
+        "cut short \xE2\x82", /* A three-byte character missing its last byte */
+        "\xE2\x28\xA1", /* A three-byte character whose second byte doesn't begin with 10 */
+        "\xE0\x80\xAF", /* An overlong encoding of a slash */
+        "a long run of well-formed text, \xC3\xA9 included, before \xF4\x90\x80\x80" /* Past U+10FFFF */
+    };
+    const hojson_encoding_t encodings[] = { HOJSON_ENCODING_UTF_8, HOJSON_ENCODING_UTF_16_LE,
+        HOJSON_ENCODING_UTF_16_BE };
+    size_t i, j;
+    for (i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        for (j = 0; j < sizeof(encodings) / sizeof(encodings[0]) * 2; j++) {
+            char output[512], write_buffer[16];
+            size_t output_length = 0;
+            hojson_writer_t writer[1];
+            hojson_writer_init(writer, write_buffer, sizeof(write_buffer), encodings[j / 2], test_writer_flush,
+                &output_length);
+            test_writer_output = output;
+            /* Every other time, the string is written as a name rather than a value */
+            int failed = hojson_write_object_begin(writer, NULL) != HOJSON_NO_OP ||
+                (j % 2 == 0 ? hojson_write_string(writer, "value", strings[i]) :
+                    hojson_write_integer(writer, strings[i], 1)) != HOJSON_ERROR_INVALID_INPUT ||
+                hojson_write_null(writer, "next") != HOJSON_ERROR_INVALID_INPUT ||
+                hojson_write_object_end(writer) != HOJSON_ERROR_INVALID_INPUT;
+            if (failed) {
+                fprintf(stderr, "\n\n Writer didn't fail on malformed UTF-8 %lu with encoding %d\n", (unsigned long)i,
+                    encodings[j / 2]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    printf(" --- Failed to write %lu malformed UTF-8 names and values in each encoding. Pass.\n",
+        (unsigned long)(sizeof(strings) / sizeof(strings[0])));
+    return EXIT_SUCCESS;
+}
+
+/* Writes a document with every kind of value in the given encoding, parses it back, and compares the values */
+int test_writer(hojson_encoding_t encoding) {
+    char output[512], write_buffer[16], parse_buffer[512];
+    size_t output_length = 0;
+    hojson_writer_t writer[1];
+    hojson_writer_init(writer, write_buffer, sizeof(write_buffer), encoding, test_writer_flush, &output_length);
+    /* The tiny write buffer is flushed to 'output' which is tracked with the 'output_length' static */
+    test_writer_output = output;
+
+    int failed = hojson_write_object_begin(writer, NULL) != HOJSON_NO_OP ||
+        hojson_write_string(writer, "string", "quote\" backslash\\ tab\t \xC3\xA9 \x01") != HOJSON_NO_OP ||
+        hojson_write_string(writer, "emoji", "\xF0\x9F\x98\x80") != HOJSON_NO_OP || /* U+1F600 */
+        hojson_write_integer(writer, "integer", -1234567) != HOJSON_NO_OP ||
+        hojson_write_float(writer, "float", 0.1) != HOJSON_NO_OP ||
+        hojson_write_array_begin(writer, "array") != HOJSON_NO_OP ||
+        hojson_write_boolean(writer, NULL, 1) != HOJSON_NO_OP ||
+        hojson_write_null(writer, NULL) != HOJSON_NO_OP ||
+        hojson_write_float(writer, NULL, 3.0) != HOJSON_NO_OP ||
+        hojson_write_array_end(writer) != HOJSON_NO_OP ||
+        hojson_write_integer(writer, NULL, 1) != HOJSON_ERROR_INVALID_INPUT || /* Missing name */
+        hojson_write_array_end(writer) != HOJSON_ERROR_TOKEN_MISMATCH ||
+        hojson_write_object_end(writer) != HOJSON_END_OF_DOCUMENT ||
+        hojson_write_flush(writer) != HOJSON_NO_OP;
+    if (failed) {
+        fprintf(stderr, "\n\n Writer returned an unexpected code for encoding %d\n", encoding);
+        return EXIT_FAILURE;
+    }
+
+    hojson_context_t hojson_context[1];
+    hojson_init(hojson_context, parse_buffer, sizeof(parse_buffer));
+    int values = 0;
+    hojson_code_t code;
+    while ((code = hojson_parse(hojson_context, output, output_length)) != HOJSON_END_OF_DOCUMENT) {
+        if (code < HOJSON_NO_OP) {
+            fprintf(stderr, "\n\n Written content for encoding %d failed to parse with code %d\n", encoding, code);
+            return EXIT_FAILURE;
+        } else if (code != HOJSON_VALUE)
+            continue;
+
+        /* The first string is only compared for UTF-8 because the parser provides strings in the document's */
+        /* encoding. The second is one character, a surrogate pair in UTF-16. The rest are compared in all encodings. */
+        int is_utf8 = encoding == HOJSON_ENCODING_UTF_8;
+        const char* emoji = encoding == HOJSON_ENCODING_UTF_16_BE ? "\xD8\x3D\xDE\x00" :
+            (encoding == HOJSON_ENCODING_UTF_16_LE ? "\x3D\xD8\x00\xDE" : "\xF0\x9F\x98\x80");
+        switch (values++) {
+        case 0:
+            failed = hojson_context->value_type != HOJSON_TYPE_STRING || (is_utf8 &&
+                strcmp(hojson_context->string_value, "quote\" backslash\\ tab\t \xC3\xA9 \x01") != 0);
+            break;
+        case 1:
+            failed = hojson_context->value_type != HOJSON_TYPE_STRING || memcmp(hojson_context->string_value, emoji, 4);
+            break;
+        case 2:
+            failed = hojson_context->value_type != HOJSON_TYPE_INTEGER || hojson_context->integer_value != -1234567;
+            break;
+        case 3: failed = hojson_context->value_type != HOJSON_TYPE_FLOAT || hojson_context->float_value != 0.1; break;
+        case 4: failed = hojson_context->value_type != HOJSON_TYPE_BOOLEAN || hojson_context->bool_value != 1; break;
+        case 5: failed = hojson_context->value_type != HOJSON_TYPE_NULL; break;
+        case 6: failed = hojson_context->value_type != HOJSON_TYPE_FLOAT || hojson_context->float_value != 3.0; break;
+        default: failed = 1; break;
+        }
+        if (failed) {
+            fprintf(stderr, "\n\n Value %d written with encoding %d did not match when parsed\n", values, encoding);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf(" --- Wrote and parsed back %d values with encoding %d. Pass.\n", values, encoding);
+    return values == 7 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char** argv) {
     char* documents[NUM_DOCUMENTS];
     /* These documents are expected to return errors */
@@ -139,9 +1571,11 @@ int main(int argc, char** argv) {
                         case HOJSON_TYPE_INTEGER:
                             printf("        value: %ld", hojson_context->integer_value);
                             break;
-                        case HOJSON_TYPE_FLOAT:
-                            printf("        value: %g",hojson_context->float_value);
-                            break;
+                        case HOJSON_TYPE_FLOAT: {
+                            char float_string[HOJSON_FORMAT_DOUBLE_LENGTH];
+                            hojson_format_double(hojson_context->float_value, float_string);
+                            printf("        value: %s", float_string);
+                        } break;
                         case HOJSON_TYPE_STRING:
                             printf("        value: \"%s\"", hojson_context->string_value);
                             break;
@@ -198,6 +1632,95 @@ int main(int argc, char** argv) {
         free(hojson_buffer);
     }
 
+    printf("\n\n\n --------- Validating JSON documents\n");
+    if (test_validator(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Validating invalid and split UTF-8\n");
+    if (test_validator_utf8() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Validating escapes, numbers, and literals split between parts\n");
+    if (test_validator_split() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Parsing mapped JSON documents\n");
+    if (test_mmap(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Pulling JSON documents from a reader\n");
+    if (test_reader(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Prefetching JSON documents on another thread\n");
+    if (test_prefetch(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Reading JSON documents asynchronously\n");
+    if (test_async(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Feeding JSON documents\n");
+    if (test_feed(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Restoring JSON documents from checkpoints\n");
+    if (test_checkpoint(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Seeking elements with an index\n");
+    if (test_index(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Counting the hot paths of parsing\n");
+    if (test_instrument() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Parsing inputs found by fuzzing\n");
+    if (test_fuzz_regressions() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Parsing inputs found by differential testing\n");
+    if (test_differential_regressions() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Keeping numbers as text\n");
+    if (test_number_text() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Parsing empty names\n");
+    if (test_empty_names() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Tracing parsing with a callback\n");
+    if (test_trace() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Parsing multiple JSON documents\n");
+    if (test_multi_document() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Splitting JSON arrays\n");
+    if (test_splitter() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Parsing JSON Lines in parallel\n");
+    if (test_parallel() != EXIT_SUCCESS || test_parallel_array() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Reformatting JSON documents\n");
+    if (test_reformatter(documents) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    printf("\n\n\n --------- Writing JSON documents\n");
+    if (test_format_double() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    if (test_writer(HOJSON_ENCODING_UTF_8) != EXIT_SUCCESS || test_writer(HOJSON_ENCODING_UTF_16_LE) != EXIT_SUCCESS ||
+            test_writer(HOJSON_ENCODING_UTF_16_BE) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    if (test_writer_malformed() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
     printf("\n\n\n PASS\n");
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include <cstdio> /* std::fprintf(), std::printf(), stderr */
+#include <cstdlib> /* EXIT_FAILURE, EXIT_SUCCESS */
+#include <memory_resource> /* std::pmr::monotonic_buffer_resource */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+
+#define HOJSON_IMPLEMENTATION
+#include "hojson.hpp"
+
+using namespace std::literals::string_view_literals;
+
+static const std::string_view test_document = "{ \"name\": \"value\", \"\": [ 1, -2.5, true, null, \"\\u00e9\" ], "
+    "\"big\": 1234567890123456789.25, \"nested\": { \"empty\": {} } }"sv;
+
+/* The events of the test document, described as below */
+static const std::string_view test_document_events = "4 0\n2 1 \"name\"\n3 1 \"name\" = \"value\"\n2 1 \"\"\n6 1 \"\"\n"
+    "3 2 = 1\n3 2 = -2.500000\n3 2 = true\n3 2 = null\n3 2 = \"\xC3\xA9\"\n7 2 \"\"\n2 1 \"big\"\n"
+    "3 1 \"big\" = 1234567890123456768.000000\n2 1 \"nested\"\n4 1 \"nested\"\n2 2 \"empty\"\n4 2 \"empty\"\n"
+    "5 3 \"empty\"\n5 2 \"nested\"\n5 1\n"sv;
+
+/* An event as one line of text, so a document's events can be compared with a single string */
+void test_describe_event(const hojson::event& event, std::string& description) {
+    description += std::to_string(event.code) + " " + std::to_string(event.depth);
+    if (event.has_name())
+        description += " \"" + std::string(event.name) + "\"";
+    if (event.code == HOJSON_VALUE) {
+        switch (event.type) {
+        case HOJSON_TYPE_STRING: description += " = \"" + std::string(event.string) + "\""; break;
+        case HOJSON_TYPE_INTEGER: description += " = " + std::to_string(event.integer); break;
+        case HOJSON_TYPE_FLOAT: description += " = " + std::to_string(event.floating); break;
+        case HOJSON_TYPE_BOOLEAN: description += event.boolean ? " = true" : " = false"; break;
+        case HOJSON_TYPE_NULL: description += " = null"; break;
+        default: break;
+        }
+        if (event.type != HOJSON_TYPE_STRING && !event.string.empty())
+            description += " (" + std::string(event.string) + ")";
+    }
+    description += "\n";
+}
+
+template <class Parser>
+void test_describe(Parser& parser, std::string& description) {
+    for (auto& event : parser)
+        test_describe_event(event, description);
+}
+
+/* Feeds the content in parts of the given length, describing the events, and returns the code parsing ended with */
+template <class Parser>
+hojson_code_t test_parse(Parser& parser, std::string_view content, std::size_t part_length, std::string& description) {
+    for (std::size_t offset = 0; offset < content.size(); offset += part_length) {
+        if (parser.feed(content.substr(offset, part_length)) != HOJSON_NO_OP)
+            return HOJSON_ERROR_INVALID_INPUT;
+        test_describe(parser, description);
+        if (parser.code() != HOJSON_ERROR_UNEXPECTED_EOF)
+            break;
+    }
+    return parser.code();
+}
+
+int test_events() {
+    /* Events must be the same however the document is fed */
+    std::size_t part_lengths[] = { test_document.size(), 64, 7, 1 };
+    for (std::size_t part_length : part_lengths) {
+        hojson::parser parser;
+        std::string description;
+        hojson_code_t code = test_parse(parser, test_document, part_length, description);
+        if (code != HOJSON_END_OF_DOCUMENT || description != test_document_events) {
+            std::fprintf(stderr, "\n\n Parsing in %lu-byte parts returned %d with these events:\n%s\n",
+                (unsigned long)part_length, code, description.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    std::printf(" Events were the same in parts of every length\n");
+    return EXIT_SUCCESS;
+}
+
+int test_raw_numbers() {
+    hojson::basic_parser<hojson::encoding::utf8, hojson::raw_numbers> parser;
+    std::string description;
+    test_parse(parser, test_document, test_document.size(), description);
+    if (description.find("\"big\" = 1234567890123456768.000000 (1234567890123456789.25)\n") == std::string::npos ||
+            description.find("= -2.500000 (-2.5)\n") == std::string::npos) {
+        std::fprintf(stderr, "\n\n Numbers weren't provided as text:\n%s\n", description.c_str());
+        return EXIT_FAILURE;
+    }
+    std::printf(" Numbers were provided as they appeared\n");
+    return EXIT_SUCCESS;
+}
+
+int test_utf16() {
+    /* { "\u00e9": "ab" } in UTF-16BE and then UTF-16LE, with their byte order markers */
+    const std::string_view documents[] = {
+        "\xFE\xFF\0{\0\"\0\xE9\0\"\0:\0\"\0a\0b\0\"\0}"sv, "\xFF\xFE{\0\"\0\xE9\0\"\0:\0\"\0a\0b\0\"\0}\0"sv };
+    const std::string_view names[] = { "\0\xE9"sv, "\xE9\0"sv };
+    const std::string_view values[] = { "\0a\0b"sv, "a\0b\0"sv };
+    for (int i = 0; i < 2; i++) {
+        hojson::parser parser;
+        parser.feed(documents[i]);
+        bool has_value = false;
+        for (auto& event : parser)
+            has_value = has_value || (event.code == HOJSON_VALUE && event.name == names[i] &&
+                event.string == values[i]);
+        if (parser.code() != HOJSON_END_OF_DOCUMENT || !has_value) {
+            std::fprintf(stderr, "\n\n The UTF-16%s name or value was measured wrong\n", i == 0 ? "BE" : "LE");
+            return EXIT_FAILURE;
+        }
+
+        /* A parser built for UTF-8 mustn't provide them at all */
+        hojson::basic_parser<hojson::encoding::utf8> utf8_parser;
+        utf8_parser.feed(documents[i]);
+        std::string description;
+        test_describe(utf8_parser, description);
+        if (utf8_parser.code() != HOJSON_ERROR_INVALID_INPUT || !description.empty()) {
+            std::fprintf(stderr, "\n\n A UTF-8 parser returned %d for UTF-16%s with these events:\n%s\n",
+                utf8_parser.code(), i == 0 ? "BE" : "LE", description.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    std::printf(" UTF-16 names and values were measured by their code units\n");
+    std::printf(" UTF-16 documents failed with parsers built for UTF-8\n");
+    return EXIT_SUCCESS;
+}
+
+int test_grow_buffer() {
+    /* The buffer is allocated from memory on the stack until there's none left */
+    char memory[4096];
+    std::pmr::monotonic_buffer_resource resource(memory, sizeof(memory));
+    std::string description;
+
+    /* Without growing, a short buffer fails */
+    hojson::parser short_parser(8, 0, &resource);
+    if (test_parse(short_parser, test_document, test_document.size(), description) !=
+            HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+        std::fprintf(stderr, "\n\n A short buffer didn't run out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    hojson::basic_parser<hojson::default_encoding, hojson::grow_buffer> parser(8, 256, &resource);
+    description.clear();
+    if (test_parse(parser, test_document, 5, description) != HOJSON_END_OF_DOCUMENT || parser.buffer_length() != 128) {
+        std::fprintf(stderr, "\n\n Growing the buffer ended with %d and %lu bytes\n", parser.code(),
+            (unsigned long)parser.buffer_length());
+        return EXIT_FAILURE;
+    }
+
+    hojson::basic_parser<hojson::default_encoding, hojson::grow_buffer> limited_parser(8, 16, &resource);
+    if (test_parse(limited_parser, test_document, 5, description) != HOJSON_ERROR_INSUFFICIENT_MEMORY) {
+        std::fprintf(stderr, "\n\n The buffer grew past its limit\n");
+        return EXIT_FAILURE;
+    }
+    std::printf(" The buffer grew from 8 to %lu bytes\n", (unsigned long)parser.buffer_length());
+    return EXIT_SUCCESS;
+}
+
+int test_multi_document() {
+    hojson::basic_parser<hojson::default_encoding, hojson::multi_document> parser;
+    std::string description;
+    hojson_code_t code = test_parse(parser, "{\"a\":1}\n[2]\n{}"sv, 3, description);
+    if (code != HOJSON_ERROR_UNEXPECTED_EOF || description != "4 0\n2 1 \"a\"\n3 1 \"a\" = 1\n5 1\n1 0\n"
+            "6 0\n3 1 = 2\n7 1\n1 0\n4 0\n5 1\n1 0\n") {
+        std::fprintf(stderr, "\n\n Parsing multiple documents returned %d with these events:\n%s\n", code,
+            description.c_str());
+        return EXIT_FAILURE;
+    }
+    std::printf(" Three documents were parsed\n");
+    return EXIT_SUCCESS;
+}
+
+#ifdef HOJSON_COROUTINES
+/* Stands in for a socket read by an event loop: a read suspends the reader until the loop delivers the next part */
+struct test_socket {
+    std::string_view content;
+    std::size_t part_length;
+    std::size_t offset;
+    std::string_view part;
+    std::coroutine_handle<> reader;
+
+    struct read_awaiter {
+        test_socket* socket;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const noexcept { socket->reader = handle; }
+        std::string_view await_resume() const noexcept { return socket->part; }
+    };
+
+    read_awaiter read() noexcept { return read_awaiter{ this }; }
+
+    /* Resumes the reader with the next part, which is empty at the end of the content */
+    bool deliver() {
+        if (!reader)
+            return false;
+        part = content.substr(offset < content.size() ? offset : content.size(), part_length);
+        offset += part.size();
+        std::exchange(reader, nullptr).resume();
+        return true;
+    }
+};
+
+/* A coroutine that starts right away and is destroyed by whoever holds it */
+struct test_task {
+    struct promise_type {
+        test_task get_return_object() noexcept {
+            return test_task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {}
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    ~test_task() { handle.destroy(); }
+};
+
+test_task test_consume(hojson::async_events events, std::string& description) {
+    while (const hojson::event* event = co_await events.next())
+        test_describe_event(*event, description);
+}
+
+int test_coroutines() {
+    /* Events must be the same however the document arrives and, once it's over, no more is read */
+    std::size_t part_lengths[] = { test_document.size(), 7, 1 };
+    for (std::size_t part_length : part_lengths) {
+        hojson::parser parser;
+        test_socket socket{ test_document.substr(0, test_document.size() - 1), part_length, 0, {}, nullptr };
+        std::string description;
+        {
+            test_task task = test_consume(hojson::parse_async(parser, [&] { return socket.read(); }), description);
+            while (socket.deliver()) ;
+            if (!task.handle.done() || parser.code() != HOJSON_ERROR_UNEXPECTED_EOF) {
+                std::fprintf(stderr, "\n\n Parsing a truncated document in %lu-byte parts ended with %d\n",
+                    (unsigned long)part_length, parser.code());
+                return EXIT_FAILURE;
+            }
+        }
+
+        /* The last byte, fed to the same parser, ends the document */
+        socket = test_socket{ test_document.substr(test_document.size() - 1), part_length, 0, {}, nullptr };
+        test_task task = test_consume(hojson::parse_async(parser, [&] { return socket.read(); }), description);
+        std::size_t deliveries = 0;
+        while (socket.deliver())
+            deliveries++;
+        if (!task.handle.done() || parser.code() != HOJSON_END_OF_DOCUMENT || deliveries != 1 ||
+                description != test_document_events) {
+            std::fprintf(stderr, "\n\n Parsing in %lu-byte parts returned %d with these events:\n%s\n",
+                (unsigned long)part_length, parser.code(), description.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    std::printf(" Events were awaited as parts arrived\n");
+    return EXIT_SUCCESS;
+}
+#endif /* HOJSON_COROUTINES */
+
+int main() {
+    std::printf("\n\n\n --------- Iterating over events\n");
+    if (test_events() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    std::printf("\n\n\n --------- Providing numbers as text\n");
+    if (test_raw_numbers() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    std::printf("\n\n\n --------- Measuring UTF-16 names and values\n");
+    if (test_utf16() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    std::printf("\n\n\n --------- Growing the buffer\n");
+    if (test_grow_buffer() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    std::printf("\n\n\n --------- Parsing multiple documents\n");
+    if (test_multi_document() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+#ifdef HOJSON_COROUTINES
+    std::printf("\n\n\n --------- Parsing in a coroutine\n");
+    if (test_coroutines() != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+#endif /* HOJSON_COROUTINES */
+
+    std::printf("\n\n\n PASS\n");
+    return EXIT_SUCCESS;
+}